@@ -0,0 +1,66 @@
+#ifndef BUTTON_INPUT_H
+#define BUTTON_INPUT_H
+
+#include <Arduino.h>
+
+/**
+ * @brief 全局按键事件引擎.
+ *
+ * GPIO 中断记录带时间戳的电平跳变并放入队列, ButtonInput_Process() 在
+ * LVGL 所在的 loop() 中取出跳变, 按时间戳消抖, 识别出单击/长按/双击等
+ * 事件后交给当前页面注册的回调. 回调运行在 LVGL 线程, 可以直接操作控件.
+ *
+ * 页面切换时调用 ButtonInput_SetHandler(): 如果此时按键仍处于按下状态,
+ * 这次按压属于上一个页面, 新页面在按键松开之前不会收到任何事件.
+ */
+
+#define BUTTON_DEBOUNCE_MS          20    // 两次有效跳变的最小间隔
+#define BUTTON_CLICK_MAX_MS         300   // 单击的最长按压时间
+#define BUTTON_LONG_PRESS_MS        1000  // 长按的触发时间
+#define BUTTON_DOUBLE_CLICK_GAP_MS  250   // 双击中两次单击的最大间隔
+#define BUTTON_PROGRESS_INTERVAL_MS 20    // 长按进度事件的发送间隔
+
+typedef enum {
+    BUTTON_EVENT_PRESS,               // 按下 (已消抖)
+    BUTTON_EVENT_RELEASE,             // 松开, held_ms 为本次按压时长
+    BUTTON_EVENT_CLICK,               // 单击
+    BUTTON_EVENT_DOUBLE_CLICK,        // 双击 (需在注册回调时启用)
+    BUTTON_EVENT_LONG_PRESS_PROGRESS, // 按住期间周期发送, held_ms 为已按住时间
+    BUTTON_EVENT_LONG_PRESS           // 按住达到 BUTTON_LONG_PRESS_MS, 之后松开不再产生单击
+} button_event_type_t;
+
+typedef struct {
+    button_event_type_t type;
+    uint32_t held_ms;
+} button_event_t;
+
+typedef void (*button_event_cb_t)(const button_event_t *event);
+
+/**
+ * @brief 安装 GPIO 中断. 需在 pinMode(BUTTON_PIN, INPUT_PULLUP) 之后,
+ * 在 loop() 所在的任务中调用 (按键跳变会唤醒该任务).
+ */
+void ButtonInput_Begin(void);
+
+/**
+ * @brief 设置接收事件的页面回调, 传 NULL 表示不接收.
+ * @param double_click 为 true 时单击会延迟 BUTTON_DOUBLE_CLICK_GAP_MS 以识别双击;
+ *                     不需要双击的页面应传 false, 单击在松开时立即发出.
+ *                     间隔内的下一次按压在能判定之前不发出 PRESS 和长按进度:
+ *                     它在 BUTTON_CLICK_MAX_MS 内松开时依次发出 PRESS, RELEASE, DOUBLE_CLICK;
+ *                     按得更久时先发出第一次的 CLICK, 再发出这次的 PRESS 并照常处理.
+ */
+void ButtonInput_SetHandler(button_event_cb_t handler, bool double_click);
+
+/**
+ * @brief 处理积压的跳变并派发事件, 在 loop() 中每次迭代调用.
+ * @return 距离下一次需要处理的毫秒数 (空闲时为 UINT32_MAX).
+ */
+uint32_t ButtonInput_Process(void);
+
+/**
+ * @brief 当前 (消抖后) 是否处于按下状态.
+ */
+bool ButtonInput_IsPressed(void);
+
+#endif // BUTTON_INPUT_H
@@ -0,0 +1,47 @@
+#ifndef CPU_LOAD_H
+#define CPU_LOAD_H
+
+#include <Arduino.h>
+
+/**
+ * @brief CPU 占用率统计.
+ *
+ * 总占用率由 FreeRTOS 运行时统计中空闲任务实际运行的时间得到 (需要
+ * CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS), 峰值由 100ms 一次的定时器采样;
+ * 各模块的占用份额由调用方用 CpuLoad_SlotEnter()/CpuLoad_SlotExit()
+ * 包住自己的计算部分来统计 (只包 CPU 工作, 不要包阻塞等待).
+ */
+
+typedef enum {
+    CPU_SLOT_LVGL,     // loop() 中的 lv_timer_handler()
+    CPU_SLOT_SENSORS,  // SensorTask 的传感器读取
+    CPU_SLOT_UPLOAD,   // UploadTask 的数据打包
+    CPU_SLOT_COUNT
+} cpu_slot_t;
+
+typedef struct {
+    uint32_t window_ms;                  // 统计窗口长度
+    uint8_t average;                     // 窗口内平均占用率 (%)
+    uint8_t peak;                        // 窗口内最忙的子窗口 (~100ms) 的占用率 (%)
+    uint8_t slot_share[CPU_SLOT_COUNT];  // 各模块占用率 (%)
+} CpuLoadReport;
+
+/**
+ * @brief 启动采样定时器, 开始统计. 在 setup() 中调用一次.
+ */
+void CpuLoad_Begin(void);
+
+/**
+ * @brief 最近一个子窗口的占用率 (%), 用于实时显示.
+ */
+uint8_t CpuLoad_GetUsage(void);
+
+void CpuLoad_SlotEnter(cpu_slot_t slot);
+void CpuLoad_SlotExit(cpu_slot_t slot);
+
+/**
+ * @brief 取出自上次调用以来的统计结果并开始新的窗口.
+ */
+void CpuLoad_TakeReport(CpuLoadReport *out);
+
+#endif // CPU_LOAD_H
@@ -0,0 +1,64 @@
+#ifndef PAGE_MANAGER_H
+#define PAGE_MANAGER_H
+
+#include <lvgl.h>
+
+/**
+ * @brief 页面管理: 缓存已经构建好的屏幕, 切换页面时不再销毁重建.
+ * 页面切换由 Router 发起, 页面本身不直接调用这里的函数.
+ *
+ * 每个页面提供一个 page_desc_t:
+ * - create()     构建屏幕并返回 (不要加载), 定时器可以在这里创建;
+ * - on_show()    每次显示时调用: 恢复定时器, 注册按键回调, 刷新内容;
+ * - on_hide()    切换走时调用: 暂停定时器, 停止蜂鸣器等副作用;
+ * - on_destroy() 屏幕被淘汰后调用 (屏幕已由管理器删除): 删除定时器,
+ *                把指向控件的指针清空.
+ *
+ * 缓存按最近使用淘汰, 最多保留 PAGE_CACHE_SIZE 个屏幕 (pinned 的页面不计入,
+ * 也不会被淘汰). 每次切换后检查 LVGL 内存, 最大空闲块低于
+ * PAGE_CACHE_MIN_FREE_BLOCK 时继续淘汰, 直到只剩当前页面, 上一个页面
+ * (切换动画中仍在显示) 和常驻页面.
+ *
+ * 所有函数只能在 LVGL 线程 (loop 及其回调) 中调用.
+ */
+
+#ifndef PAGE_CACHE_SIZE
+#define PAGE_CACHE_SIZE 3 // 缓存的屏幕数 (含当前页面, 不含常驻页面)
+#endif
+#ifndef PAGE_CACHE_MIN_FREE_BLOCK
+#define PAGE_CACHE_MIN_FREE_BLOCK (8 * 1024) // 低于该值视为内存紧张, 淘汰缓存
+#endif
+#define PAGE_MANAGER_MAX_PAGES 8 // 可管理的页面总数
+
+typedef struct {
+    const char *name;
+    lv_obj_t *(*create)(void);
+    void (*on_show)(void);
+    void (*on_hide)(void);    // 可以为 NULL
+    void (*on_destroy)(void); // 可以为 NULL
+    bool pinned;              // 常驻: 构建一次后不再淘汰
+} page_desc_t;
+
+/**
+ * @brief 显示一个页面: 有缓存时直接加载, 否则先构建. 用 lv_scr_load_anim()
+ * 加载; 当前屏幕不受管理时 (开机默认屏幕, 引导页面), 动画结束后自动删除.
+ * @return 本次是否构建了新屏幕.
+ */
+bool PageManager_Show(const page_desc_t *page, lv_scr_load_anim_t anim, uint32_t anim_ms);
+
+/**
+ * @brief 当前显示的页面, 不受管理的屏幕返回 NULL.
+ */
+const page_desc_t *PageManager_Current(void);
+
+/**
+ * @brief 删除一个页面的缓存 (当前页面除外), 下次显示时重新构建.
+ */
+void PageManager_Evict(const page_desc_t *page);
+
+/**
+ * @brief 在串口打印缓存状态, 以及每个页面最近一次构建的耗时和占用的 LVGL 内存.
+ */
+void PageManager_Print(void);
+
+#endif // PAGE_MANAGER_H
@@ -1,36 +1,48 @@
 #ifndef PAGES_H
 #define PAGES_H
 
+#include <Arduino.h>
 #include <lvgl.h>
+#include "PageManager.h"
 #define BUTTON_PIN 9
 // 屏幕尺寸定义
 #define SCREEN_WIDTH  320
 #define SCREEN_HEIGHT 240
 
 
-extern bool last_button_state;
-extern bool current_button_state;
-
-extern float lm75_temp;
-extern float sht20_temp;
-extern float sht20_humi;
-extern float esp32_temp;
-extern uint32_t ram_free;
-extern uint8_t cpu_usage;
-extern int8_t wifi_rssi;
-
 void NewUserPage1_Hello(void);
 void WLAN_Setup_Page(void);
-void create_dashboard(void);
+void cleanup_wlan_setup_page(void);
 void create_setup_finished_page(void);
-void SendSensorDataToServer(void);
-bool Init_Connection(void);
 
-void Page_About(void);
-void Page_Reset(void);
-void Page_Clock(void);
-void Page_InstantNoodleCountDown(void);
-
-// 页面管理相关函数和变量的声明
+// --- 上报 (WebService.cpp) ---
+bool Init_Connection(void);
+// 交给上报任务一个上报窗口; 上报队列已满, 窗口被丢弃时返回 false
+bool SendSensorDataToServer(void);
+
+// 上报服务器地址 ("http://host:port/"), 默认值由编译时的 SERVER_URL 指定.
+// 运行时设置的地址保存在 NVS, 下一次上报生效; 传入空串恢复默认值. 地址无效时返回 false
+bool WebService_SetServerUrl(const char *url);
+String WebService_GetServerUrl(void);
+
+// 一次上报请求 (实时或离线缓存重发) 的结果
+typedef struct {
+    int http_code;          // HTTP 状态码; <= 0 为 HTTPClient 的错误码
+    uint32_t latency_us;    // 从发起请求到读完响应 (或出错)
+    uint16_t samples;
+    bool replay;            // 离线缓存重发的批次
+} UploadResult;
+
+typedef void (*upload_observer_t)(const UploadResult *result);
+// 每次上报请求结束后在上报任务中调用, 用于统计; 传 NULL 取消
+void WebService_SetUploadObserver(upload_observer_t observer);
+
+// 功能页面, 由 Router 的页面表注册, 通过 Router_Show()/Router_Navigate() 切换
+extern const page_desc_t DASHBOARD_PAGE;
+extern const page_desc_t ABOUT_PAGE;
+extern const page_desc_t INFO_PAGE;
+extern const page_desc_t RESET_PAGE;
+extern const page_desc_t CLOCK_PAGE;
+extern const page_desc_t NOODLE_PAGE;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+/**
+ * @brief 显示与主循环的性能计数器.
+ *
+ * 统计窗口从上一次 PerfStats_Take(..., true) 开始; 串口查看不会清零,
+ * 上报数据时清零, 因此每次上报的是一个上报间隔内的数据.
+ */
+
+// flush 延迟直方图的桶上界 (us), 最后一个桶收集所有更长的传输
+#define PERF_FLUSH_HIST_BUCKETS 8
+extern const uint32_t PERF_FLUSH_HIST_EDGES_US[PERF_FLUSH_HIST_BUCKETS - 1];
+
+typedef struct {
+    uint32_t window_ms;
+    uint32_t frames;                 // 实际渲染的帧数
+    uint32_t render_avg_us;          // 每帧渲染耗时 (RENDER_START -> RENDER_READY)
+    uint32_t render_max_us;
+    uint32_t flushed_pixels;         // 窗口内送往屏幕的像素数
+    uint32_t flush_px_per_s;
+    uint32_t flush_hist[PERF_FLUSH_HIST_BUCKETS]; // flush 开始到 DMA 完成的耗时分布
+    uint32_t loop_max_us;            // 最慢的一次 loop() 迭代 (不含休眠)
+    uint32_t widget_redraws;         // 仪表盘因显示内容变化而修改控件的次数
+    uint32_t widget_skips;           // 显示内容没变、跳过修改的次数
+} PerfReport;
+
+/**
+ * @brief 注册显示事件, 统计每帧渲染时间.
+ */
+void PerfStats_Attach(lv_display_t *disp);
+
+/**
+ * @brief 在 flush 回调中提交一块像素时调用.
+ */
+void PerfStats_FlushBegin(uint32_t pixels);
+
+/**
+ * @brief 观察到上一块像素的 DMA 传输已完成时调用.
+ */
+void PerfStats_FlushEnd(void);
+
+/**
+ * @brief 记录一次 loop() 迭代的耗时.
+ */
+void PerfStats_LoopIteration(uint32_t elapsed_us);
+
+/**
+ * @brief 记录一次控件更新判断: redrawn 为 true 表示显示内容变化、修改了控件.
+ */
+void PerfStats_WidgetUpdate(bool redrawn);
+
+/**
+ * @brief 读取当前窗口的统计结果, reset 为 true 时开始新窗口.
+ */
+void PerfStats_Take(PerfReport *out, bool reset);
+
+/**
+ * @brief 通过串口打印当前窗口的统计结果.
+ */
+void PerfStats_Print(void);
+
+#endif // PERF_STATS_H
@@ -0,0 +1,54 @@
+#ifndef ROUTER_H
+#define ROUTER_H
+
+#include <lvgl.h>
+
+/**
+ * @brief 页面路由: 注册的页面表 + 声明式的导航图.
+ *
+ * 页面之间不再互相调用: 页面只报告用户动作 (Router_Navigate(NAV_NEXT) 等),
+ * 目标页面和切换动画由 Router.cpp 中的导航图决定. 所有切换都走同一条路径:
+ * 旧页面 on_hide (暂停定时器) -> PageManager 取缓存或构建 -> lv_scr_load_anim
+ * -> 新页面 on_show, 并在这里统一测量切换耗时.
+ */
+
+#ifndef ROUTER_ANIM_MS
+#define ROUTER_ANIM_MS 200 // 切换动画时长, 为 0 时直接切换
+#endif
+
+typedef enum {
+    PAGE_DASHBOARD,
+    PAGE_ABOUT,
+    PAGE_INFO,
+    PAGE_RESET,
+    PAGE_CLOCK,
+    PAGE_NOODLE,
+    PAGE_COUNT,
+    PAGE_NONE = PAGE_COUNT
+} page_id_t;
+
+typedef enum {
+    NAV_NEXT,  // 单击: 进入下一个功能页
+    NAV_ENTER, // 长按: 进入子页面
+    NAV_BACK   // 从子页面返回
+} nav_action_t;
+
+/**
+ * @brief 直接显示一个页面 (开机, 引导流程结束), 不走导航图, 没有动画.
+ */
+void Router_Show(page_id_t page);
+
+/**
+ * @brief 按导航图从当前页面执行一个动作.
+ * @return 导航图中没有对应的边时返回 false, 页面不变.
+ */
+bool Router_Navigate(nav_action_t action);
+
+page_id_t Router_Current(void);
+
+/**
+ * @brief 在串口打印各页面的切换耗时和页面缓存状态.
+ */
+void Router_Print(void);
+
+#endif // ROUTER_H
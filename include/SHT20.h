@@ -0,0 +1,66 @@
+#ifndef SHT20_H
+#define SHT20_H
+
+#include <Arduino.h>
+
+/**
+ * @brief SHT20 非阻塞驱动.
+ *
+ * 使用 "No Hold Master" 模式: 触发一次转换后立即返回, 由调用方在之后的
+ * 循环中调用 SHT20_Poll() 取回结果. 转换期间不会占用 I2C 总线, 也不会
+ * 阻塞 lv_timer_handler().
+ */
+
+// 分辨率选择 (用户寄存器 bit7 / bit0)
+typedef enum {
+    SHT20_RES_RH12_T14 = 0x00, // 默认: RH 12bit / T 14bit, 最长 29ms + 85ms
+    SHT20_RES_RH8_T12  = 0x01, // RH 8bit  / T 12bit, 最长 4ms  + 22ms
+    SHT20_RES_RH10_T13 = 0x80, // RH 10bit / T 13bit, 最长 9ms  + 43ms
+    SHT20_RES_RH11_T11 = 0x81  // RH 11bit / T 11bit, 最长 15ms + 11ms
+} sht20_resolution_t;
+
+// 测量阶段安排
+typedef enum {
+    SHT20_PHASES_SEQUENTIAL,  // 每次测量依次完成温度和湿度
+    SHT20_PHASES_INTERLEAVED  // 每次测量只做一个阶段, 温度/湿度交替进行
+} sht20_phase_mode_t;
+
+/**
+ * @brief 初始化驱动并写入分辨率寄存器. 需在 Wire.begin() 之后调用.
+ * @return 传感器应答并成功写入时返回 true.
+ */
+bool SHT20_Begin(sht20_resolution_t resolution, sht20_phase_mode_t mode);
+
+/**
+ * @brief 修改分辨率 (读-改-写用户寄存器). 测量进行中时返回 false.
+ */
+bool SHT20_SetResolution(sht20_resolution_t resolution);
+
+/**
+ * @brief 触发一次测量并立即返回. 若上一次测量尚未完成则返回 false.
+ */
+bool SHT20_StartMeasurement(void);
+
+/**
+ * @brief 推进状态机, 应在每次循环中调用.
+ * @return 本次调用完成了一次测量时返回 true, 并写入 temp_centi (0.01 °C) /
+ *         humi_centi (0.01 %RH) (交错模式下未测量的一项保持上一次的值).
+ */
+bool SHT20_Poll(int16_t &temp_centi, int16_t &humi_centi);
+
+/**
+ * @brief 原始温度码换算为 0.01 °C, 向下取整, 全程整数运算.
+ */
+int16_t SHT20_RawToTempCenti(uint16_t raw);
+
+/**
+ * @brief 原始湿度码换算为 0.01 %RH, 向下取整, 全程整数运算.
+ */
+int16_t SHT20_RawToHumiCenti(uint16_t raw);
+
+/**
+ * @brief 是否有测量正在进行.
+ */
+bool SHT20_IsBusy(void);
+
+#endif // SHT20_H
@@ -0,0 +1,82 @@
+#ifndef SENSOR_HUB_H
+#define SENSOR_HUB_H
+
+#include <Arduino.h>
+
+// 温湿度统一用 0.01 单位的整数表示 (ESP32-C3 没有 FPU), 读取失败时为该值
+#define SENSOR_CENTI_INVALID INT16_MIN
+
+/**
+ * @brief 一次完整采样的快照. 由传感器任务整体发布, 读者总是拿到同一轮采样的数据.
+ */
+typedef struct {
+    uint32_t sequence;      // 采样序号, 每发布一次加一 (0 表示尚无数据)
+    uint32_t timestamp_ms;  // 采样完成时的 millis()
+    int16_t lm75_centi;     // 0.01 °C
+    int16_t sht20_temp_centi; // 0.01 °C
+    int16_t sht20_humi_centi; // 0.01 %RH
+    int16_t esp32_centi;    // 0.01 °C
+    uint32_t ram_free;
+    uint8_t cpu_usage;
+    int8_t wifi_rssi;
+} SensorSnapshot;
+
+#define SENSOR_HUB_DEFAULT_PERIOD_MS 2000
+#define SENSOR_HUB_DEFAULT_PRIORITY  2   // 高于 loopTask(1), 见 SensorHub.cpp
+#define SENSOR_HUB_HISTORY_LEN       32  // 保留的历史采样数 (默认周期下约 64s)
+
+/**
+ * @brief 启动传感器采集任务. 需在 Wire.begin() 之后调用, 重复调用无副作用.
+ * @param period_ms 采样周期
+ * @param priority  任务优先级
+ */
+void SensorHub_Start(uint32_t period_ms, UBaseType_t priority);
+
+/**
+ * @brief 无锁读取最新快照 (seqlock).
+ * @return 有可用数据时返回 true 并写入 out; 尚未完成第一次采样时返回 false.
+ */
+bool SensorHub_Read(SensorSnapshot *out);
+
+typedef void (*sensor_data_cb_t)(const SensorSnapshot *snapshot);
+
+/**
+ * @brief 设置在 LVGL 线程中接收新采样的页面回调, 传 NULL 表示不接收.
+ * 在 loop() 所在的任务中调用: 之后传感器任务每发布一次采样就用任务通知唤醒
+ * 该任务, 页面不需要定时轮询. 设置后的第一次 SensorHub_Process() 会先交出当前快照.
+ */
+void SensorHub_SetHandler(sensor_data_cb_t handler);
+
+/**
+ * @brief 有新采样时把最新快照交给回调 (期间错过的采样不补发), 在 loop() 中每次迭代调用.
+ * 没有新采样时只读一个整数.
+ */
+void SensorHub_Process(void);
+
+/**
+ * @brief 读取序号大于 after_sequence 的历史采样, 按时间从旧到新写入 out.
+ * 只保留最近 SENSOR_HUB_HISTORY_LEN 次采样, 更早的已被覆盖, 调用方可以
+ * 通过 out[0].sequence 判断中间丢了多少条.
+ * @return 写入的采样数 (不超过 max_count).
+ */
+size_t SensorHub_ReadHistory(uint32_t after_sequence, SensorSnapshot *out, size_t max_count);
+
+/**
+ * @brief 把 0.01 单位的值格式化为一位小数加单位, 例如 2345 -> "23.5°C", -4 -> "-0.0°C".
+ * centi 为向下取整的值 (见 SHT20), 再四舍五入到 0.1 等于对换算公式的精确值四舍五入.
+ * 与原先 snprintf("%.1f") 对浮点换算值的显示一致, 只有精确值正好是 .x5 时不同:
+ * printf 按四舍六入五成双处理, 这里总是进位. SHT20 全部原始码中只有湿度
+ * 0x4000 (25.25 %RH) 一处, 显示 "25.3%" 而不是 "25.2%". 见 test/test_fixed_point.
+ * @return 写入的字符数 (同 snprintf).
+ */
+int SensorHub_FormatCenti(char *buf, size_t size, int16_t centi, const char *unit);
+
+/**
+ * @brief 把 0.01 单位的值按量程 [min, max] 映射为 0-100 (向下取整), 用于弧形进度条.
+ * 与原先的浮点计算一致, 只有精确值正好落在整数百分比上时, 浮点舍入误差会让结果差一:
+ * SHT20 温度 0x6738 (23.999995 °C, 浮点为 24.0) 和湿度 0x8000 (56.5 %RH) 两处,
+ * 这里给出精确值的结果 (44 和 53, 浮点为 45 和 52).
+ */
+int SensorHub_ScalePercent(int32_t centi, int32_t min, int32_t max);
+
+#endif // SENSOR_HUB_H
@@ -0,0 +1,15 @@
+#ifndef SPOOL_PARTITION_H
+#define SPOOL_PARTITION_H
+
+#include "TelemetrySpool.h"
+
+#define SPOOL_PARTITION_LABEL   "spool" // 见 partitions.csv
+#define SPOOL_PARTITION_SUBTYPE 0x40
+
+/**
+ * @brief 用 flash 分区实现 spool_flash_t.
+ * @return 找不到分区时返回 false.
+ */
+bool SpoolPartition_Open(spool_flash_t *out);
+
+#endif // SPOOL_PARTITION_H
@@ -0,0 +1,19 @@
+#ifndef TELEMETRY_BENCH_H
+#define TELEMETRY_BENCH_H
+
+#include <Arduino.h>
+
+/**
+ * @brief 比较 JSON 与 CBOR 两种上报编码的体积和编码耗时, 结果打印到串口.
+ * 在 loop() 中收到串口命令 'b' 时运行, 期间会阻塞界面约几十毫秒.
+ */
+void TelemetryBench_Run(void);
+
+/**
+ * @brief 比较传感器换算与界面格式化的浮点实现和定点实现的 CPU 周期数. 串口命令 'f'.
+ * 宿主上 (program --bench-fixed) 计数是宿主的周期数; 宿主有 FPU, 只有格式化一项与板上可比.
+ * 两者显示结果的逐码比较见 test/test_fixed_point.
+ */
+void TelemetryBench_RunFixedPoint(void);
+
+#endif // TELEMETRY_BENCH_H
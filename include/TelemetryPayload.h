@@ -0,0 +1,64 @@
+#ifndef TELEMETRY_PAYLOAD_H
+#define TELEMETRY_PAYLOAD_H
+
+#include "SensorHub.h"
+#include "CpuLoad.h"
+#include "PerfStats.h"
+
+/**
+ * @brief 上报数据的编码 (JSON / CBOR).
+ *
+ * 直接写入调用方提供的定长缓冲区, 不做任何堆分配. 温湿度本身就是 0.01
+ * 单位的整数, JSON 中按两位小数输出, 无效值输出为 null; 全程没有浮点运算.
+ *
+ * 默认上报 JSON; 编译时定义 TELEMETRY_USE_CBOR 改用 CBOR (application/cbor).
+ */
+
+#ifndef TELEMETRY_UPLOAD_INTERVAL_MS
+#define TELEMETRY_UPLOAD_INTERVAL_MS 10000 // 批量上报的间隔
+#endif
+#define TELEMETRY_BATCH_MAX_SAMPLES  32    // 每批最多携带的采样数 (离线缓存重发时用满)
+
+// 每个上报间隔内产生的采样都应能放进一批
+#if TELEMETRY_BATCH_MAX_SAMPLES * SENSOR_HUB_DEFAULT_PERIOD_MS < TELEMETRY_UPLOAD_INTERVAL_MS
+#error "TELEMETRY_BATCH_MAX_SAMPLES too small for TELEMETRY_UPLOAD_INTERVAL_MS"
+#endif
+
+// 编码结果的最大长度 (含结尾 '\0'). 所有字段取最长值时:
+// 批次头尾约 430 字节, 每条采样约 193 字节 (含逗号).
+#define TELEMETRY_PAYLOAD_MAX (448 + 196 * TELEMETRY_BATCH_MAX_SAMPLES)
+
+// 一次批量上报: 多条采样, 实时上报时再加上整个上报窗口的 CPU/性能统计
+typedef struct {
+    const SensorSnapshot *samples; // 按时间从旧到新
+    size_t count;
+    uint16_t boot;                 // 采样所属的启动次数, ts 只在同一次启动内可比较
+    bool replay;                   // 来自离线缓存的重发
+    uint32_t dropped;              // 上次上报之后丢失的采样数
+    uint32_t uptime_ms;            // 发送时的 millis(), boot 为本次启动时与 ts 同一时基
+    uint64_t epoch_ms;             // 与 uptime_ms 同一时刻的 UTC 毫秒数, 0 表示未知 (不输出);
+                                   // 服务器据此把 ts 换算为绝对时间: epoch_ms - (uptime_ms - ts)
+    const CpuLoadReport *cpu_report; // 为 NULL 时不输出窗口统计
+    const PerfReport *perf_report;
+} TelemetryBatch;
+
+/**
+ * @brief 把一批采样编码为 JSON 对象:
+ * {"boot":..,"uptime_ms":..,"epoch_ms":..,"replay":..,"dropped":..,"samples":[{"seq":..,"ts":..,...},...],"cpu_usage":..,...}
+ * @param out 输出缓冲区, 建议大小 TELEMETRY_PAYLOAD_MAX
+ * @return 写入的字节数 (不含结尾 '\0'); 缓冲区不足时返回 0, out 为空字符串.
+ */
+size_t TelemetryPayload_EncodeBatch(const TelemetryBatch *batch, char *out, size_t out_size);
+
+/**
+ * @brief 把一批采样编码为 CBOR (RFC 8949), 字段名与 JSON 相同, 但采样按列存放:
+ * {"boot":..,"uptime_ms":..,"epoch_ms":..,"replay":..,"dropped":..,
+ *  "samples":{"seq":[..],"ts":[..],"lm75_temp":[..],...},"cpu_usage":..,...}
+ * 每列第一个元素是原值, 之后每个元素是与前一个有效值的差; 温湿度为 0.01 单位
+ * 的整数 (即采样中的原值). 无效值记为 null, 不参与差分. 窗口统计与 JSON 一样为整数.
+ * 结果不会超过同一批数据的 JSON 长度, 缓冲区同样用 TELEMETRY_PAYLOAD_MAX.
+ * @return 写入的字节数; 缓冲区不足时返回 0.
+ */
+size_t TelemetryPayload_EncodeBatchCbor(const TelemetryBatch *batch, uint8_t *out, size_t out_size);
+
+#endif // TELEMETRY_PAYLOAD_H
@@ -0,0 +1,68 @@
+#ifndef TELEMETRY_SPOOL_H
+#define TELEMETRY_SPOOL_H
+
+#include "SensorHub.h"
+
+/**
+ * @brief 离线上报缓存: flash 上的只追加环形日志.
+ *
+ * 网络不可用或上报失败时, 采样以 32 字节的二进制记录追加到 flash,
+ * 恢复连接后按批读出重发, 服务器确认后再标记为已消费.
+ *
+ * 布局: 分区按扇区循环使用, 每个扇区的第一个槽位是扇区头 (带递增的扇区
+ * 序号), 其余槽位存放记录. 写满一个扇区后擦除并启用下一个扇区, 因此所有
+ * 扇区被均匀擦写 (天然的磨损均衡). 缓存满时覆盖最旧的扇区.
+ *
+ * 记录状态只通过把位从 1 写成 0 来改变 (空 -> 已写入 -> 已消费), 不需要
+ * 额外擦除. 掉电造成的半条记录由 CRC 识别并跳过.
+ *
+ * flash 访问通过 spool_flash_t 抽象, 设备上由 SpoolPartition 提供分区实现,
+ * 主机上可以换成文件.
+ */
+
+#define SPOOL_RECORD_SIZE 32
+
+typedef struct {
+    bool (*read)(void *ctx, uint32_t offset, void *buf, size_t len);
+    bool (*write)(void *ctx, uint32_t offset, const void *buf, size_t len);
+    bool (*erase)(void *ctx, uint32_t offset, size_t len); // 按扇区对齐
+    void *ctx;
+    uint32_t size;        // 总字节数, sector_size 的整数倍
+    uint32_t sector_size; // 擦除单位, 须为 SPOOL_RECORD_SIZE 的整数倍
+} spool_flash_t;
+
+/**
+ * @brief 挂载缓存: 扫描扇区头恢复读写位置. 只在上报任务中使用, 不加锁.
+ * @return flash 参数不合法时返回 false.
+ */
+bool TelemetrySpool_Begin(const spool_flash_t *flash);
+
+/**
+ * @brief 追加一条采样.
+ * @param boot 采样所属的启动次数, 不同启动的 ts 不可比较
+ */
+bool TelemetrySpool_Append(const SensorSnapshot *sample, uint16_t boot);
+
+/**
+ * @brief 从最旧的未消费记录开始读出最多 max_count 条, 不改变缓存内容.
+ * 一次返回的采样总是属于同一次启动, 遇到启动编号变化时提前结束.
+ * @return 读出的条数; 调用 TelemetrySpool_Commit() 才会把它们标记为已消费.
+ */
+size_t TelemetrySpool_Peek(SensorSnapshot *out, size_t max_count, uint16_t *boot);
+
+/**
+ * @brief 把上一次 Peek 读出的记录 (以及其间 CRC 错误的记录) 标记为已消费.
+ */
+void TelemetrySpool_Commit(void);
+
+/**
+ * @brief 尚未消费的记录数 (估算值, 包含 CRC 错误的记录).
+ */
+uint32_t TelemetrySpool_Pending(void);
+
+/**
+ * @brief 因缓存写满而被覆盖的记录总数.
+ */
+uint32_t TelemetrySpool_Overwritten(void);
+
+#endif // TELEMETRY_SPOOL_H
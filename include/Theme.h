@@ -0,0 +1,70 @@
+#ifndef THEME_H
+#define THEME_H
+
+#include <lvgl.h>
+
+/**
+ * @brief 功能页面共用的样式.
+ *
+ * lv_obj_set_style_*() 会给每个控件单独分配一份本地样式, 页面构建时的
+ * 内存占用和耗时都随控件数增长. 这里的样式在 Theme_Init() 中初始化一次,
+ * 页面用 lv_obj_add_style() 引用, 每个控件只多一个指针大小的条目.
+ * 同一属性以后添加的样式为准, 所以可以叠加 (例如 theme_text + theme_font_24).
+ *
+ * 只随运行状态变化的属性 (仪表颜色, 倒计时颜色, 同步状态颜色) 仍然用
+ * 本地样式; 坐标和尺寸也不放在这里.
+ */
+
+// --- 调色板 ---
+// 仪表盘, About/Info 和 Reset 页面
+#define THEME_COLOR_BG       lv_color_hex(0xF5F5F5) // 页面背景
+#define THEME_COLOR_SURFACE  lv_color_white()       // 卡片, 图例
+#define THEME_COLOR_TEXT     lv_color_hex(0x323232)
+#define THEME_COLOR_MUTED    lv_color_hex(0x808080) // 提示文字
+#define THEME_COLOR_ACCENT   lv_color_hex(0x3498DB)
+#define THEME_COLOR_SUCCESS  lv_color_hex(0x27AE60)
+#define THEME_COLOR_WARNING  lv_color_hex(0xF39C12)
+#define THEME_COLOR_DANGER   lv_color_hex(0xE74C3C)
+#define THEME_COLOR_BORDER   lv_color_hex(0xE8E8E8) // 卡片边框
+#define THEME_COLOR_TRACK    lv_color_hex(0xE0E0E0) // 进度条底色
+// 时钟和泡面计时页面的背景与文字 (偏冷的灰色和蓝灰色), 其余颜色同上
+#define THEME_COLOR_BG_COOL   lv_color_hex(0xF8F9FA)
+#define THEME_COLOR_TEXT_COOL lv_color_hex(0x2C3E50)
+
+#define THEME_PAGE_PAD 20
+
+// --- 布局 ---
+extern lv_style_t theme_screen;    // 页面背景, 不带内边距
+extern lv_style_t theme_page;      // 页面背景 + THEME_PAGE_PAD 内边距
+extern lv_style_t theme_page_cool; // 同 theme_page, 背景为 THEME_COLOR_BG_COOL
+extern lv_style_t theme_plain;     // 透明无边框的布局容器, 内边距 10
+extern lv_style_t theme_card;      // 白底圆角带阴影的卡片
+
+// --- 文字 ---
+extern lv_style_t theme_text;
+extern lv_style_t theme_text_cool;
+extern lv_style_t theme_text_muted;
+extern lv_style_t theme_text_accent;
+extern lv_style_t theme_text_center; // 整行宽度, 文字居中
+
+extern lv_style_t theme_font_12;
+extern lv_style_t theme_font_14;
+extern lv_style_t theme_font_16;
+extern lv_style_t theme_font_18;
+extern lv_style_t theme_font_20;
+extern lv_style_t theme_font_22;
+extern lv_style_t theme_font_24;
+extern lv_style_t theme_font_28;
+extern lv_style_t theme_font_48;
+
+// --- 进度条 ---
+extern lv_style_t theme_bar;         // LV_PART_MAIN: 底色和圆角
+extern lv_style_t theme_bar_accent;  // LV_PART_INDICATOR
+extern lv_style_t theme_bar_danger;  // LV_PART_INDICATOR, 危险操作
+
+/**
+ * @brief 初始化所有样式. 在 lv_init() 之后, 创建第一个页面之前调用一次.
+ */
+void Theme_Init(void);
+
+#endif // THEME_H
@@ -0,0 +1,67 @@
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include <Arduino.h>
+#include <time.h>
+
+/**
+ * @brief 全局时间服务.
+ *
+ * 开机时 (Init_Connection() 之后) 启动一次, 之后整个运行期间由它管理 SNTP,
+ * 页面切换不会重新同步:
+ * - 上电时系统时间未设置, 先用 NVS 中保存的上一次有效时间作为近似值
+ *   (TIME_RESTORED), 页面可以立即显示; 软复位时 RTC 保留的时间直接沿用.
+ * - 首次同步直接设置时间, 之后改为平滑同步 (adjtime 逐步校正), 时间不再跳变.
+ * - 每次同步用服务器时间和单调时钟比较, 估算晶振漂移 (ppm), 并据此调整
+ *   同步间隔, 使两次同步之间累积的误差不超过 TIME_SERVICE_MAX_ERROR_MS.
+ * - 每次同步成功把当前时间写入 NVS.
+ *
+ * 读取接口都不阻塞, 可以在任意任务中调用.
+ */
+
+#define TIME_SERVICE_TZ              "CST-8"        // GMT+8, 无夏令时
+#define TIME_SERVICE_NTP_SERVER      "pool.ntp.org"
+#define TIME_SERVICE_MIN_INTERVAL_MS (15UL * 60 * 1000)  // 同步间隔下限
+#define TIME_SERVICE_MAX_INTERVAL_MS (4UL * 3600 * 1000) // 同步间隔上限
+#define TIME_SERVICE_MAX_ERROR_MS    250                 // 两次同步之间允许累积的误差
+
+typedef enum {
+    TIME_UNSET,    // 从未同步, 也没有保存的时间
+    TIME_RESTORED, // 保存的或 RTC 保留的时间, 本次启动还未经 SNTP 确认
+    TIME_SYNCED    // 本次启动已与 SNTP 同步
+} time_quality_t;
+
+typedef struct {
+    time_quality_t quality;
+    uint32_t sync_count;       // 本次启动的同步次数
+    uint32_t last_sync_age_ms; // 距上次同步的时间, 未同步时为 UINT32_MAX
+    int32_t drift_ppm;         // 估算的漂移, 正值表示本地时钟偏慢
+    uint32_t interval_ms;      // 当前的同步间隔
+} TimeServiceStatus;
+
+/**
+ * @brief 设置时区, 恢复保存的时间并启动 SNTP. 重复调用无副作用.
+ */
+void TimeService_Begin(void);
+
+time_quality_t TimeService_Quality(void);
+
+/**
+ * @brief 当前本地时间 (不阻塞).
+ * @return 时间未设置 (TIME_UNSET) 时返回 false.
+ */
+bool TimeService_LocalTime(struct tm *out);
+
+/**
+ * @brief 当前 UTC 毫秒数. 只有 TIME_SYNCED 时返回非零值, 可用于上报数据的时间戳.
+ */
+uint64_t TimeService_EpochMs(void);
+
+void TimeService_GetStatus(TimeServiceStatus *out);
+
+/**
+ * @brief 在串口打印同步状态.
+ */
+void TimeService_Print(void);
+
+#endif // TIME_SERVICE_H
@@ -0,0 +1,120 @@
+#include <Arduino.h>
+#include "NativeHost.h"
+#include <stdarg.h>
+#include <poll.h>
+#include <unistd.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+HostSerial Serial;
+EspClass ESP;
+
+// ========== Print ==========
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (n < size && write(buffer[n])) {
+        n++;
+    }
+    return n;
+}
+
+size_t Print::printf(const char *format, ...) {
+    char stack_buf[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(stack_buf, sizeof(stack_buf), format, args);
+    va_end(args);
+    if (len < 0) {
+        return 0;
+    }
+    if ((size_t)len < sizeof(stack_buf)) {
+        return write((const uint8_t *)stack_buf, len);
+    }
+    std::string heap_buf(len + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&heap_buf[0], heap_buf.size(), format, args);
+    va_end(args);
+    return write((const uint8_t *)heap_buf.data(), len);
+}
+
+// ========== Serial ==========
+
+static int pending_char = -1; // available() 已从 stdin 读出但还没被 read() 取走的字符
+static bool stdin_closed = false;
+
+int HostSerial::available(void) {
+    if (pending_char >= 0) {
+        return 1;
+    }
+    if (stdin_closed) {
+        return 0;
+    }
+    struct pollfd fd = { STDIN_FILENO, POLLIN, 0 };
+    if (poll(&fd, 1, 0) <= 0) {
+        return 0;
+    }
+    unsigned char c;
+    if (::read(STDIN_FILENO, &c, 1) != 1) {
+        stdin_closed = true; // EOF 后 poll 会一直可读
+        return 0;
+    }
+    pending_char = c;
+    return 1;
+}
+
+int HostSerial::read(void) {
+    if (!available()) {
+        return -1;
+    }
+    int c = pending_char;
+    pending_char = -1;
+    return c;
+}
+
+size_t HostSerial::write(uint8_t c) {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HostSerial::write(const uint8_t *buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
+
+// ========== 时间 ==========
+
+unsigned long millis(void) {
+    return (unsigned long)(NativeHost_TimeUs() / 1000);
+}
+
+unsigned long micros(void) {
+    return (unsigned long)NativeHost_TimeUs();
+}
+
+void delay(uint32_t ms) {
+    NativeHost_SleepUs((int64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+    NativeHost_SleepUs(us);
+}
+
+// ========== 芯片 ==========
+
+// 只有基准 (TelemetryBench) 用到: 宿主上读宿主自己的计数器, 数值是宿主的周期数,
+// 不是换算成 160 MHz 的板上周期. 虚拟时钟不影响它.
+uint32_t EspClass::getCycleCount(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec); // 纳秒
+#endif
+}
+
+void EspClass::restart(void) {
+    Serial.println("ESP.restart() requested, exiting.");
+    NativeHost_Exit(0);
+}
@@ -0,0 +1,156 @@
+#ifndef NATIVE_HOST_ARDUINO_H
+#define NATIVE_HOST_ARDUINO_H
+
+/**
+ * @brief [env:native] 下代替 Arduino-ESP32 核心的最小子集, 只实现固件用到的部分.
+ * 时间来自宿主的单调时钟, GPIO 是一张内存中的电平表 (见 NativeHost.h),
+ * Serial 读写标准输入输出.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+#include <string>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_err.h"
+
+#define IRAM_ATTR
+#define PROGMEM
+
+#define LOW          0x0
+#define HIGH         0x1
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+#define digitalPinToInterrupt(p) (p)
+
+#define PI         3.1415926535897932384626433832795
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+// --- String ---
+
+class String {
+public:
+    String() {}
+    String(const char *s) : str(s ? s : "") {}
+    String(const std::string &s) : str(s) {}
+    String(int value) : str(std::to_string(value)) {}
+    String(unsigned int value) : str(std::to_string(value)) {}
+    String(long value) : str(std::to_string(value)) {}
+    String(unsigned long value) : str(std::to_string(value)) {}
+
+    const char *c_str() const { return str.c_str(); }
+    unsigned int length() const { return (unsigned int)str.size(); }
+    bool isEmpty() const { return str.empty(); }
+
+    String &operator+=(const String &other) { str += other.str; return *this; }
+    String &operator+=(const char *other) { str += other ? other : ""; return *this; }
+    String &operator+=(char c) { str += c; return *this; }
+    bool operator==(const String &other) const { return str == other.str; }
+    bool operator==(const char *other) const { return str == (other ? other : ""); }
+    bool operator!=(const String &other) const { return str != other.str; }
+    bool operator!=(const char *other) const { return !(*this == other); }
+
+    friend String operator+(const String &a, const String &b) { return String(a.str + b.str); }
+    friend String operator+(const String &a, const char *b) { return String(a.str + (b ? b : "")); }
+    friend String operator+(const char *a, const String &b) { return String((a ? a : "") + b.str); }
+
+private:
+    std::string str;
+};
+
+// --- Print ---
+
+class Print;
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *s) { return s ? write((const uint8_t *)s, strlen(s)) : 0; }
+
+    size_t print(const char *s) { return write(s); }
+    size_t print(const String &s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value) { return printf("%d", value); }
+    size_t print(unsigned int value) { return printf("%u", value); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(double value, int digits = 2) { return printf("%.*f", digits, value); }
+    size_t print(const Printable &p) { return p.printTo(*this); }
+
+    size_t println(void) { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T &value) { size_t n = print(value); return n + println(); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+// 标准输出/标准输入上的 Serial; available()/read() 不阻塞
+class HostSerial : public Print {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    int available(void);
+    int read(void);
+    void flush(void) { fflush(stdout); }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+};
+
+extern HostSerial Serial;
+
+// --- 时间 ---
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+// --- GPIO ---
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t level);
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+// --- 芯片 ---
+
+float temperatureRead(void);
+
+class EspClass {
+public:
+    uint32_t getFreeHeap(void);
+    // 宿主 CPU 的时间戳计数 (x86 为 TSC, 其他平台为纳秒), 只用于在宿主上比较两段代码
+    uint32_t getCycleCount(void);
+    void restart(void);
+};
+
+extern EspClass ESP;
+
+void configTzTime(const char *tz, const char *server1,
+                  const char *server2 = nullptr, const char *server3 = nullptr);
+
+#endif // NATIVE_HOST_ARDUINO_H
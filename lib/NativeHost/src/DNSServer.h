@@ -0,0 +1,19 @@
+#ifndef NATIVE_HOST_DNSSERVER_H
+#define NATIVE_HOST_DNSSERVER_H
+
+#include <WiFi.h>
+
+// 强制门户 DNS 的宿主替身, 不监听端口
+class DNSServer {
+public:
+    bool start(uint16_t port, const String &domain_name, const IPAddress &resolved_ip) {
+        (void)port;
+        (void)domain_name;
+        (void)resolved_ip;
+        return true;
+    }
+    void stop(void) {}
+    void processNextRequest(void) {}
+};
+
+#endif // NATIVE_HOST_DNSSERVER_H
@@ -0,0 +1,9 @@
+#ifndef NATIVE_HOST_ESP32WEBSERVER_H
+#define NATIVE_HOST_ESP32WEBSERVER_H
+
+#include <WebServer.h>
+
+// ESP32WebServer 与 WebServer 的接口相同
+typedef WebServer ESP32WebServer;
+
+#endif // NATIVE_HOST_ESP32WEBSERVER_H
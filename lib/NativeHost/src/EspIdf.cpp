@@ -0,0 +1,145 @@
+#include <Arduino.h>
+#include "NativeHost.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_partition.h"
+#include "esp_sntp.h"
+#include <mutex>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+// ========== esp_timer ==========
+
+int64_t esp_timer_get_time(void) {
+    return NativeHost_TimeUs();
+}
+
+struct native_esp_timer {
+    esp_timer_create_args_t args;
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out_handle) {
+    if (args == NULL || args->callback == NULL || out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_handle = new native_esp_timer{ *args };
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us) {
+    return timer != NULL && period_us > 0 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+// ========== heap_caps ==========
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    (void)caps;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.fordblks;
+#else
+    return 0;
+#endif
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    // glibc 不提供最大空闲块, 宿主上内存不会真正紧张, 按空闲总量计
+    return heap_caps_get_free_size(caps);
+}
+
+uint32_t EspClass::getFreeHeap(void) {
+    return (uint32_t)heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+}
+
+// ========== 分区 ==========
+
+#define SPOOL_SIZE        0xE0000 // 与 partitions.csv 一致
+#define FLASH_SECTOR_SIZE 4096
+
+static const esp_partition_t spool_partition = {
+    ESP_PARTITION_TYPE_DATA, 0x40, 0x310000, SPOOL_SIZE, "spool", false
+};
+static std::vector<uint8_t> spool_data(SPOOL_SIZE, 0xFF);
+static std::mutex spool_mutex;
+
+static bool in_range(const esp_partition_t *partition, size_t offset, size_t size) {
+    return partition == &spool_partition && offset <= partition->size && size <= partition->size - offset;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type,
+    esp_partition_subtype_t subtype, const char *label) {
+    if (type != spool_partition.type) {
+        return NULL;
+    }
+    if (subtype != ESP_PARTITION_SUBTYPE_ANY && subtype != spool_partition.subtype) {
+        return NULL;
+    }
+    if (label != NULL && strcmp(label, spool_partition.label) != 0) {
+        return NULL;
+    }
+    return &spool_partition;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size) {
+    if (!in_range(partition, src_offset, size)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    std::lock_guard<std::mutex> lock(spool_mutex);
+    memcpy(dst, &spool_data[src_offset], size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *partition, size_t dst_offset, const void *src, size_t size) {
+    if (!in_range(partition, dst_offset, size)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    std::lock_guard<std::mutex> lock(spool_mutex);
+    const uint8_t *bytes = (const uint8_t *)src;
+    for (size_t i = 0; i < size; i++) {
+        spool_data[dst_offset + i] &= bytes[i];
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition, size_t offset, size_t size) {
+    if (offset % FLASH_SECTOR_SIZE != 0 || size % FLASH_SECTOR_SIZE != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!in_range(partition, offset, size)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    std::lock_guard<std::mutex> lock(spool_mutex);
+    memset(&spool_data[offset], 0xFF, size);
+    return ESP_OK;
+}
+
+// ========== SNTP ==========
+
+static sntp_sync_time_cb_t sync_cb = NULL;
+
+void sntp_set_sync_mode(sntp_sync_mode_t mode) {
+    (void)mode;
+}
+
+void sntp_set_sync_interval(uint32_t interval_ms) {
+    (void)interval_ms;
+}
+
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) {
+    sync_cb = callback;
+}
+
+void configTzTime(const char *tz, const char *server1, const char *server2, const char *server3) {
+    (void)server1;
+    (void)server2;
+    (void)server3;
+    setenv("TZ", tz, 1);
+    tzset();
+    if (sync_cb != NULL) {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        sync_cb(&tv);
+    }
+}
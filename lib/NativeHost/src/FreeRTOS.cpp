@@ -0,0 +1,217 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "NativeHost.h"
+#include <string.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ========== 临界区 ==========
+
+void vPortEnterCritical(portMUX_TYPE *mux) {
+    while (mux->locked.exchange(true, std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+void vPortExitCritical(portMUX_TYPE *mux) {
+    mux->locked.store(false, std::memory_order_release);
+}
+
+// ========== 阻塞等待 ==========
+
+// 虚拟时钟下其他线程的等待多久检查一次时间
+#define VIRTUAL_CLOCK_POLL_US 200
+
+// 在 cv 上等待 pred 成立, 最多 ticks 个 tick; 返回 pred 的结果
+template <typename Pred>
+static bool wait_ticks(std::condition_variable &cv, std::unique_lock<std::mutex> &lock,
+                       TickType_t ticks, Pred pred) {
+    if (ticks == portMAX_DELAY) {
+        cv.wait(lock, pred);
+        return true;
+    }
+    int64_t timeout_us = (int64_t)ticks * portTICK_PERIOD_MS * 1000;
+    if (!NativeHost_ClockIsVirtual()) {
+        return cv.wait_for(lock, std::chrono::microseconds(timeout_us), pred);
+    }
+    if (pred()) {
+        return true;
+    }
+    if (NativeHost_OwnsClock()) {
+        // 没有别人推进时间, 直接推进到超时; 其他线程在此期间的唤醒到返回时才看到
+        lock.unlock();
+        NativeHost_AdvanceUs(timeout_us);
+        lock.lock();
+        return pred();
+    }
+    int64_t deadline = NativeHost_TimeUs() + timeout_us;
+    while (!pred()) {
+        if (NativeHost_TimeUs() >= deadline) {
+            return false;
+        }
+        cv.wait_for(lock, std::chrono::microseconds(VIRTUAL_CLOCK_POLL_US));
+    }
+    return true;
+}
+
+// ========== 任务 ==========
+
+struct native_task {
+    const char *name;
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t notify_count;
+};
+
+static thread_local native_task *current_task = NULL;
+
+// 不是由 xTaskCreate() 创建的线程 (主线程) 在第一次用到时补一个任务对象
+static native_task *this_task(void) {
+    if (current_task == NULL) {
+        current_task = new native_task();
+        current_task->name = "loopTask";
+        current_task->notify_count = 0;
+    }
+    return current_task;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stack_depth,
+                       void *parameter, UBaseType_t priority, TaskHandle_t *created) {
+    (void)stack_depth;
+    (void)priority;
+    native_task *handle = new native_task();
+    handle->name = name;
+    handle->notify_count = 0;
+    if (created != NULL) {
+        *created = handle;
+    }
+    std::thread([task, parameter, handle]() {
+        current_task = handle;
+        task(parameter);
+    }).detach();
+    return pdPASS;
+}
+
+void vPortYield(void) {
+    std::this_thread::yield();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return this_task();
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(NativeHost_TimeUs() / (1000000 / configTICK_RATE_HZ));
+}
+
+void vTaskDelay(TickType_t ticks) {
+    NativeHost_SleepUs((int64_t)ticks * portTICK_PERIOD_MS * 1000);
+}
+
+void vTaskDelayUntil(TickType_t *previous_wake, TickType_t period) {
+    TickType_t wake = *previous_wake + period;
+    int32_t remaining = (int32_t)(wake - xTaskGetTickCount());
+    if (remaining > 0) {
+        vTaskDelay((TickType_t)remaining);
+    }
+    *previous_wake = wake;
+}
+
+uint32_t ulTaskGetIdleRunTimeCounter(void) {
+    return 0;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+    native_task *task = this_task();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    if (!wait_ticks(task->cv, lock, ticks_to_wait, [task]() { return task->notify_count > 0; })) {
+        return 0;
+    }
+    uint32_t count = task->notify_count;
+    task->notify_count = clear_on_exit ? 0 : count - 1;
+    return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notify_count++;
+    }
+    task->cv.notify_one();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_woken) {
+    xTaskNotifyGive(task);
+    if (higher_priority_woken != NULL) {
+        *higher_priority_woken = pdTRUE;
+    }
+}
+
+// ========== 队列 ==========
+
+struct native_queue {
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<std::vector<uint8_t>> items;
+    size_t length;
+    size_t item_size;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    native_queue *queue = new native_queue();
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait) {
+    {
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        if (!wait_ticks(queue->not_full, lock, ticks_to_wait,
+                [queue]() { return queue->items.size() < queue->length; })) {
+            return pdFALSE;
+        }
+        const uint8_t *bytes = (const uint8_t *)item;
+        queue->items.emplace_back(bytes, bytes + queue->item_size);
+    }
+    queue->not_empty.notify_one();
+    return pdTRUE;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_woken) {
+    BaseType_t sent = xQueueSend(queue, item, 0);
+    if (sent == pdTRUE && higher_priority_woken != NULL) {
+        *higher_priority_woken = pdTRUE;
+    }
+    return sent;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks_to_wait) {
+    {
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        if (!wait_ticks(queue->not_empty, lock, ticks_to_wait,
+                [queue]() { return !queue->items.empty(); })) {
+            return pdFALSE;
+        }
+        memcpy(item, queue->items.front().data(), queue->item_size);
+        queue->items.pop_front();
+    }
+    queue->not_full.notify_one();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return (UBaseType_t)queue->items.size();
+}
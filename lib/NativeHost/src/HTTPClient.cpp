@@ -0,0 +1,188 @@
+#include <HTTPClient.h>
+#include <strings.h>
+
+// 只支持 http://host[:port][/path]
+static bool parse_url(const char *url, std::string *host, uint16_t *port, std::string *path) {
+    static const char SCHEME[] = "http://";
+    if (strncmp(url, SCHEME, sizeof(SCHEME) - 1) != 0) {
+        return false;
+    }
+    const char *authority = url + sizeof(SCHEME) - 1;
+    const char *slash = strchr(authority, '/');
+    std::string hostport = slash ? std::string(authority, slash - authority) : std::string(authority);
+    *path = slash ? slash : "/";
+    size_t colon = hostport.rfind(':');
+    if (colon == std::string::npos) {
+        *host = hostport;
+        *port = 80;
+    } else {
+        *host = hostport.substr(0, colon);
+        *port = (uint16_t)atoi(hostport.c_str() + colon + 1);
+    }
+    return !host->empty() && *port != 0;
+}
+
+bool HTTPClient::begin(WiFiClient &c, const String &url) {
+    std::string next_host;
+    uint16_t next_port;
+    if (!parse_url(url.c_str(), &next_host, &next_port, &path)) {
+        return false;
+    }
+    // 换了服务器就不能复用原来的连接
+    if (c.remoteHost() != next_host || c.remotePort() != next_port) {
+        c.stop();
+    }
+    client = &c;
+    host = next_host;
+    port = next_port;
+    headers.clear();
+    body.clear();
+    return true;
+}
+
+void HTTPClient::end(void) {
+    if (client != NULL && (!reuse || !server_keep_alive)) {
+        client->stop();
+    }
+    headers.clear();
+}
+
+void HTTPClient::addHeader(const String &name, const String &value) {
+    headers += name.c_str();
+    headers += ": ";
+    headers += value.c_str();
+    headers += "\r\n";
+}
+
+int HTTPClient::POST(const String &payload) {
+    return POST((uint8_t *)payload.c_str(), payload.length());
+}
+
+int HTTPClient::POST(uint8_t *payload, size_t size) {
+    if (client == NULL) {
+        return HTTPC_ERROR_NOT_CONNECTED;
+    }
+    if (!client->connected()) {
+        if (!client->connect(host.c_str(), port, connect_timeout_ms)) {
+            return HTTPC_ERROR_CONNECTION_REFUSED;
+        }
+    }
+    client->setTimeout(io_timeout_ms);
+
+    std::string request = "POST " + path + " HTTP/1.1\r\n";
+    request += "Host: " + host + ":" + std::to_string(port) + "\r\n";
+    request += "User-Agent: ESP32HTTPClient\r\n";
+    request += reuse ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    request += "Content-Length: " + std::to_string(size) + "\r\n";
+    request += headers;
+    request += "\r\n";
+    if (client->write((const uint8_t *)request.data(), request.size()) != request.size()) {
+        client->stop();
+        return HTTPC_ERROR_SEND_HEADER_FAILED;
+    }
+    if (size > 0 && client->write(payload, size) != size) {
+        client->stop();
+        return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+    }
+
+    int code;
+    if (!read_response(&code)) {
+        client->stop();
+        return code;
+    }
+    return code;
+}
+
+// 读取状态行, 头部和响应体; 失败时 *code 为错误码
+bool HTTPClient::read_response(int *code) {
+    std::string line;
+    if (!client->readLine(line)) {
+        *code = HTTPC_ERROR_READ_TIMEOUT;
+        return false;
+    }
+    int status = 0;
+    if (sscanf(line.c_str(), "HTTP/%*d.%*d %d", &status) != 1 || status <= 0) {
+        *code = HTTPC_ERROR_NO_HTTP_SERVER;
+        return false;
+    }
+
+    long content_length = -1;
+    bool chunked = false;
+    server_keep_alive = line.compare(0, 8, "HTTP/1.0") != 0;
+    while (client->readLine(line) && !line.empty()) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = line.substr(0, colon);
+        const char *value = line.c_str() + colon + 1;
+        while (*value == ' ') {
+            value++;
+        }
+        if (strcasecmp(name.c_str(), "Content-Length") == 0) {
+            content_length = atol(value);
+        } else if (strcasecmp(name.c_str(), "Transfer-Encoding") == 0) {
+            chunked = strcasecmp(value, "chunked") == 0;
+        } else if (strcasecmp(name.c_str(), "Connection") == 0) {
+            server_keep_alive = strcasecmp(value, "close") != 0;
+        }
+    }
+
+    body.clear();
+    if (chunked) {
+        for (;;) {
+            if (!client->readLine(line)) {
+                *code = HTTPC_ERROR_CONNECTION_LOST;
+                return false;
+            }
+            size_t chunk = strtoul(line.c_str(), NULL, 16);
+            if (chunk == 0) {
+                client->readLine(line); // 结尾的空行
+                break;
+            }
+            size_t offset = body.size();
+            body.resize(offset + chunk);
+            if (client->readBytes((uint8_t *)&body[offset], chunk) != chunk || !client->readLine(line)) {
+                *code = HTTPC_ERROR_CONNECTION_LOST;
+                return false;
+            }
+        }
+    } else if (content_length > 0) {
+        body.resize((size_t)content_length);
+        if (client->readBytes((uint8_t *)&body[0], body.size()) != body.size()) {
+            *code = HTTPC_ERROR_CONNECTION_LOST;
+            return false;
+        }
+    } else if (content_length < 0) {
+        // 没有长度, 响应体到连接关闭为止, 连接不能复用
+        uint8_t buf[256];
+        size_t n;
+        while ((n = client->readBytes(buf, sizeof(buf))) > 0) {
+            body.append((const char *)buf, n);
+        }
+        server_keep_alive = false;
+    }
+    *code = status;
+    return true;
+}
+
+String HTTPClient::getString(void) {
+    return String(body);
+}
+
+int HTTPClient::writeToStream(Print *stream) {
+    return (int)stream->write((const uint8_t *)body.data(), body.size());
+}
+
+String HTTPClient::errorToString(int error) {
+    switch (error) {
+        case HTTPC_ERROR_CONNECTION_REFUSED:  return String("connection refused");
+        case HTTPC_ERROR_SEND_HEADER_FAILED:  return String("send header failed");
+        case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return String("send payload failed");
+        case HTTPC_ERROR_NOT_CONNECTED:       return String("not connected");
+        case HTTPC_ERROR_CONNECTION_LOST:     return String("connection lost");
+        case HTTPC_ERROR_NO_HTTP_SERVER:      return String("no HTTP server");
+        case HTTPC_ERROR_READ_TIMEOUT:        return String("read Timeout");
+        default:                              return String();
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef NATIVE_HOST_HTTPCLIENT_H
+#define NATIVE_HOST_HTTPCLIENT_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+/**
+ * @brief HTTPClient 的宿主替身, 只实现上报用到的 POST. 请求真实发出,
+ * 连接的复用规则与 Arduino-ESP32 相同: setReuse(true) 且服务器没有要求关闭时,
+ * end() 保留连接, 下一次 begin() 同一主机时直接复用.
+ * 响应体在 POST() 中一次读完.
+ */
+
+#define HTTPC_ERROR_CONNECTION_REFUSED  (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED  (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED       (-4)
+#define HTTPC_ERROR_CONNECTION_LOST     (-5)
+#define HTTPC_ERROR_NO_HTTP_SERVER      (-7)
+#define HTTPC_ERROR_READ_TIMEOUT        (-11)
+
+class HTTPClient {
+public:
+    bool begin(WiFiClient &client, const String &url);
+    void end(void);
+
+    void setReuse(bool reuse) { this->reuse = reuse; }
+    void setConnectTimeout(int32_t timeout_ms) { connect_timeout_ms = timeout_ms; }
+    void setTimeout(uint16_t timeout_ms) { io_timeout_ms = timeout_ms; }
+    void addHeader(const String &name, const String &value);
+
+    int POST(uint8_t *payload, size_t size);
+    int POST(const String &payload);
+
+    String getString(void);
+    int writeToStream(Print *stream);
+    static String errorToString(int error);
+
+private:
+    bool read_response(int *code);
+
+    WiFiClient *client = NULL;
+    std::string host;
+    uint16_t port = 80;
+    std::string path;
+    std::string headers;
+    std::string body;
+    bool reuse = true;
+    bool server_keep_alive = true;
+    int32_t connect_timeout_ms = 5000;
+    uint16_t io_timeout_ms = 5000;
+};
+
+#endif // NATIVE_HOST_HTTPCLIENT_H
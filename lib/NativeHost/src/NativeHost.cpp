@@ -0,0 +1,209 @@
+#include "NativeHost.h"
+#include <Arduino.h>
+#include "driver/gpio.h"
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+extern "C" int __real_gettimeofday(struct timeval *tv, void *tz);
+
+// ========== 时间 ==========
+
+static const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+// 虚拟时钟: 开启后时间只由拥有时钟的线程推进
+static std::atomic<bool> clock_virtual(false);
+static std::atomic<int64_t> virtual_us(0);
+static int64_t virtual_wall_base_us = 0;   // 虚拟时间为 0 时的墙上时间
+static std::thread::id clock_owner;
+static std::mutex clock_mutex;
+static std::condition_variable clock_cv;
+
+// settimeofday() 只改本进程看到的墙上时间
+static std::atomic<int64_t> wall_offset_us(0);
+
+static int64_t real_time_us(void) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+}
+
+int64_t NativeHost_TimeUs(void) {
+    return clock_virtual ? virtual_us.load() : real_time_us();
+}
+
+void NativeHost_UseVirtualClock(int64_t start_us, int64_t wall_epoch_us) {
+    virtual_wall_base_us = wall_epoch_us - start_us;
+    virtual_us = start_us;
+    clock_owner = std::this_thread::get_id();
+    clock_virtual = true;
+}
+
+bool NativeHost_ClockIsVirtual(void) {
+    return clock_virtual;
+}
+
+bool NativeHost_OwnsClock(void) {
+    return clock_virtual && std::this_thread::get_id() == clock_owner;
+}
+
+void NativeHost_AdvanceUs(int64_t us) {
+    {
+        std::lock_guard<std::mutex> lock(clock_mutex);
+        virtual_us += us;
+    }
+    clock_cv.notify_all();
+}
+
+void NativeHost_SleepUs(int64_t us) {
+    if (us <= 0) {
+        return;
+    }
+    if (!clock_virtual) {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    } else if (NativeHost_OwnsClock()) {
+        NativeHost_AdvanceUs(us); // 拥有时钟的线程睡眠就是让时间前进
+    } else {
+        std::unique_lock<std::mutex> lock(clock_mutex);
+        int64_t deadline = virtual_us + us;
+        clock_cv.wait(lock, [deadline]() { return virtual_us >= deadline; });
+    }
+}
+
+// 墙上时间: 宿主的系统时间, 或虚拟时钟对应的时间, 加上固件 settimeofday() 的调整
+static int64_t wall_time_us(void) {
+    int64_t base;
+    if (clock_virtual) {
+        base = virtual_wall_base_us + virtual_us;
+    } else {
+        struct timeval tv;
+        __real_gettimeofday(&tv, NULL);
+        base = (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+    }
+    return base + wall_offset_us;
+}
+
+extern "C" int __wrap_gettimeofday(struct timeval *tv, void *tz) {
+    (void)tz;
+    if (tv != NULL) {
+        int64_t now = wall_time_us();
+        tv->tv_sec = (time_t)(now / 1000000);
+        tv->tv_usec = (suseconds_t)(now % 1000000);
+    }
+    return 0;
+}
+
+extern "C" int __wrap_settimeofday(const struct timeval *tv, const void *tz) {
+    (void)tz;
+    if (tv != NULL) {
+        int64_t target = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec;
+        wall_offset_us += target - wall_time_us();
+    }
+    return 0;
+}
+
+extern "C" time_t __wrap_time(time_t *out) {
+    time_t now = (time_t)(wall_time_us() / 1000000);
+    if (out != NULL) {
+        *out = now;
+    }
+    return now;
+}
+
+// ========== GPIO ==========
+
+#define NATIVE_PIN_COUNT 64
+
+typedef struct {
+    int level;
+    uint8_t mode;
+    bool driven;          // 电平由 NativeHost_SetPin() 给出, pinMode() 不再覆盖
+    void (*isr)(void);
+    int isr_mode;
+} native_pin_t;
+
+static native_pin_t pins[NATIVE_PIN_COUNT];
+static std::mutex pin_mutex;
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin >= NATIVE_PIN_COUNT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pin_mutex);
+    pins[pin].mode = mode;
+    if (!pins[pin].driven) {
+        pins[pin].level = (mode == INPUT_PULLUP) ? HIGH : LOW;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return NativeHost_GetPin(pin);
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+    if (pin >= NATIVE_PIN_COUNT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pin_mutex);
+    pins[pin].level = level ? HIGH : LOW;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) {
+    if (pin >= NATIVE_PIN_COUNT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pin_mutex);
+    pins[pin].isr = isr;
+    pins[pin].isr_mode = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+    attachInterrupt(pin, NULL, 0);
+}
+
+int gpio_get_level(gpio_num_t gpio_num) {
+    return NativeHost_GetPin((uint8_t)gpio_num);
+}
+
+void NativeHost_SetPin(uint8_t pin, int level) {
+    if (pin >= NATIVE_PIN_COUNT) {
+        return;
+    }
+    level = level ? HIGH : LOW;
+    void (*isr)(void) = NULL;
+    {
+        std::lock_guard<std::mutex> lock(pin_mutex);
+        native_pin_t *p = &pins[pin];
+        bool changed = p->level != level;
+        p->level = level;
+        p->driven = true;
+        if (changed && p->isr != NULL &&
+            (p->isr_mode == CHANGE ||
+             (p->isr_mode == RISING && level == HIGH) ||
+             (p->isr_mode == FALLING && level == LOW))) {
+            isr = p->isr;
+        }
+    }
+    // 电平先生效再进 ISR, 与硬件一致: ISR 中读到的是新电平
+    if (isr != NULL) {
+        isr();
+    }
+}
+
+int NativeHost_GetPin(uint8_t pin) {
+    if (pin >= NATIVE_PIN_COUNT) {
+        return LOW;
+    }
+    std::lock_guard<std::mutex> lock(pin_mutex);
+    return pins[pin].level;
+}
+
+// ========== 进程 ==========
+
+void NativeHost_Exit(int code) {
+    fflush(stdout);
+    fflush(stderr);
+    _exit(code);
+}
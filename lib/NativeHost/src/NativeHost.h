@@ -0,0 +1,60 @@
+#ifndef NATIVE_HOST_H
+#define NATIVE_HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief [env:native] 的宿主控制接口. 固件代码不包含这个头文件,
+ * 只有宿主入口 (NativeMain.cpp) 和以后的测试/基准用它来驱动模拟的外设.
+ *
+ * 所有时间都来自 NativeHost_TimeUs(): millis(), micros(), esp_timer_get_time(),
+ * xTaskGetTickCount() 和 LVGL 的时基都由它换算, 起点为进程启动.
+ * 墙上时间 (time(), gettimeofday(), settimeofday()) 通过链接选项
+ * -Wl,--wrap 接到这里, settimeofday() 不会改动宿主的系统时间.
+ */
+
+// --- 时间 ---
+int64_t NativeHost_TimeUs(void);
+// 真实时钟下睡眠; 虚拟时钟下, 拥有时钟的线程睡眠即推进时间, 其他线程等到时间被推进到期
+void NativeHost_SleepUs(int64_t us);
+
+/**
+ * @brief 切换到虚拟时钟, 调用线程成为时钟的拥有者, 之后时间只由它推进
+ * (NativeHost_AdvanceUs() 或它自己的睡眠/超时等待). 用于可重复的回放和测试:
+ * 渲染和计算不占用虚拟时间, 结果与宿主的速度无关.
+ * 应在程序开始时调用, 之前读到的时间不保证单调.
+ * @param start_us      切换后 NativeHost_TimeUs() 的值
+ * @param wall_epoch_us 切换时的墙上时间 (Unix 时间, 微秒)
+ */
+void NativeHost_UseVirtualClock(int64_t start_us, int64_t wall_epoch_us);
+void NativeHost_AdvanceUs(int64_t us);
+bool NativeHost_ClockIsVirtual(void);
+// 当前线程是否拥有虚拟时钟
+bool NativeHost_OwnsClock(void);
+
+// --- GPIO ---
+// 由外部驱动一个输入引脚, 电平变化时按 attachInterrupt() 的触发方式调用 ISR
+void NativeHost_SetPin(uint8_t pin, int level);
+// 引脚当前电平 (输入为外部驱动的电平, 输出为固件写入的电平)
+int NativeHost_GetPin(uint8_t pin);
+
+// --- 传感器 ---
+// 模拟的 SHT20 (0x40) 和 LM75 (0x48) 测到的环境; temperatureRead() 在此基础上加芯片温升
+void NativeHost_SetClimate(float temp_c, float humi_rh);
+// 让某个 I2C 地址不应答, 用于模拟传感器掉线
+void NativeHost_SetI2CPresent(uint8_t addr, bool present);
+
+// --- 网络 ---
+// 模拟 AP 是否可达. 不可达时 WiFi.status() 保持断开; 恢复后按上次的凭据重连
+void NativeHost_SetWiFiAvailable(bool available);
+// 模拟 AP 换到另一个信道 (默认 6), 之后按旧信道直接关联会失败
+void NativeHost_SetWiFiChannel(uint8_t channel);
+
+/**
+ * @brief 刷新输出后直接结束进程. 固件的任务是不会返回的后台线程,
+ * 正常 exit() 会在它们仍在运行时析构全局对象.
+ */
+void NativeHost_Exit(int code) __attribute__((noreturn));
+
+#endif // NATIVE_HOST_H
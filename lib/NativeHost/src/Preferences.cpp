@@ -0,0 +1,158 @@
+#include <Preferences.h>
+#include "nvs_flash.h"
+#include <map>
+#include <mutex>
+#include <vector>
+
+typedef std::map<std::string, std::vector<uint8_t>> nvs_namespace_t;
+
+static std::map<std::string, nvs_namespace_t> nvs;
+static std::mutex nvs_mutex;
+
+esp_err_t nvs_flash_init(void) {
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void) {
+    std::lock_guard<std::mutex> lock(nvs_mutex);
+    nvs.clear();
+    return ESP_OK;
+}
+
+bool Preferences::begin(const char *ns, bool ro) {
+    if (opened || ns == NULL || strlen(ns) > 15) {
+        return false; // NVS 命名空间最长 15 个字符
+    }
+    name = ns;
+    read_only = ro;
+    opened = true;
+    return true;
+}
+
+void Preferences::end(void) {
+    opened = false;
+}
+
+bool Preferences::clear(void) {
+    if (!opened || read_only) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(nvs_mutex);
+    nvs[name].clear();
+    return true;
+}
+
+bool Preferences::remove(const char *key) {
+    if (!opened || read_only) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(nvs_mutex);
+    return nvs[name].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+    return getBytesLength(key) > 0;
+}
+
+size_t Preferences::put(const char *key, const void *value, size_t len) {
+    if (!opened || read_only || key == NULL) {
+        return 0;
+    }
+    const uint8_t *bytes = (const uint8_t *)value;
+    std::lock_guard<std::mutex> lock(nvs_mutex);
+    nvs[name][key].assign(bytes, bytes + len);
+    return len;
+}
+
+bool Preferences::get(const char *key, void *value, size_t len) {
+    if (!opened || key == NULL) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(nvs_mutex);
+    const nvs_namespace_t &entries = nvs[name];
+    nvs_namespace_t::const_iterator it = entries.find(key);
+    if (it == entries.end() || it->second.size() != len) {
+        return false; // 不存在或类型不符, 与 NVS 一样返回默认值
+    }
+    memcpy(value, it->second.data(), len);
+    return true;
+}
+
+size_t Preferences::putBool(const char *key, bool value) {
+    return putUChar(key, value ? 1 : 0);
+}
+
+size_t Preferences::putUChar(const char *key, uint8_t value) {
+    return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putUShort(const char *key, uint16_t value) {
+    return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value) {
+    return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putString(const char *key, const char *value) {
+    // 连同结尾的 '\0' 一起保存, 与 NVS 的字符串条目一致
+    return value ? put(key, value, strlen(value) + 1) : 0;
+}
+
+size_t Preferences::putString(const char *key, const String &value) {
+    return putString(key, value.c_str());
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len) {
+    return put(key, value, len);
+}
+
+bool Preferences::getBool(const char *key, bool default_value) {
+    return getUChar(key, default_value ? 1 : 0) != 0;
+}
+
+uint8_t Preferences::getUChar(const char *key, uint8_t default_value) {
+    uint8_t value;
+    return get(key, &value, sizeof(value)) ? value : default_value;
+}
+
+uint16_t Preferences::getUShort(const char *key, uint16_t default_value) {
+    uint16_t value;
+    return get(key, &value, sizeof(value)) ? value : default_value;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t default_value) {
+    uint32_t value;
+    return get(key, &value, sizeof(value)) ? value : default_value;
+}
+
+String Preferences::getString(const char *key, const String &default_value) {
+    size_t len = getBytesLength(key);
+    if (len == 0) {
+        return default_value;
+    }
+    std::string value(len, '\0');
+    if (!get(key, &value[0], len)) {
+        return default_value;
+    }
+    value.resize(strlen(value.c_str()));
+    return String(value);
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+    if (!opened || key == NULL) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(nvs_mutex);
+    const nvs_namespace_t &entries = nvs[name];
+    nvs_namespace_t::const_iterator it = entries.find(key);
+    return it == entries.end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t max_len) {
+    size_t len = getBytesLength(key);
+    if (len == 0 || len > max_len || !get(key, buf, len)) {
+        return 0;
+    }
+    return len;
+}
@@ -0,0 +1,44 @@
+#ifndef NATIVE_HOST_PREFERENCES_H
+#define NATIVE_HOST_PREFERENCES_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Preferences 的宿主替身. 所有命名空间保存在进程内的一张表里,
+ * 不落盘, 每次运行都从空的 NVS 开始; 需要的初始状态由宿主入口写入.
+ */
+class Preferences {
+public:
+    bool begin(const char *name, bool read_only = false);
+    void end(void);
+
+    bool clear(void);
+    bool remove(const char *key);
+    bool isKey(const char *key);
+
+    size_t putBool(const char *key, bool value);
+    size_t putUChar(const char *key, uint8_t value);
+    size_t putUShort(const char *key, uint16_t value);
+    size_t putUInt(const char *key, uint32_t value);
+    size_t putString(const char *key, const char *value);
+    size_t putString(const char *key, const String &value);
+    size_t putBytes(const char *key, const void *value, size_t len);
+
+    bool getBool(const char *key, bool default_value = false);
+    uint8_t getUChar(const char *key, uint8_t default_value = 0);
+    uint16_t getUShort(const char *key, uint16_t default_value = 0);
+    uint32_t getUInt(const char *key, uint32_t default_value = 0);
+    String getString(const char *key, const String &default_value = String());
+    size_t getBytesLength(const char *key);
+    size_t getBytes(const char *key, void *buf, size_t max_len);
+
+private:
+    size_t put(const char *key, const void *value, size_t len);
+    bool get(const char *key, void *value, size_t len);
+
+    std::string name;
+    bool opened = false;
+    bool read_only = false;
+};
+
+#endif // NATIVE_HOST_PREFERENCES_H
@@ -0,0 +1,110 @@
+#ifndef NATIVE_HOST_WEBSERVER_H
+#define NATIVE_HOST_WEBSERVER_H
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief 配网 Web 服务器的宿主替身. 只记录注册的路由, 不监听端口;
+ * handleClient() 什么也不做. 宿主入口可以用 dispatch() 模拟一次请求.
+ */
+
+typedef enum {
+    HTTP_ANY,
+    HTTP_GET,
+    HTTP_POST,
+} HTTPMethod;
+
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit WebServer(int port = 80) : port(port) {}
+
+    void begin(void) { running = true; }
+    void stop(void) { running = false; }
+    void handleClient(void) {}
+
+    void on(const String &uri, HTTPMethod method, THandlerFunction handler) {
+        routes.push_back(route_t{ uri, method, handler });
+    }
+    void onNotFound(THandlerFunction handler) { not_found = handler; }
+
+    void send(int code, const char *content_type = NULL, const String &content = String()) {
+        (void)content_type;
+        last_code = code;
+        last_body = content;
+    }
+    void send_P(int code, const char *content_type, const char *content) {
+        send(code, content_type, String(content));
+    }
+    void sendHeader(const String &name, const String &value, bool first = false) {
+        (void)name;
+        (void)value;
+        (void)first;
+    }
+
+    String uri(void) { return current_uri; }
+    bool hasArg(const String &name) { return find_arg(name) != NULL; }
+    String arg(const String &name) {
+        const arg_t *a = find_arg(name);
+        return a ? a->value : String();
+    }
+
+    // 模拟一次请求, 返回处理函数给出的状态码; 服务器未启动时返回 0
+    int dispatch(HTTPMethod method, const String &request_uri,
+                 const std::vector<std::pair<String, String>> &request_args = {}) {
+        if (!running) {
+            return 0;
+        }
+        current_uri = request_uri;
+        args.clear();
+        for (size_t i = 0; i < request_args.size(); i++) {
+            args.push_back(arg_t{ request_args[i].first, request_args[i].second });
+        }
+        last_code = 0;
+        for (size_t i = 0; i < routes.size(); i++) {
+            if (routes[i].uri == request_uri && (routes[i].method == HTTP_ANY || routes[i].method == method)) {
+                routes[i].handler();
+                return last_code;
+            }
+        }
+        if (not_found) {
+            not_found();
+        }
+        return last_code;
+    }
+
+private:
+    typedef struct {
+        String uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    } route_t;
+
+    typedef struct {
+        String name;
+        String value;
+    } arg_t;
+
+    const arg_t *find_arg(const String &name) const {
+        for (size_t i = 0; i < args.size(); i++) {
+            if (args[i].name == name) {
+                return &args[i];
+            }
+        }
+        return NULL;
+    }
+
+    int port;
+    bool running = false;
+    std::vector<route_t> routes;
+    THandlerFunction not_found;
+    std::vector<arg_t> args;
+    String current_uri;
+    int last_code = 0;
+    String last_body;
+};
+
+#endif // NATIVE_HOST_WEBSERVER_H
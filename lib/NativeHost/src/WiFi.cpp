@@ -0,0 +1,411 @@
+#include <WiFi.h>
+#include "NativeHost.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+WiFiClass WiFi;
+
+// ========== IPAddress ==========
+
+String IPAddress::toString(void) const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+    return String(buf);
+}
+
+size_t IPAddress::printTo(Print &p) const {
+    return p.print(toString());
+}
+
+// ========== 模拟的 WiFi 连接 ==========
+
+#define HOST_STA_RSSI -55
+// 连接耗时: 假设的常数, 不是测量值. 只用来区分连接走了哪条路径 (扫描, DHCP),
+// 主机上得到的连接耗时就是这几个常数之和, 不代表板上的实际耗时
+#define HOST_SCAN_MS  2000  // 全信道主动扫描
+#define HOST_JOIN_MS  150   // 认证, 关联和四次握手
+#define HOST_DHCP_MS  600
+
+static const uint8_t HOST_AP_BSSID[6] = { 0x02, 0x00, 0x00, 0xA9, 0x31, 0x01 };
+
+static std::mutex wifi_mutex;
+static std::string sta_ssid;      // 最近一次 begin() 的凭据, 断开后用于重连
+static bool ap_available = true;
+static uint8_t ap_channel = 6;
+static wl_status_t sta_status = WL_IDLE_STATUS;
+static int64_t connect_at_us = -1; // 正在连接时连上的时间, 否则为 -1
+static bool connect_fails = false; // 正在进行的直接关联找不到 AP
+static bool sta_static = false;
+static IPAddress static_ip, static_gateway, static_subnet, static_dns;
+static std::vector<WiFiEventFuncCb> event_handlers;
+
+void NativeHost_SetWiFiAvailable(bool available) {
+    WiFi.setAvailable(available);
+}
+
+void NativeHost_SetWiFiChannel(uint8_t channel) {
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    ap_channel = channel;
+}
+
+void WiFiClass::dispatch(WiFiEvent_t event) {
+    std::vector<WiFiEventFuncCb> handlers;
+    {
+        std::lock_guard<std::mutex> lock(wifi_mutex);
+        handlers = event_handlers;
+    }
+    WiFiEventInfo_t info = {};
+    for (size_t i = 0; i < handlers.size(); i++) {
+        handlers[i](event, info);
+    }
+}
+
+// 连接到期时完成. 由查询状态的线程和每次连接的定时线程调用, 先到的一方完成,
+// 因此虚拟时钟下状态总是在同一时刻变化
+void WiFiClass::poll_connect(void) {
+    bool connected;
+    {
+        std::lock_guard<std::mutex> lock(wifi_mutex);
+        if (connect_at_us < 0 || NativeHost_TimeUs() < connect_at_us) {
+            return;
+        }
+        connect_at_us = -1;
+        connected = ap_available && !connect_fails;
+        sta_status = connected ? WL_CONNECTED : WL_NO_SSID_AVAIL;
+    }
+    if (connected) {
+        dispatch(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+        dispatch(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    }
+}
+
+void WiFiClass::connect(int32_t channel, const uint8_t *bssid) {
+    int64_t delay_us;
+    {
+        std::lock_guard<std::mutex> lock(wifi_mutex);
+        if (sta_ssid.empty()) {
+            sta_status = WL_DISCONNECTED;
+            return;
+        }
+        if (!ap_available) {
+            sta_status = WL_NO_SSID_AVAIL;
+            return;
+        }
+        if (sta_status == WL_CONNECTED) {
+            return;
+        }
+        // 给出信道和 BSSID 时只在这个信道上找这个 AP
+        bool direct = channel > 0 && bssid != NULL;
+        connect_fails = direct && (channel != ap_channel || memcmp(bssid, HOST_AP_BSSID, 6) != 0);
+        delay_us = (int64_t)((direct ? 0 : HOST_SCAN_MS) + HOST_JOIN_MS) * 1000;
+        if (!connect_fails && !sta_static) {
+            delay_us += HOST_DHCP_MS * 1000;
+        }
+        sta_status = WL_DISCONNECTED;
+        connect_at_us = NativeHost_TimeUs() + delay_us; // 重新 begin() 时取代正在进行的连接
+    }
+    // 没有人查询状态时也要按时连上并派发事件 (例如配网页面只等 GOT_IP 事件).
+    // 被取代的连接的线程醒来时还没到新的时间, 什么也不做
+    std::thread([this, delay_us]() {
+        NativeHost_SleepUs(delay_us);
+        poll_connect();
+    }).detach();
+}
+
+void WiFiClass::setAvailable(bool available) {
+    bool lost;
+    {
+        std::lock_guard<std::mutex> lock(wifi_mutex);
+        ap_available = available;
+        lost = !available && sta_status == WL_CONNECTED;
+        if (lost) {
+            sta_status = WL_CONNECTION_LOST;
+        }
+    }
+    if (lost) {
+        dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    } else if (available) {
+        connect(0, NULL); // 与板上的自动重连一致
+    }
+}
+
+wl_status_t WiFiClass::begin(void) {
+    connect(0, NULL);
+    return status();
+}
+
+wl_status_t WiFiClass::begin(const char *ssid, const char *passphrase, int32_t channel,
+                             const uint8_t *bssid, bool connect_now) {
+    (void)passphrase;
+    std::string next = ssid ? ssid : "";
+    {
+        std::lock_guard<std::mutex> lock(wifi_mutex);
+        if (sta_ssid != next) {
+            sta_status = WL_DISCONNECTED;
+            connect_at_us = -1;
+        }
+        sta_ssid = next;
+    }
+    if (connect_now) {
+        connect(channel, bssid);
+    }
+    return status();
+}
+
+bool WiFiClass::config(IPAddress local_ip, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2) {
+    (void)dns2;
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    sta_static = (uint32_t)local_ip != 0;
+    static_ip = local_ip;
+    static_gateway = gateway;
+    static_subnet = subnet;
+    static_dns = (uint32_t)dns1 != 0 ? dns1 : gateway;
+    return true;
+}
+
+bool WiFiClass::disconnect(void) {
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    sta_status = WL_DISCONNECTED;
+    connect_at_us = -1;
+    return true;
+}
+
+wl_status_t WiFiClass::status(void) {
+    poll_connect();
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    return sta_status;
+}
+
+bool WiFiClass::mode(wifi_mode_t mode) {
+    (void)mode;
+    return true;
+}
+
+bool WiFiClass::setHostname(const char *hostname) {
+    (void)hostname;
+    return true;
+}
+
+String WiFiClass::SSID(void) {
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    return String(sta_status == WL_CONNECTED ? sta_ssid : std::string());
+}
+
+int8_t WiFiClass::RSSI(void) {
+    return status() == WL_CONNECTED ? HOST_STA_RSSI : 0;
+}
+
+IPAddress WiFiClass::localIP(void) {
+    if (status() != WL_CONNECTED) {
+        return IPAddress();
+    }
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    return sta_static ? static_ip : IPAddress(192, 168, 31, 50); // DHCP 总是分到同一个地址
+}
+
+IPAddress WiFiClass::gatewayIP(void) {
+    if (status() != WL_CONNECTED) {
+        return IPAddress();
+    }
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    return sta_static ? static_gateway : IPAddress(192, 168, 31, 1);
+}
+
+IPAddress WiFiClass::subnetMask(void) {
+    if (status() != WL_CONNECTED) {
+        return IPAddress();
+    }
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    return sta_static ? static_subnet : IPAddress(255, 255, 255, 0);
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t dns_no) {
+    if (status() != WL_CONNECTED || dns_no != 0) {
+        return IPAddress();
+    }
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    return sta_static ? static_dns : IPAddress(192, 168, 31, 1);
+}
+
+uint8_t *WiFiClass::BSSID(uint8_t *bssid) {
+    static uint8_t current[6];
+    if (status() != WL_CONNECTED) {
+        return NULL;
+    }
+    uint8_t *out = bssid != NULL ? bssid : current;
+    memcpy(out, HOST_AP_BSSID, sizeof(HOST_AP_BSSID));
+    return out;
+}
+
+int32_t WiFiClass::channel(void) {
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    return ap_channel;
+}
+
+uint8_t *WiFiClass::macAddress(uint8_t *mac) {
+    static const uint8_t HOST_MAC[6] = { 0x02, 0x00, 0x00, 0xC3, 0x5A, 0x17 }; // 本地管理地址
+    memcpy(mac, HOST_MAC, sizeof(HOST_MAC));
+    return mac;
+}
+
+bool WiFiClass::softAP(const char *ssid, const char *passphrase) {
+    (void)ssid;
+    (void)passphrase;
+    return true;
+}
+
+bool WiFiClass::softAPdisconnect(bool wifioff) {
+    (void)wifioff;
+    return true;
+}
+
+IPAddress WiFiClass::softAPIP(void) {
+    return IPAddress(192, 168, 4, 1);
+}
+
+void WiFiClass::onEvent(WiFiEventFuncCb callback) {
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    event_handlers.push_back(callback);
+}
+
+// ========== WiFiClient ==========
+
+// 非阻塞 connect 加 poll, 实现建连超时
+static int connect_with_timeout(const struct addrinfo *addr, int32_t timeout_ms) {
+    int fd = socket(addr->ai_family, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    int rc = ::connect(fd, addr->ai_addr, addr->ai_addrlen);
+    if (rc < 0 && errno == EINPROGRESS) {
+        struct pollfd pfd = { fd, POLLOUT, 0 };
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (poll(&pfd, 1, timeout_ms) == 1 &&
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) == 0 && err == 0) {
+            rc = 0;
+        }
+    }
+    if (rc < 0) {
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, flags);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+int WiFiClient::connect(const char *remote_host, uint16_t remote_port, int32_t connect_timeout_ms) {
+    stop();
+    struct addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *result = NULL;
+    char port_str[8];
+    snprintf(port_str, sizeof(port_str), "%u", remote_port);
+    if (getaddrinfo(remote_host, port_str, &hints, &result) != 0) {
+        return 0;
+    }
+    for (struct addrinfo *addr = result; addr != NULL && fd < 0; addr = addr->ai_next) {
+        fd = connect_with_timeout(addr, connect_timeout_ms);
+    }
+    freeaddrinfo(result);
+    if (fd < 0) {
+        return 0;
+    }
+    host = remote_host;
+    port = remote_port;
+    setTimeout(timeout_ms);
+    return 1;
+}
+
+bool WiFiClient::connected(void) {
+    if (fd < 0) {
+        return false;
+    }
+    if (!rx.empty()) {
+        return true;
+    }
+    char c;
+    ssize_t n = recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void WiFiClient::stop(void) {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    rx.clear();
+}
+
+void WiFiClient::setTimeout(uint32_t ms) {
+    timeout_ms = ms;
+    if (fd >= 0) {
+        struct timeval tv = { (time_t)(ms / 1000), (suseconds_t)((ms % 1000) * 1000) };
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    }
+}
+
+size_t WiFiClient::write(const uint8_t *buf, size_t size) {
+    size_t sent = 0;
+    while (fd >= 0 && sent < size) {
+        ssize_t n = send(fd, buf + sent, size - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            break;
+        }
+        sent += (size_t)n;
+    }
+    return sent;
+}
+
+bool WiFiClient::fill(void) {
+    if (fd < 0) {
+        return false;
+    }
+    char buf[1024];
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n <= 0) {
+        return false; // 关闭, 出错或超时
+    }
+    rx.append(buf, (size_t)n);
+    return true;
+}
+
+size_t WiFiClient::readBytes(uint8_t *buf, size_t size) {
+    while (rx.size() < size && fill()) {
+    }
+    size_t n = rx.size() < size ? rx.size() : size;
+    memcpy(buf, rx.data(), n);
+    rx.erase(0, n);
+    return n;
+}
+
+bool WiFiClient::readLine(std::string &line) {
+    size_t end;
+    while ((end = rx.find("\r\n")) == std::string::npos) {
+        if (!fill()) {
+            return false;
+        }
+    }
+    line.assign(rx, 0, end);
+    rx.erase(0, end + 2);
+    return true;
+}
@@ -0,0 +1,135 @@
+#ifndef NATIVE_HOST_WIFI_H
+#define NATIVE_HOST_WIFI_H
+
+#include <Arduino.h>
+#include <functional>
+
+/**
+ * @brief WiFi 的宿主替身. 连接是模拟的: 只有一个 AP (固定的 BSSID, 信道见
+ * NativeHost_SetWiFiChannel()), begin() 之后经过几段假设的延时连上: 全信道扫描,
+ * 或者给出信道和 BSSID 时直接关联, 再加上 DHCP (config() 设置了固定地址时跳过).
+ * 延时只用来区分连接走了哪条路径, 不是板上的耗时 (见 WiFi.cpp).
+ * 连上时派发 ARDUINO_EVENT_WIFI_STA_GOT_IP. 时间来自 NativeHost, 虚拟时钟下同样适用.
+ * 宿主本身的网络始终可用, WiFiClient 是真实的 TCP 套接字.
+ */
+
+typedef enum {
+    WL_IDLE_STATUS     = 0,
+    WL_NO_SSID_AVAIL   = 1,
+    WL_CONNECTED       = 3,
+    WL_CONNECT_FAILED  = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED    = 6,
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF    = 0,
+    WIFI_STA    = 1,
+    WIFI_AP     = 2,
+    WIFI_AP_STA = 3,
+} wifi_mode_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_CONNECTED,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP,
+    ARDUINO_EVENT_WIFI_AP_STACONNECTED,
+    ARDUINO_EVENT_WIFI_AP_STADISCONNECTED,
+} arduino_event_id_t;
+
+typedef arduino_event_id_t WiFiEvent_t;
+
+typedef struct {
+    uint32_t reserved;
+} WiFiEventInfo_t;
+
+typedef std::function<void(WiFiEvent_t event, WiFiEventInfo_t info)> WiFiEventFuncCb;
+
+class IPAddress : public Printable {
+public:
+    IPAddress() : bytes{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+    // 与 Arduino 相同, uint32_t 形式按内存顺序 (第一个字节在最低位)
+    IPAddress(uint32_t address) { memcpy(bytes, &address, 4); }
+    operator uint32_t() const { uint32_t address; memcpy(&address, bytes, 4); return address; }
+
+    uint8_t operator[](int index) const { return bytes[index]; }
+    bool operator==(const IPAddress &other) const { return memcmp(bytes, other.bytes, 4) == 0; }
+    String toString(void) const;
+    size_t printTo(Print &p) const override;
+
+private:
+    uint8_t bytes[4];
+};
+
+class WiFiClass {
+public:
+    wl_status_t begin(void);
+    wl_status_t begin(const char *ssid, const char *passphrase = NULL, int32_t channel = 0,
+                      const uint8_t *bssid = NULL, bool connect = true);
+    // local_ip 为 0.0.0.0 时恢复 DHCP
+    bool config(IPAddress local_ip, IPAddress gateway, IPAddress subnet,
+                IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress());
+    bool disconnect(void);
+    wl_status_t status(void);
+    bool mode(wifi_mode_t mode);
+    bool setHostname(const char *hostname);
+
+    String SSID(void);
+    int8_t RSSI(void);
+    IPAddress localIP(void);
+    IPAddress gatewayIP(void);
+    IPAddress subnetMask(void);
+    IPAddress dnsIP(uint8_t dns_no = 0);
+    uint8_t *BSSID(uint8_t *bssid = NULL);
+    int32_t channel(void);
+    uint8_t *macAddress(uint8_t *mac);
+
+    bool softAP(const char *ssid, const char *passphrase = NULL);
+    bool softAPdisconnect(bool wifioff = false);
+    IPAddress softAPIP(void);
+
+    void onEvent(WiFiEventFuncCb callback);
+
+    // 由 NativeHost_SetWiFiAvailable() 调用
+    void setAvailable(bool available);
+
+private:
+    void connect(int32_t channel, const uint8_t *bssid);
+    void poll_connect(void);
+    void dispatch(WiFiEvent_t event);
+};
+
+extern WiFiClass WiFi;
+
+// 真实的 TCP 连接, 供 HTTPClient 使用
+class WiFiClient {
+public:
+    ~WiFiClient() { stop(); }
+
+    int connect(const char *host, uint16_t port, int32_t timeout_ms);
+    // 对端关闭或出错后返回 false, 不阻塞
+    bool connected(void);
+    void stop(void);
+    void setTimeout(uint32_t timeout_ms);
+
+    size_t write(const uint8_t *buf, size_t size);
+    // 读满 size 个字节或超时, 返回实际读到的字节数
+    size_t readBytes(uint8_t *buf, size_t size);
+    // 读一行 (去掉 "\r\n"), 超时或连接关闭返回 false
+    bool readLine(std::string &line);
+
+    const std::string &remoteHost(void) const { return host; }
+    uint16_t remotePort(void) const { return port; }
+
+private:
+    bool fill(void);
+
+    int fd = -1;
+    std::string rx;  // 已接收未读出的数据
+    std::string host;
+    uint16_t port = 0;
+    uint32_t timeout_ms = 5000;
+};
+
+#endif // NATIVE_HOST_WIFI_H
@@ -0,0 +1,226 @@
+#include <Wire.h>
+#include "NativeHost.h"
+#include <mutex>
+
+TwoWire Wire;
+
+#define SHT20_ADDR 0x40
+#define LM75_ADDR  0x48
+
+// 芯片内部温度比环境高的部分, 只用于 temperatureRead()
+#define CHIP_SELF_HEATING_C 15.0f
+
+static std::mutex climate_mutex;
+static float climate_temp_c = 23.5f;
+static float climate_humi_rh = 45.0f;
+static bool sht20_present = true;
+static bool lm75_present = true;
+
+void NativeHost_SetClimate(float temp_c, float humi_rh) {
+    std::lock_guard<std::mutex> lock(climate_mutex);
+    climate_temp_c = temp_c;
+    climate_humi_rh = humi_rh;
+}
+
+void NativeHost_SetI2CPresent(uint8_t addr, bool present) {
+    if (addr == SHT20_ADDR) {
+        sht20_present = present;
+    } else if (addr == LM75_ADDR) {
+        lm75_present = present;
+    }
+}
+
+static void read_climate(float *temp_c, float *humi_rh) {
+    std::lock_guard<std::mutex> lock(climate_mutex);
+    *temp_c = climate_temp_c;
+    *humi_rh = climate_humi_rh;
+}
+
+float temperatureRead(void) {
+    float temp_c, humi_rh;
+    read_climate(&temp_c, &humi_rh);
+    return temp_c + CHIP_SELF_HEATING_C;
+}
+
+// ========== 模拟的 SHT20 ==========
+
+#define SHT20_CMD_TEMP_NOHOLD 0xF3
+#define SHT20_CMD_HUMI_NOHOLD 0xF5
+#define SHT20_CMD_WRITE_USER  0xE6
+#define SHT20_CMD_READ_USER   0xE7
+#define SHT20_CMD_SOFT_RESET  0xFE
+
+typedef enum {
+    SIM_SHT20_IDLE,
+    SIM_SHT20_USER_REG,   // 下一次读取返回用户寄存器
+    SIM_SHT20_TEMP,
+    SIM_SHT20_HUMI,
+} sim_sht20_state_t;
+
+static sim_sht20_state_t sht20_state = SIM_SHT20_IDLE;
+static uint8_t sht20_user_reg = 0x02;  // 上电默认值: RH12/T14
+static int64_t sht20_ready_us = 0;     // 当前转换完成的时间
+
+// 典型转换时间 (datasheet, ms), 短于驱动按最大值等待的时间; 下标为用户寄存器的 bit7:bit0
+static const uint8_t SHT20_TEMP_MS[4] = { 66, 17, 33, 9 };
+static const uint8_t SHT20_HUMI_MS[4] = { 22, 3, 7, 12 };
+
+static int sht20_resolution_index(void) {
+    return ((sht20_user_reg >> 6) & 0x02) | (sht20_user_reg & 0x01);
+}
+
+static uint8_t sht20_crc8(const uint8_t *data, int len) {
+    uint8_t crc = 0;
+    for (int i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// 物理量换算成 datasheet 的 S 值, 低两位为状态位 (bit1: 0 温度, 1 湿度)
+static uint16_t sht20_raw(float value, float offset, float span, bool humidity) {
+    float s = (value + offset) * 65536.0f / span;
+    if (s < 0.0f) {
+        s = 0.0f;
+    } else if (s > 65532.0f) {
+        s = 65532.0f;
+    }
+    return (uint16_t)((uint16_t)s & 0xFFFC) | (humidity ? 0x02 : 0x00);
+}
+
+static bool sht20_write(const uint8_t *data, size_t len) {
+    if (len == 0) {
+        return true;
+    }
+    switch (data[0]) {
+        case SHT20_CMD_TEMP_NOHOLD:
+            sht20_state = SIM_SHT20_TEMP;
+            sht20_ready_us = NativeHost_TimeUs() + SHT20_TEMP_MS[sht20_resolution_index()] * 1000;
+            return true;
+        case SHT20_CMD_HUMI_NOHOLD:
+            sht20_state = SIM_SHT20_HUMI;
+            sht20_ready_us = NativeHost_TimeUs() + SHT20_HUMI_MS[sht20_resolution_index()] * 1000;
+            return true;
+        case SHT20_CMD_READ_USER:
+            sht20_state = SIM_SHT20_USER_REG;
+            return true;
+        case SHT20_CMD_WRITE_USER:
+            if (len >= 2) {
+                sht20_user_reg = data[1];
+            }
+            sht20_state = SIM_SHT20_IDLE;
+            return true;
+        case SHT20_CMD_SOFT_RESET:
+            sht20_user_reg = 0x02;
+            sht20_state = SIM_SHT20_IDLE;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static size_t sht20_read(uint8_t *buf, size_t len) {
+    if (sht20_state == SIM_SHT20_USER_REG) {
+        buf[0] = sht20_user_reg;
+        sht20_state = SIM_SHT20_IDLE;
+        return 1;
+    }
+    if (sht20_state == SIM_SHT20_IDLE || NativeHost_TimeUs() < sht20_ready_us) {
+        return 0; // 转换未完成时 NACK
+    }
+    float temp_c, humi_rh;
+    read_climate(&temp_c, &humi_rh);
+    uint16_t raw = (sht20_state == SIM_SHT20_TEMP)
+        ? sht20_raw(temp_c, 46.85f, 175.72f, false)
+        : sht20_raw(humi_rh, 6.0f, 125.0f, true);
+    sht20_state = SIM_SHT20_IDLE;
+    uint8_t frame[3] = { (uint8_t)(raw >> 8), (uint8_t)raw, 0 };
+    frame[2] = sht20_crc8(frame, 2);
+    size_t n = len < 3 ? len : 3;
+    memcpy(buf, frame, n);
+    return n;
+}
+
+// ========== 模拟的 LM75 ==========
+
+static uint8_t lm75_pointer = 0x00;
+
+static bool lm75_write(const uint8_t *data, size_t len) {
+    if (len > 0) {
+        lm75_pointer = data[0];
+    }
+    return true;
+}
+
+static size_t lm75_read(uint8_t *buf, size_t len) {
+    if (lm75_pointer != 0x00 || len < 2) {
+        return 0; // 只模拟温度寄存器
+    }
+    float temp_c, humi_rh;
+    read_climate(&temp_c, &humi_rh);
+    // 11 位补码, 0.125 °C, 左对齐到 16 位
+    int16_t reg = (int16_t)(lroundf(temp_c * 8.0f) * 32);
+    buf[0] = (uint8_t)((uint16_t)reg >> 8);
+    buf[1] = (uint8_t)reg;
+    return 2;
+}
+
+// ========== TwoWire ==========
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+    (void)sda;
+    (void)scl;
+    (void)frequency;
+    return true;
+}
+
+void TwoWire::beginTransmission(int address) {
+    tx_address = (uint8_t)address;
+    tx_len = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (tx_len >= WIRE_BUFFER_SIZE) {
+        return 0;
+    }
+    tx_buf[tx_len++] = data;
+    return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool send_stop) {
+    (void)send_stop;
+    bool acked = false;
+    if (tx_address == SHT20_ADDR && sht20_present) {
+        acked = sht20_write(tx_buf, tx_len);
+    } else if (tx_address == LM75_ADDR && lm75_present) {
+        acked = lm75_write(tx_buf, tx_len);
+    }
+    tx_len = 0;
+    return acked ? 0 : 2;
+}
+
+uint8_t TwoWire::requestFrom(int address, int quantity) {
+    size_t len = quantity < 0 ? 0 : (size_t)quantity;
+    if (len > WIRE_BUFFER_SIZE) {
+        len = WIRE_BUFFER_SIZE;
+    }
+    rx_pos = 0;
+    rx_len = 0;
+    if (address == SHT20_ADDR && sht20_present) {
+        rx_len = sht20_read(rx_buf, len);
+    } else if (address == LM75_ADDR && lm75_present) {
+        rx_len = lm75_read(rx_buf, len);
+    }
+    return (uint8_t)rx_len;
+}
+
+int TwoWire::available(void) {
+    return (int)(rx_len - rx_pos);
+}
+
+int TwoWire::read(void) {
+    return rx_pos < rx_len ? rx_buf[rx_pos++] : -1;
+}
@@ -0,0 +1,36 @@
+#ifndef NATIVE_HOST_WIRE_H
+#define NATIVE_HOST_WIRE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief I2C 的宿主替身. 总线上挂着模拟的 SHT20 (0x40) 和 LM75 (0x48),
+ * 测量值由 NativeHost_SetClimate() 设置, 其他地址一律不应答.
+ */
+
+#define WIRE_BUFFER_SIZE 32
+
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    void beginTransmission(int address);
+    size_t write(uint8_t data);
+    // 0: 成功, 2: 地址无应答 (与 Arduino 的返回值一致)
+    uint8_t endTransmission(bool send_stop = true);
+    // 返回读到的字节数, 地址无应答 (例如 SHT20 转换未完成) 时为 0
+    uint8_t requestFrom(int address, int quantity);
+    int available(void);
+    int read(void);
+
+private:
+    uint8_t tx_address = 0;
+    uint8_t tx_buf[WIRE_BUFFER_SIZE];
+    size_t tx_len = 0;
+    uint8_t rx_buf[WIRE_BUFFER_SIZE];
+    size_t rx_len = 0;
+    size_t rx_pos = 0;
+};
+
+extern TwoWire Wire;
+
+#endif // NATIVE_HOST_WIRE_H
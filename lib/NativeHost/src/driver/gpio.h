@@ -0,0 +1,9 @@
+#ifndef NATIVE_HOST_DRIVER_GPIO_H
+#define NATIVE_HOST_DRIVER_GPIO_H
+
+typedef int gpio_num_t;
+
+// 读取 NativeHost 的引脚电平表, 与 digitalRead() 相同
+int gpio_get_level(gpio_num_t gpio_num);
+
+#endif // NATIVE_HOST_DRIVER_GPIO_H
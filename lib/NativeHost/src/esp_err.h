@@ -0,0 +1,13 @@
+#ifndef NATIVE_HOST_ESP_ERR_H
+#define NATIVE_HOST_ESP_ERR_H
+
+typedef int esp_err_t;
+
+#define ESP_OK                0
+#define ESP_FAIL              -1
+#define ESP_ERR_NO_MEM        0x101
+#define ESP_ERR_INVALID_ARG   0x102
+#define ESP_ERR_INVALID_SIZE  0x104
+#define ESP_ERR_NOT_FOUND     0x105
+
+#endif // NATIVE_HOST_ESP_ERR_H
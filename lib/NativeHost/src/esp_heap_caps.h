@@ -0,0 +1,14 @@
+#ifndef NATIVE_HOST_ESP_HEAP_CAPS_H
+#define NATIVE_HOST_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT    (1 << 2)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+// 宿主的 malloc 没有固定大小的堆, 返回的是 glibc 已向系统申请但未分配出去的部分
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+
+#endif // NATIVE_HOST_ESP_HEAP_CAPS_H
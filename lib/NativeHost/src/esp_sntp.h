@@ -0,0 +1,23 @@
+#ifndef NATIVE_HOST_ESP_SNTP_H
+#define NATIVE_HOST_ESP_SNTP_H
+
+#include <stdint.h>
+#include <sys/time.h>
+
+/**
+ * @brief SNTP 的宿主替身. 宿主的系统时间已经由操作系统校准,
+ * configTzTime() 直接以当前时间调用一次同步回调.
+ */
+
+typedef enum {
+    SNTP_SYNC_MODE_IMMED,
+    SNTP_SYNC_MODE_SMOOTH,
+} sntp_sync_mode_t;
+
+typedef void (*sntp_sync_time_cb_t)(struct timeval *tv);
+
+void sntp_set_sync_mode(sntp_sync_mode_t mode);
+void sntp_set_sync_interval(uint32_t interval_ms);
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback);
+
+#endif // NATIVE_HOST_ESP_SNTP_H
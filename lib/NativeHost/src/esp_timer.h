@@ -0,0 +1,30 @@
+#ifndef NATIVE_HOST_ESP_TIMER_H
+#define NATIVE_HOST_ESP_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+// 进程启动后的微秒数, 与 NativeHost_TimeUs() 相同
+int64_t esp_timer_get_time(void);
+
+typedef struct native_esp_timer *esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void *arg);
+
+typedef enum {
+    ESP_TIMER_TASK,
+} esp_timer_dispatch_t;
+
+typedef struct {
+    esp_timer_cb_t callback;
+    void *arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char *name;
+    bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+// 定时器只被记录不会触发 (CpuLoad 的峰值采样在宿主上没有意义)
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out_handle);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us);
+
+#endif // NATIVE_HOST_ESP_TIMER_H
@@ -0,0 +1,45 @@
+#ifndef NATIVE_HOST_FREERTOS_H
+#define NATIVE_HOST_FREERTOS_H
+
+/**
+ * @brief FreeRTOS 的宿主替身: 任务是 std::thread, 队列和任务通知用互斥量加条件变量.
+ * 没有优先级和抢占, 调度顺序由宿主系统决定.
+ */
+
+#include <stdint.h>
+#include <atomic>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdFAIL  0
+#define pdPASS  1
+
+#define configTICK_RATE_HZ 1000
+#define configGENERATE_RUN_TIME_STATS 1
+#define portMAX_DELAY      ((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+
+// 宿主上没有真正的中断上下文, ISR 在调用 NativeHost_SetPin() 的线程中运行
+#define portYIELD_FROM_ISR(woken) ((void)(woken))
+
+// 板上的临界区关中断, 这里用自旋锁代替
+typedef struct {
+    std::atomic<bool> locked;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {false}
+
+void vPortEnterCritical(portMUX_TYPE *mux);
+void vPortExitCritical(portMUX_TYPE *mux);
+
+#define portENTER_CRITICAL(mux)     vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)      vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)  vPortExitCritical(mux)
+
+#endif // NATIVE_HOST_FREERTOS_H
@@ -0,0 +1,29 @@
+#ifndef NATIVE_HOST_FREERTOS_TASK_H
+#define NATIVE_HOST_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct native_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+// 栈大小和优先级被忽略; 任务函数不返回, 线程在进程结束时随之结束
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stack_depth,
+                       void *parameter, UBaseType_t priority, TaskHandle_t *created);
+
+void vPortYield(void);
+#define taskYIELD() vPortYield()
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t *previous_wake, TickType_t period);
+
+// 宿主上没有空闲任务, 空闲时间恒为 0 (CpuLoad 因此报告满载)
+uint32_t ulTaskGetIdleRunTimeCounter(void);
+
+// 任务通知, 只实现计数信号量的用法
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_woken);
+
+#endif // NATIVE_HOST_FREERTOS_TASK_H
@@ -0,0 +1,10 @@
+#ifndef NATIVE_HOST_NVS_FLASH_H
+#define NATIVE_HOST_NVS_FLASH_H
+
+#include "esp_err.h"
+
+// NVS 的内容就是 Preferences 的内存存储, 擦除即清空所有命名空间
+esp_err_t nvs_flash_init(void);
+esp_err_t nvs_flash_erase(void);
+
+#endif // NATIVE_HOST_NVS_FLASH_H
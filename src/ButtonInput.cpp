@@ -0,0 +1,227 @@
+#include "ButtonInput.h"
+#include "Pages.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#define BUTTON_EDGE_QUEUE_LEN 16
+
+// 中断中记录的一次电平跳变
+typedef struct {
+    uint32_t time_ms;
+    bool pressed;
+} button_edge_t;
+
+static QueueHandle_t edge_queue = NULL;
+static TaskHandle_t wake_task = NULL;
+
+// 以下状态只在 LVGL 线程中访问
+static button_event_cb_t active_handler = NULL;
+static bool double_click_enabled = false;
+static bool stable_pressed = false;     // 消抖后的按键状态
+static uint32_t last_edge_ms = 0;       // 最近一次被接受的跳变时间
+static uint32_t press_start_ms = 0;
+static uint32_t last_progress_ms = 0;
+static bool press_consumed = false;     // 本次按压属于上一个页面
+static bool long_press_fired = false;
+static bool click_pending = false;      // 等待第二次单击
+static uint32_t click_pending_since = 0;
+static uint32_t click_pending_held = 0; // 等待中的单击的按压时长
+static bool second_press = false;       // 当前按压可能是双击的第二次按下, 它的 PRESS 暂缓派发
+static uint32_t handler_generation = 0; // 每次切换回调加一, 用于识别派发途中的页面切换
+
+static inline bool read_pin_pressed(void) {
+    return gpio_get_level((gpio_num_t)BUTTON_PIN) == 0;
+}
+
+static void IRAM_ATTR button_isr(void) {
+    button_edge_t edge;
+    edge.time_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    edge.pressed = read_pin_pressed();
+
+    BaseType_t higher_priority_woken = pdFALSE;
+    // 队列满时丢弃, ButtonInput_Process() 会按实际电平补齐状态
+    xQueueSendFromISR(edge_queue, &edge, &higher_priority_woken);
+    if (wake_task) {
+        vTaskNotifyGiveFromISR(wake_task, &higher_priority_woken);
+    }
+    portYIELD_FROM_ISR(higher_priority_woken);
+}
+
+static void emit(button_event_type_t type, uint32_t held_ms) {
+    // 每次派发前都重新检查: 回调可能已经切换了页面
+    if (press_consumed || active_handler == NULL) {
+        return;
+    }
+    button_event_t event = { type, held_ms };
+    active_handler(&event);
+}
+
+// 第二次按压已经不可能构成双击 (按得太久或成了长按): 先派发等待中的第一次单击,
+// 再补发这次按压暂缓的 PRESS, 回调看到的顺序与实际按压一致
+static void flush_pending_click(void) {
+    if (!click_pending) {
+        return;
+    }
+    bool deferred_press = second_press;
+    click_pending = false;
+    second_press = false;
+    emit(BUTTON_EVENT_CLICK, click_pending_held);
+    if (deferred_press) {
+        emit(BUTTON_EVENT_PRESS, 0); // 回调在 CLICK 中切换了页面时, press_consumed 会挡住它
+    }
+}
+
+static void handle_press(uint32_t time_ms) {
+    stable_pressed = true;
+    press_start_ms = time_ms;
+    last_progress_ms = time_ms;
+    long_press_fired = false;
+    if (click_pending && time_ms - click_pending_since > BUTTON_DOUBLE_CLICK_GAP_MS) {
+        flush_pending_click(); // 等待已超时, 只是还没轮到 ButtonInput_Process() 处理
+    }
+    second_press = click_pending;
+    if (!second_press) {
+        emit(BUTTON_EVENT_PRESS, 0);
+    }
+}
+
+static void handle_release(uint32_t time_ms) {
+    stable_pressed = false;
+    uint32_t held = time_ms - press_start_ms;
+
+    if (press_consumed) {
+        press_consumed = false; // 上一个页面的按压结束, 从下一次按压开始派发
+        return;
+    }
+
+    if (held > BUTTON_CLICK_MAX_MS) {
+        flush_pending_click();
+    }
+
+    uint32_t generation = handler_generation;
+    if (second_press) {
+        emit(BUTTON_EVENT_PRESS, 0); // 双击的第二次按下, 暂缓的 PRESS 与 RELEASE 一起发出
+    }
+    if (generation == handler_generation) {
+        emit(BUTTON_EVENT_RELEASE, held);
+    }
+    if (generation != handler_generation) {
+        click_pending = false;
+        return; // 页面在 RELEASE 中已切换, 这次松开不再派生单击
+    }
+    if (long_press_fired || held > BUTTON_CLICK_MAX_MS) {
+        return;
+    }
+    if (!double_click_enabled) {
+        emit(BUTTON_EVENT_CLICK, held);
+    } else if (second_press) {
+        click_pending = false;
+        emit(BUTTON_EVENT_DOUBLE_CLICK, held);
+    } else {
+        click_pending = true;
+        click_pending_since = time_ms;
+        click_pending_held = held;
+    }
+}
+
+static void apply_edge(bool pressed, uint32_t time_ms) {
+    if (pressed == stable_pressed) {
+        return; // 抖动产生的重复电平
+    }
+    if (time_ms - last_edge_ms < BUTTON_DEBOUNCE_MS) {
+        return; // 距上次有效跳变太近, 视为抖动
+    }
+    last_edge_ms = time_ms;
+    if (pressed) {
+        handle_press(time_ms);
+    } else {
+        handle_release(time_ms);
+    }
+}
+
+void ButtonInput_Begin(void) {
+    if (edge_queue != NULL) {
+        return;
+    }
+    edge_queue = xQueueCreate(BUTTON_EDGE_QUEUE_LEN, sizeof(button_edge_t));
+    wake_task = xTaskGetCurrentTaskHandle();
+    stable_pressed = read_pin_pressed();
+    // 上电时已经按下的按键不产生事件
+    press_consumed = stable_pressed;
+    attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), button_isr, CHANGE);
+}
+
+void ButtonInput_SetHandler(button_event_cb_t handler, bool double_click) {
+    active_handler = handler;
+    handler_generation++;
+    double_click_enabled = double_click;
+    click_pending = false;
+    second_press = false;
+    if (stable_pressed) {
+        press_consumed = true;
+    }
+}
+
+uint32_t ButtonInput_Process(void) {
+    if (edge_queue == NULL) {
+        return UINT32_MAX;
+    }
+
+    button_edge_t edge;
+    while (xQueueReceive(edge_queue, &edge, 0) == pdTRUE) {
+        apply_edge(edge.pressed, edge.time_ms);
+    }
+
+    uint32_t now = millis();
+
+    // 抖动期间丢掉的最后一个跳变可能正是最终电平, 消抖窗口过后按实际电平补齐
+    bool pin_pressed = read_pin_pressed();
+    if (pin_pressed != stable_pressed) {
+        if (now - last_edge_ms >= BUTTON_DEBOUNCE_MS) {
+            apply_edge(pin_pressed, now);
+        } else {
+            return BUTTON_DEBOUNCE_MS - (now - last_edge_ms);
+        }
+    }
+
+    uint32_t next_ms = UINT32_MAX;
+
+    if (stable_pressed && !press_consumed && !long_press_fired) {
+        uint32_t held = now - press_start_ms;
+        if (held > BUTTON_CLICK_MAX_MS) {
+            flush_pending_click();
+        }
+        if (held >= BUTTON_LONG_PRESS_MS) {
+            long_press_fired = true;
+            emit(BUTTON_EVENT_LONG_PRESS_PROGRESS, BUTTON_LONG_PRESS_MS);
+            emit(BUTTON_EVENT_LONG_PRESS, held);
+        } else if (second_press) {
+            next_ms = BUTTON_CLICK_MAX_MS + 1 - held; // PRESS 还没发出, 到可以判定时再处理
+        } else {
+            if (now - last_progress_ms >= BUTTON_PROGRESS_INTERVAL_MS) {
+                last_progress_ms = now;
+                emit(BUTTON_EVENT_LONG_PRESS_PROGRESS, held);
+            }
+            next_ms = BUTTON_PROGRESS_INTERVAL_MS;
+        }
+    }
+
+    if (click_pending && !stable_pressed) {
+        uint32_t waited = now - click_pending_since;
+        if (waited > BUTTON_DOUBLE_CLICK_GAP_MS) {
+            click_pending = false;
+            emit(BUTTON_EVENT_CLICK, click_pending_held);
+        } else if (BUTTON_DOUBLE_CLICK_GAP_MS - waited < next_ms) {
+            next_ms = BUTTON_DOUBLE_CLICK_GAP_MS - waited + 1;
+        }
+    }
+
+    return next_ms;
+}
+
+bool ButtonInput_IsPressed(void) {
+    return stable_pressed;
+}
@@ -0,0 +1,138 @@
+#include "CpuLoad.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+// 空闲时间取自 FreeRTOS 运行时统计 (空闲任务累计运行的时间), 需要 esp_timer 作为
+// 统计时钟, 这样计数单位就是 µs. 计数器是 32 位的, 两次读取间隔远小于回绕周期 (约 71 分钟).
+#if !configGENERATE_RUN_TIME_STATS
+#error "CpuLoad needs CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS"
+#endif
+#ifdef CONFIG_FREERTOS_RUN_TIME_STATS_USING_CPU_CLK
+#error "CpuLoad expects the run time counter in microseconds (esp_timer clock)"
+#endif
+
+// 子窗口长度, 用于计算峰值占用率
+static const int64_t SUBWINDOW_US = 100000;
+
+static portMUX_TYPE load_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool started = false;
+static esp_timer_handle_t subwindow_timer = NULL;
+
+// 只由子窗口定时器访问
+static int64_t subwindow_start = 0;
+static uint32_t subwindow_idle_start = 0;
+
+// 由子窗口定时器写入, 由 CpuLoad_TakeReport() 读取 (需进入临界区)
+static int64_t window_start = 0;
+static uint32_t window_idle_start = 0;
+static uint8_t window_peak = 0;
+static volatile uint8_t last_usage = 0;
+
+// 各模块累计的忙碌时间, 每个槽只由一个任务写入
+static int64_t slot_enter_time[CPU_SLOT_COUNT];
+static int64_t slot_busy_us[CPU_SLOT_COUNT];
+
+static uint8_t load_percent(int64_t idle_us, int64_t elapsed_us) {
+    if (elapsed_us <= 0) {
+        return 0;
+    }
+    if (idle_us > elapsed_us) {
+        idle_us = elapsed_us;
+    }
+    return (uint8_t)(100 - (idle_us * 100) / elapsed_us);
+}
+
+static uint32_t idle_run_time(void) {
+    return (uint32_t)ulTaskGetIdleRunTimeCounter();
+}
+
+/**
+ * @brief 子窗口定时器 (esp_timer 任务中运行). 空闲任务的计数只在它被切换出去时更新,
+ * 所以不能在空闲钩子里读; 定时器任务抢占空闲任务之后读到的就是最新值.
+ * 空闲任务照常进入 WAITI.
+ */
+static void subwindow_cb(void *arg) {
+    (void)arg;
+    int64_t now = esp_timer_get_time();
+    uint32_t idle = idle_run_time();
+    uint8_t usage = load_percent((int64_t)(uint32_t)(idle - subwindow_idle_start), now - subwindow_start);
+    portENTER_CRITICAL(&load_mux);
+    if (usage > window_peak) {
+        window_peak = usage;
+    }
+    portEXIT_CRITICAL(&load_mux);
+    last_usage = usage;
+    subwindow_start = now;
+    subwindow_idle_start = idle;
+}
+
+void CpuLoad_Begin(void) {
+    if (started) {
+        return;
+    }
+    int64_t now = esp_timer_get_time();
+    uint32_t idle = idle_run_time();
+    subwindow_start = now;
+    subwindow_idle_start = idle;
+    window_start = now;
+    window_idle_start = idle;
+
+    const esp_timer_create_args_t args = {
+        .callback = subwindow_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "cpu_load",
+        .skip_unhandled_events = true,
+    };
+    if (esp_timer_create(&args, &subwindow_timer) != ESP_OK ||
+        esp_timer_start_periodic(subwindow_timer, SUBWINDOW_US) != ESP_OK) {
+        Serial.println("Failed to start CPU load timer.");
+        return;
+    }
+    started = true;
+}
+
+uint8_t CpuLoad_GetUsage(void) {
+    return last_usage;
+}
+
+void CpuLoad_SlotEnter(cpu_slot_t slot) {
+    slot_enter_time[slot] = esp_timer_get_time();
+}
+
+void CpuLoad_SlotExit(cpu_slot_t slot) {
+    int64_t spent = esp_timer_get_time() - slot_enter_time[slot];
+    portENTER_CRITICAL(&load_mux);
+    slot_busy_us[slot] += spent;
+    portEXIT_CRITICAL(&load_mux);
+}
+
+void CpuLoad_TakeReport(CpuLoadReport *out) {
+    int64_t now = esp_timer_get_time();
+
+    uint32_t idle = idle_run_time();
+
+    portENTER_CRITICAL(&load_mux);
+    int64_t elapsed = now - window_start;
+    int64_t idle_us = (int64_t)(uint32_t)(idle - window_idle_start);
+    uint8_t peak = window_peak;
+    int64_t busy[CPU_SLOT_COUNT];
+    for (int i = 0; i < CPU_SLOT_COUNT; i++) {
+        busy[i] = slot_busy_us[i];
+        slot_busy_us[i] = 0;
+    }
+    window_start = now;
+    window_idle_start = idle;
+    window_peak = 0;
+    portEXIT_CRITICAL(&load_mux);
+
+    out->window_ms = (uint32_t)(elapsed / 1000);
+    out->average = load_percent(idle_us, elapsed);
+    // 当前子窗口尚未结算, 峰值至少不低于平均值
+    out->peak = peak > out->average ? peak : out->average;
+    for (int i = 0; i < CPU_SLOT_COUNT; i++) {
+        int64_t share = elapsed > 0 ? (busy[i] * 100) / elapsed : 0;
+        out->slot_share[i] = (uint8_t)(share > 100 ? 100 : share);
+    }
+}
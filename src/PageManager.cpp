@@ -0,0 +1,209 @@
+#include "PageManager.h"
+#include "ButtonInput.h"
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+
+// 一个已构建的页面
+typedef struct {
+    const page_desc_t *page;  // NULL 表示空槽位
+    lv_obj_t *screen;
+    uint32_t last_shown;      // lv_tick_get(), 用于按最近使用淘汰
+} page_slot_t;
+
+static page_slot_t slots[PAGE_MANAGER_MAX_PAGES];
+static const page_desc_t *current = NULL;
+static const page_desc_t *previous = NULL; // 切换动画期间仍在显示
+
+// 统计, 由 PageManager_Print() 输出
+static uint32_t builds = 0;
+static uint32_t hits = 0;
+static uint32_t evictions = 0;
+
+// 每个页面最近一次构建的开销: create() 的耗时和构建后多占用的 LVGL 内存
+typedef struct {
+    const page_desc_t *page;
+    uint32_t build_us;
+    int32_t heap_bytes;
+} build_cost_t;
+
+static build_cost_t build_costs[PAGE_MANAGER_MAX_PAGES];
+
+static page_slot_t *find_slot(const page_desc_t *page) {
+    for (int i = 0; i < PAGE_MANAGER_MAX_PAGES; i++) {
+        if (slots[i].page == page) {
+            return &slots[i];
+        }
+    }
+    return NULL;
+}
+
+static void destroy_slot(page_slot_t *slot) {
+    const page_desc_t *page = slot->page;
+    lv_obj_del(slot->screen);
+    slot->page = NULL;
+    slot->screen = NULL;
+    if (page->on_destroy) {
+        page->on_destroy();
+    }
+    evictions++;
+    Serial.printf("Page cache: evicted %s\n", page->name);
+}
+
+// 最久没有显示过的可淘汰页面; 当前页面, 上一个页面, 正在显示的屏幕和常驻页面不淘汰
+static page_slot_t *lru_victim(void) {
+    page_slot_t *victim = NULL;
+    lv_obj_t *active = lv_scr_act();
+    for (int i = 0; i < PAGE_MANAGER_MAX_PAGES; i++) {
+        page_slot_t *slot = &slots[i];
+        if (slot->page == NULL || slot->page == current || slot->page == previous ||
+            slot->page->pinned || slot->screen == active) {
+            continue;
+        }
+        if (victim == NULL || (int32_t)(slot->last_shown - victim->last_shown) < 0) {
+            victim = slot;
+        }
+    }
+    return victim;
+}
+
+static int cached_count(void) {
+    int count = 0;
+    for (int i = 0; i < PAGE_MANAGER_MAX_PAGES; i++) {
+        if (slots[i].page != NULL && !slots[i].page->pinned) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static uint32_t largest_free_block(void) {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.total_size == 0) {
+        // LVGL 配置为使用系统 malloc 时没有自己的内存池, 看系统堆
+        return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    }
+    return mon.free_biggest_size;
+}
+
+static uint32_t free_heap(void) {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.total_size == 0) {
+        return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    }
+    return mon.free_size;
+}
+
+static void record_build_cost(const page_desc_t *page, uint32_t build_us, int32_t heap_bytes) {
+    build_cost_t *cost = NULL;
+    for (int i = 0; i < PAGE_MANAGER_MAX_PAGES && cost == NULL; i++) {
+        if (build_costs[i].page == page || build_costs[i].page == NULL) {
+            cost = &build_costs[i];
+        }
+    }
+    if (cost != NULL) {
+        cost->page = page;
+        cost->build_us = build_us;
+        cost->heap_bytes = heap_bytes;
+    }
+}
+
+// 内存紧张时按最近使用淘汰, 直到恢复或没有可淘汰的页面
+static void evict_for_memory(void) {
+    while (largest_free_block() < PAGE_CACHE_MIN_FREE_BLOCK) {
+        page_slot_t *victim = lru_victim();
+        if (victim == NULL) {
+            return;
+        }
+        destroy_slot(victim);
+    }
+}
+
+static void trim_cache(void) {
+    while (cached_count() > PAGE_CACHE_SIZE) {
+        page_slot_t *victim = lru_victim();
+        if (victim == NULL) {
+            break;
+        }
+        destroy_slot(victim);
+    }
+    evict_for_memory();
+}
+
+bool PageManager_Show(const page_desc_t *page, lv_scr_load_anim_t anim, uint32_t anim_ms) {
+    if (page == current) {
+        return false;
+    }
+
+    lv_obj_t *old_screen = lv_scr_act();
+    bool old_managed = current != NULL;
+    if (current != NULL && current->on_hide) {
+        current->on_hide();
+    }
+    // 新页面在 on_show 中注册自己的回调
+    ButtonInput_SetHandler(NULL, false);
+
+    previous = current;
+    page_slot_t *slot = find_slot(page);
+    bool built = slot == NULL;
+    if (!built) {
+        hits++;
+    } else {
+        // 构建前先为新屏幕腾出内存
+        current = NULL;
+        evict_for_memory();
+        slot = find_slot(NULL);
+        if (slot == NULL) {
+            slot = lru_victim(); // 页面数超过 PAGE_MANAGER_MAX_PAGES
+            destroy_slot(slot);
+        }
+        uint32_t heap_before = free_heap();
+        int64_t start = esp_timer_get_time();
+        slot->screen = page->create();
+        record_build_cost(page, (uint32_t)(esp_timer_get_time() - start),
+            (int32_t)(heap_before - free_heap()));
+        slot->page = page;
+        builds++;
+    }
+
+    slot->last_shown = lv_tick_get();
+    current = page;
+    // 开机默认屏幕或引导页面不会再回去, 交给 LVGL 在动画结束后删除;
+    // 缓存的屏幕只是被替换下来
+    bool delete_old = !old_managed && old_screen != NULL && old_screen != slot->screen;
+    lv_scr_load_anim(slot->screen, anim, anim_ms, 0, delete_old);
+    page->on_show();
+
+    trim_cache();
+    return built;
+}
+
+const page_desc_t *PageManager_Current(void) {
+    return current;
+}
+
+void PageManager_Evict(const page_desc_t *page) {
+    page_slot_t *slot = find_slot(page);
+    if (slot != NULL && page != current) {
+        destroy_slot(slot);
+    }
+}
+
+void PageManager_Print(void) {
+    Serial.printf("Pages: current=%s, builds=%lu, cache hits=%lu, evictions=%lu, largest free block=%lu\n",
+        current ? current->name : "-", (unsigned long)builds, (unsigned long)hits,
+        (unsigned long)evictions, (unsigned long)largest_free_block());
+    Serial.print("Pages: cached:");
+    for (int i = 0; i < PAGE_MANAGER_MAX_PAGES; i++) {
+        if (slots[i].page != NULL) {
+            Serial.printf(" %s%s", slots[i].page->name, slots[i].page->pinned ? "(pinned)" : "");
+        }
+    }
+    Serial.println();
+    for (int i = 0; i < PAGE_MANAGER_MAX_PAGES && build_costs[i].page != NULL; i++) {
+        Serial.printf("Pages: last build %-9s %6ldB %6luus\n", build_costs[i].page->name,
+            (long)build_costs[i].heap_bytes, (unsigned long)build_costs[i].build_us);
+    }
+}
@@ -1,51 +1,209 @@
 #include "Pages.h"
+#include "ButtonInput.h"
+#include "Router.h"
+#include "Theme.h"
 #include "lvgl.h"
 // If your development environment is Arduino, you need to include Arduino.h
 #include <Arduino.h>
 
-// --- Color Definitions (Light Theme) ---
-static const lv_color_t BG_COLOR = lv_color_hex(0xF5F5F5);      // Light gray background
-static const lv_color_t TEXT_COLOR = lv_color_hex(0x323232);    // Dark gray text
-static const lv_color_t ACCENT_COLOR = lv_color_hex(0x3498DB);  // Blue for the progress bar
-
 // --- Global Static Variables ---
 static lv_obj_t *about_screen;    // The "About" page screen object
 static lv_obj_t *info_screen;     // The "Info" page screen object
 static lv_obj_t *progress_bar;    // The progress bar widget
 static lv_obj_t *info_scroll_cont; // Scrollable container for info page
+static lv_obj_t *details_box;     // Fixed-height placeholder for the details text
+
+// --- Details Text ---
+// Pre-wrapped to fit the info page width in Montserrat 14, one entry per row.
+// Only DETAIL_POOL_SIZE labels exist; they are rebound as the page scrolls.
+static const char *const DETAIL_LINES[] = {
+    "### ESP32-C3 Multi-Function",
+    "Environment Monitor ###",
+    "",
+    "--- Core Processing Unit &",
+    "Memory ---",
+    "* MCU: Espressif",
+    "  ESP32-C3-WROOM-02",
+    "  - CPU: 32-bit RISC-V,",
+    "    up to 160 MHz",
+    "  - Features: Secure Boot,",
+    "    Flash Encryption",
+    "* Flash Memory: 4MB SPI Flash",
+    "* SRAM: 400 KB",
+    "",
+    "--- Connectivity Suite ---",
+    "* Wi-Fi: IEEE 802.11 b/g/n",
+    "  (2.4 GHz)",
+    "  - Modes: Station, SoftAP,",
+    "    Station+SoftAP",
+    "* Bluetooth: BLE 5.0",
+    "  - Features: Long Range,",
+    "    2Mbps High Speed",
+    "",
+    "--- On-board Sensing Array ---",
+    "* Temp Sensor: LM75 (I2C)",
+    "* Temp & Humidity: SHT20 (I2C)",
+    "* Internal Temp: ESP32",
+    "  Internal Sensor",
+    "",
+    "--- About This Project ---",
+    "* Author: Fang Leyang",
+    "  - Jiangnan University,",
+    "    School of IoT",
+    "  - Major: Internet of",
+    "    Things 2302",
+    "  - Student ID: 1034230231",
+    "",
+    "* AI Assistants Used:",
+    "  - Google Gemini (2.5 Pro,",
+    "    2.5/2.0 Flash)",
+    "  - Anthropic Claude",
+    "    (4/3.7 Sonnet)",
+    "  - ChatGPT (GPT-4.1, GPT-4o)",
+    "  - Deepseek (V3)",
+    "",
+    "* Open Source Libraries:",
+    "  - LVGL, TFT_eSPI,",
+    "    ESP32WebServer",
+    "  - ArduinoJson,",
+    "    Arduino Core for ESP32",
+    "",
+    "* Special Thanks To:",
+    "  - Google & Microsoft for",
+    "    free LLM access",
+    "  - Vercel for Web Deployment",
+    "",
+    "* Know More At:",
+    "  iotcoursedesign.flysworld.top",
+    "* Source Code:",
+    "  https://github.com/",
+    "  Eclipse-01/ESP32_Temp",
+    "",
+    "* Version: 1.4 |",
+    "  Date: 2025-07-02",
+};
+#define DETAIL_LINE_COUNT ((int)(sizeof(DETAIL_LINES) / sizeof(DETAIL_LINES[0])))
+#define DETAIL_POOL_SIZE  18 // Covers the 240px screen plus a row above and below
+
+static lv_obj_t *detail_rows[DETAIL_POOL_SIZE]; // Line n is shown by detail_rows[n % DETAIL_POOL_SIZE]
+static int detail_bound[DETAIL_POOL_SIZE];      // Line each pooled label currently shows, -1 = none
+static int32_t detail_line_height;
+
+static const char *const GITHUB_URL = "https://github.com/Eclipse-01/ESP32_Temp";
+static lv_draw_buf_t *github_qr;  // Rendered once, kept for the lifetime of the firmware
 
-// Timers for each page
-static lv_timer_t *about_page_timer;  // Timer for the about page
-static lv_timer_t *info_page_timer;   // NEW: Timer for the info page
+// --- Forward Declarations ---
+static lv_obj_t *create_info_page(void);
+static void about_page_button_cb(const button_event_t *event);
+static void info_page_button_cb(const button_event_t *event);
+static lv_obj_t* create_info_row(lv_obj_t* parent, const char* label_text, const char* value_text); // NEW Helper function
+static void bind_detail_rows(void);
+static void info_scroll_event_cb(lv_event_t *e);
 
-static int press_duration = 0;    // Variable to record button press duration (ms)
-static bool ignore_initial_press = true;
 
-// --- Constants ---
-const int LONG_PRESS_DURATION_MS = 1000; // Required duration for a long press (ms)
-const int CLICK_DURATION_MS_MAX = 300;   // Maximum duration for a single click (ms)
-const int TIMER_INTERVAL_MS = 20;        // Timer polling interval (ms)
+// Styles shared by the rows and text blocks of the info page
+static lv_style_t info_column_style;
+static lv_style_t info_row_style;
+static lv_style_t info_value_style;
+static lv_style_t info_block_style;
+static lv_style_t detail_row_style;
+
+static void init_info_styles(void)
+{
+    static bool styles_inited = false;
+    if (styles_inited) {
+        return;
+    }
 
-// --- Add this enum definition near the top with other declarations ---
-typedef enum {
-    STATE_WAIT_FOR_INITIAL_RELEASE,
-    STATE_READY_FOR_CLICK,
-    STATE_BUTTON_IS_PRESSED
-} info_page_input_state_t;
+    lv_style_init(&info_column_style);
+    lv_style_set_width(&info_column_style, lv_pct(100));
+    lv_style_set_height(&info_column_style, LV_SIZE_CONTENT);
+    lv_style_set_layout(&info_column_style, LV_LAYOUT_FLEX);
+    lv_style_set_flex_flow(&info_column_style, LV_FLEX_FLOW_COLUMN);
+    lv_style_set_pad_row(&info_column_style, 10);
+
+    lv_style_init(&info_row_style);
+    lv_style_set_width(&info_row_style, lv_pct(100));
+    lv_style_set_height(&info_row_style, LV_SIZE_CONTENT);
+    lv_style_set_layout(&info_row_style, LV_LAYOUT_FLEX);
+    lv_style_set_flex_flow(&info_row_style, LV_FLEX_FLOW_ROW);
+    lv_style_set_flex_main_place(&info_row_style, LV_FLEX_ALIGN_START);
+    lv_style_set_flex_cross_place(&info_row_style, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_flex_track_place(&info_row_style, LV_FLEX_ALIGN_CENTER);
+
+    // The value takes all remaining space and right-aligns its text
+    lv_style_init(&info_value_style);
+    lv_style_set_flex_grow(&info_value_style, 1);
+    lv_style_set_text_align(&info_value_style, LV_TEXT_ALIGN_RIGHT);
+
+    lv_style_init(&info_block_style);
+    lv_style_set_margin_top(&info_block_style, 20);
+    lv_style_set_margin_bottom(&info_block_style, 20);
+
+    detail_line_height = lv_font_get_line_height(&lv_font_montserrat_14);
+    lv_style_init(&detail_row_style);
+    lv_style_set_width(&detail_row_style, lv_pct(100));
+    lv_style_set_height(&detail_row_style, detail_line_height);
+
+    styles_inited = true;
+}
 
-// --- Forward Declarations ---
-static void create_info_page(void);
-static void about_page_timer_cb(lv_timer_t *timer);
-static void info_page_timer_cb(lv_timer_t *timer); // NEW
-static bool is_button_pressed(int pin_number);
-static void cleanup_about_page(void);
-static void cleanup_info_page(void); // NEW
-static lv_obj_t* create_info_row(lv_obj_t* parent, const char* label_text, const char* value_text); // NEW Helper function
+/**
+ * @brief The QR code never changes, so it is generated once into a scratch
+ * lv_qrcode and the resulting bitmap is kept as an image source. Rebuilding
+ * the info page then only creates an lv_image pointing at it.
+ */
+static const lv_draw_buf_t *github_qr_image(void)
+{
+    if (github_qr == NULL) {
+        lv_obj_t *scratch = lv_obj_create(NULL);
+        lv_obj_t *qr = lv_qrcode_create(scratch);
+        lv_qrcode_set_size(qr, 120);
+        lv_qrcode_set_dark_color(qr, THEME_COLOR_TEXT);
+        lv_qrcode_set_light_color(qr, THEME_COLOR_BG);
+        lv_qrcode_update(qr, GITHUB_URL, strlen(GITHUB_URL));
+        github_qr = lv_draw_buf_dup(lv_canvas_get_draw_buf(qr));
+        lv_obj_del(scratch);
+    }
+    return github_qr;
+}
 
-// Forward declaration for navigation
-void create_dashboard(void); // Assuming this function exists elsewhere to create the dashboard page.
-void Page_About(void);
+/**
+ * @brief Make sure every detail line inside the visible part of the scroll
+ * container is bound to a pooled label. Only labels whose line changed are
+ * touched, so a scroll step rebinds one or two rows.
+ */
+static void bind_detail_rows(void)
+{
+    lv_area_t view, box;
+    lv_obj_get_coords(info_scroll_cont, &view);
+    lv_obj_get_coords(details_box, &box);
 
+    int first = (view.y1 - box.y1) / detail_line_height - 1;
+    if (first > DETAIL_LINE_COUNT - DETAIL_POOL_SIZE) {
+        first = DETAIL_LINE_COUNT - DETAIL_POOL_SIZE;
+    }
+    if (first < 0) {
+        first = 0;
+    }
+
+    for (int line = first; line < first + DETAIL_POOL_SIZE && line < DETAIL_LINE_COUNT; line++) {
+        int slot = line % DETAIL_POOL_SIZE;
+        if (detail_bound[slot] == line) {
+            continue;
+        }
+        detail_bound[slot] = line;
+        lv_label_set_text_static(detail_rows[slot], DETAIL_LINES[line]);
+        lv_obj_set_y(detail_rows[slot], line * detail_line_height);
+        lv_obj_clear_flag(detail_rows[slot], LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+static void info_scroll_event_cb(lv_event_t *e)
+{
+    LV_UNUSED(e);
+    bind_detail_rows();
+}
 
 /**
  * @brief NEW: Helper function to create a standardized "Label: Value" row.
@@ -55,25 +213,18 @@ static lv_obj_t* create_info_row(lv_obj_t* parent, const char* label_text, const
 {
     lv_obj_t *row = lv_obj_create(parent);
     lv_obj_remove_style_all(row); // Remove default container styles
-    lv_obj_set_size(row, lv_pct(100), LV_SIZE_CONTENT);
-    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_add_style(row, &info_row_style, 0);
+    lv_obj_add_style(row, &theme_text, 0);     // Inherited by both labels
+    lv_obj_add_style(row, &theme_font_16, 0);
 
     // Left-side Label
     lv_obj_t *label = lv_label_create(row);
     lv_label_set_text(label, label_text);
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_16, 0);
-    lv_obj_set_style_text_color(label, TEXT_COLOR, 0);
 
     // Right-side Value
     lv_obj_t *value = lv_label_create(row);
     lv_label_set_text(value, value_text);
-    lv_obj_set_style_text_font(value, &lv_font_montserrat_16, 0);
-    lv_obj_set_style_text_color(value, TEXT_COLOR, 0);
-    
-    // FIX: This is the correct way to right-align the value
-    lv_obj_set_flex_grow(value, 1); // Allow the value label to take all remaining space
-    lv_obj_set_style_text_align(value, LV_TEXT_ALIGN_RIGHT, 0); // Align the text inside the label to the right
+    lv_obj_add_style(value, &info_value_style, 0);
 
     return row; // Return the row container
 }
@@ -83,35 +234,31 @@ static lv_obj_t* create_info_row(lv_obj_t* parent, const char* label_text, const
  * @brief Creates the info page (triggered by a long press)
  * Modified to support scroll functionality
  */
-static void create_info_page(void)
+static lv_obj_t *create_info_page(void)
 {
+    init_info_styles();
+
     info_screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(info_screen, BG_COLOR, 0);
+    lv_obj_add_style(info_screen, &theme_screen, 0);
 
     // Create a scrollable container that fills the screen
     info_scroll_cont = lv_obj_create(info_screen);
     lv_obj_set_size(info_scroll_cont, lv_pct(100), lv_pct(100));
-    lv_obj_set_style_pad_all(info_scroll_cont, 20, 0);
-    lv_obj_set_style_bg_opa(info_scroll_cont, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_border_width(info_scroll_cont, 0, 0);
+    lv_obj_add_style(info_scroll_cont, &theme_plain, 0);
+    lv_obj_set_style_pad_all(info_scroll_cont, THEME_PAGE_PAD, 0);
     lv_obj_set_scroll_dir(info_scroll_cont, LV_DIR_VER);
     lv_obj_set_scrollbar_mode(info_scroll_cont, LV_SCROLLBAR_MODE_AUTO);
 
     // Content container inside the scrollable area
     lv_obj_t *cont = lv_obj_create(info_scroll_cont);
-    lv_obj_set_size(cont, lv_pct(100), LV_SIZE_CONTENT);
-    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_style_pad_all(cont, 10, 0);
-    lv_obj_set_style_pad_row(cont, 10, 0);
-    lv_obj_set_style_bg_opa(cont, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_border_width(cont, 0, 0);
+    lv_obj_add_style(cont, &theme_plain, 0);
+    lv_obj_add_style(cont, &info_column_style, 0);
+    lv_obj_add_style(cont, &theme_text, 0);
 
     lv_obj_t *title_label = lv_label_create(cont);
     lv_label_set_text(title_label, "ESP Smart Node");
-    lv_obj_set_style_text_font(title_label, &lv_font_montserrat_24, 0);
-    lv_obj_set_style_text_color(title_label, TEXT_COLOR, 0);
-    lv_obj_set_width(title_label, lv_pct(100));
-    lv_obj_set_style_text_align(title_label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_add_style(title_label, &theme_font_24, 0);
+    lv_obj_add_style(title_label, &theme_text_center, 0);
     lv_obj_set_style_margin_bottom(title_label, 15, 0);
     
     // Use the helper function to create all the info rows
@@ -123,297 +270,208 @@ static void create_info_page(void)
     create_info_row(cont, "ROM Info:", "4MB");
     create_info_row(cont, "System Info:", "PandaOS v1.0");
     
-    // Add more content to make scrolling necessary
-    lv_obj_t *details_label = lv_label_create(cont);
-    lv_label_set_text(details_label, 
-    "### ESP32-C3 Multi-Function Environment Monitor ###\n\n"
-    "--- Core Processing Unit & Memory ---\n"
-    "* MCU: Espressif ESP32-C3-WROOM-02\n"
-    "  - CPU: 32-bit RISC-V, up to 160 MHz\n"
-    "  - Features: Secure Boot, Flash Encryption\n"
-    "* Flash Memory: 4MB SPI Flash\n"
-    "* SRAM: 400 KB\n\n"
-    "--- Connectivity Suite ---\n"
-    "* Wi-Fi: IEEE 802.11 b/g/n (2.4 GHz)\n"
-    "  - Modes: Station, SoftAP, Station+SoftAP\n"
-    "* Bluetooth: BLE 5.0\n"
-    "  - Features: Long Range, 2Mbps High Speed\n\n"
-    "--- On-board Sensing Array ---\n"
-    "* Temp Sensor: LM75 (I2C)\n"
-    "* Temp & Humidity: SHT20 (I2C)\n"
-    "* Internal Temp: ESP32 Internal Sensor\n\n"
-    "--- About This Project ---\n"
-    "* Author: Fang Leyang\n"
-    "  - Jiangnan University, School of IoT\n"
-    "  - Major: Internet of Things 2302\n"
-    "  - Student ID: 1034230231\n\n"
-    "* AI Assistants Used:\n"
-    "  - Google Gemini (2.5 Pro, 2.5/2.0 Flash)\n"
-    "  - Anthropic Claude (4/3.7 Sonnet)\n"
-    "  - ChatGPT (GPT-4.1, GPT-4o)\n"
-    "  - Deepseek (V3)\n\n"
-    "* Open Source Libraries:\n"
-    "  - LVGL, TFT_eSPI, ESP32WebServer\n"
-    "  - ArduinoJson, Arduino Core for ESP32\n\n"
-    "* Special Thanks To:\n"
-    "  - Google & Microsoft for free LLM access\n"
-    "  - Vercel for Web Deployment\n\n"
-    "* Know More At: iotcoursedesign.flysworld.top\n"
-    "* Source Code: https://github.com/Eclipse-01/ESP32_Temp\n\n"
-    "* Version: 1.4 | Date: 2025-07-02\n");
-    // Create QR code for GitHub repository
-    lv_obj_t *qr_code = lv_qrcode_create(cont);
-    lv_qrcode_set_size(qr_code, 120);
-    lv_qrcode_set_dark_color(qr_code, TEXT_COLOR);
-    lv_qrcode_set_light_color(qr_code, BG_COLOR);
-    lv_qrcode_update(qr_code, "https://github.com/Eclipse-01/ESP32_Temp", strlen("https://github.com/Eclipse-01/ESP32_Temp"));
-    lv_obj_align(qr_code, LV_ALIGN_CENTER, 0, 0);
-    lv_obj_set_style_margin_top(qr_code, 20, 0);
-    lv_obj_set_style_margin_bottom(qr_code, 10, 0);
+    // Long details text: fixed-height box, only the visible lines exist as labels
+    details_box = lv_obj_create(cont);
+    lv_obj_remove_style_all(details_box);
+    lv_obj_set_size(details_box, lv_pct(100), DETAIL_LINE_COUNT * detail_line_height);
+    lv_obj_add_style(details_box, &theme_font_14, 0);
+    lv_obj_add_style(details_box, &info_block_style, 0);
+    for (int i = 0; i < DETAIL_POOL_SIZE; i++) {
+        detail_rows[i] = lv_label_create(details_box);
+        lv_obj_add_style(detail_rows[i], &detail_row_style, 0);
+        lv_label_set_long_mode(detail_rows[i], LV_LABEL_LONG_CLIP);
+        lv_obj_add_flag(detail_rows[i], LV_OBJ_FLAG_HIDDEN);
+        detail_bound[i] = -1;
+    }
+    lv_obj_add_event_cb(info_scroll_cont, info_scroll_event_cb, LV_EVENT_SCROLL, NULL);
+
+    // QR code for the GitHub repository, rendered once and shared by every rebuild
+    lv_obj_t *qr_code = lv_image_create(cont);
+    lv_image_set_src(qr_code, github_qr_image());
+    lv_obj_add_style(qr_code, &info_block_style, 0);
 
     // Add QR code description
     lv_obj_t *qr_desc = lv_label_create(cont);
     lv_label_set_text(qr_desc, "Scan QR Code to visit GitHub Repository");
-    lv_obj_set_style_text_font(qr_desc, &lv_font_montserrat_12, 0);
-    lv_obj_set_style_text_color(qr_desc, lv_color_hex(0x808080), 0);
-    lv_obj_set_width(qr_desc, lv_pct(100));
-    lv_obj_set_style_text_align(qr_desc, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_margin_bottom(qr_desc, 20, 0);
-    lv_obj_set_style_text_font(details_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(details_label, TEXT_COLOR, 0);
-    lv_obj_set_width(details_label, lv_pct(100));
-    lv_obj_set_style_margin_top(details_label, 20, 0);
+    lv_obj_add_style(qr_desc, &theme_text_muted, 0);
+    lv_obj_add_style(qr_desc, &theme_font_12, 0);
+    lv_obj_add_style(qr_desc, &theme_text_center, 0);
 
     lv_obj_t *hint_label = lv_label_create(cont);
     lv_label_set_text(hint_label, "Click to scroll down\nScroll to bottom to continue");
-    lv_obj_set_style_text_font(hint_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(hint_label, lv_color_hex(0x808080), 0);
-    lv_obj_set_width(hint_label, lv_pct(100));
-    lv_obj_set_style_text_align(hint_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_margin_top(hint_label, 20, 0);
-    lv_obj_set_style_margin_bottom(hint_label, 30, 0); // Add bottom margin for easier scrolling
+    lv_obj_add_style(hint_label, &theme_text_muted, 0);
+    lv_obj_add_style(hint_label, &theme_font_14, 0);
+    lv_obj_add_style(hint_label, &theme_text_center, 0);
+    lv_obj_add_style(hint_label, &info_block_style, 0);
     
     // Add a bottom indicator to show when scrolling is complete
     lv_obj_t *bottom_indicator = lv_label_create(cont);
     lv_label_set_text(bottom_indicator, "You've reached the bottom\nClick again to continue");
-    lv_obj_set_style_text_font(bottom_indicator, &lv_font_montserrat_16, 0);
-    lv_obj_set_style_text_color(bottom_indicator, ACCENT_COLOR, 0);
-    lv_obj_set_width(bottom_indicator, lv_pct(100));
-    lv_obj_set_style_text_align(bottom_indicator, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_margin_top(bottom_indicator, 20, 0);
-    lv_obj_set_style_margin_bottom(bottom_indicator, 20, 0);
-
-    // NEW: Create a timer specifically for this page
-    info_page_timer = lv_timer_create(info_page_timer_cb, TIMER_INTERVAL_MS, NULL);
+    lv_obj_add_style(bottom_indicator, &theme_text_accent, 0);
+    lv_obj_add_style(bottom_indicator, &theme_font_16, 0);
+    lv_obj_add_style(bottom_indicator, &theme_text_center, 0);
+    lv_obj_add_style(bottom_indicator, &info_block_style, 0);
+
+    // Bind the first screenful of detail lines
+    lv_obj_update_layout(info_screen);
+    bind_detail_rows();
+
+    return info_screen;
 }
 
 /**
  * @brief Creates the "About" page (the main page)
  */
-static void create_about_page(void)
+static lv_obj_t *create_about_page(void)
 {
     about_screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(about_screen, BG_COLOR, 0);
-    lv_obj_set_style_pad_all(about_screen, 20, 0);
+    lv_obj_add_style(about_screen, &theme_page, 0);
 
     lv_obj_t *about_label = lv_label_create(about_screen);
     lv_label_set_text(about_label, "About");
-    lv_obj_set_style_text_font(about_label, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(about_label, TEXT_COLOR, 0);
+    lv_obj_add_style(about_label, &theme_text, 0);
+    lv_obj_add_style(about_label, &theme_font_28, 0);
     lv_obj_align(about_label, LV_ALIGN_TOP_LEFT, 0, 0);
 
     lv_obj_t *arrow_icon = lv_label_create(about_screen);
     lv_label_set_text(arrow_icon, LV_SYMBOL_RIGHT);
-    lv_obj_set_style_text_font(arrow_icon, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(arrow_icon, TEXT_COLOR, 0);
+    lv_obj_add_style(arrow_icon, &theme_text, 0);
+    lv_obj_add_style(arrow_icon, &theme_font_28, 0);
     lv_obj_align(arrow_icon, LV_ALIGN_TOP_RIGHT, 0, 0);
 
     progress_bar = lv_bar_create(about_screen);
     lv_obj_set_size(progress_bar, lv_pct(100), 10);
     lv_obj_align(progress_bar, LV_ALIGN_CENTER, 0, 0);
-    lv_bar_set_range(progress_bar, 0, LONG_PRESS_DURATION_MS);
+    lv_bar_set_range(progress_bar, 0, BUTTON_LONG_PRESS_MS);
     lv_bar_set_value(progress_bar, 0, LV_ANIM_OFF);
 
-    lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0xE0E0E0), LV_PART_MAIN);
-    lv_obj_set_style_radius(progress_bar, 5, 0);
-    lv_obj_set_style_bg_color(progress_bar, ACCENT_COLOR, LV_PART_INDICATOR);
+    lv_obj_add_style(progress_bar, &theme_bar, LV_PART_MAIN);
+    lv_obj_add_style(progress_bar, &theme_bar_accent, LV_PART_INDICATOR);
     lv_obj_add_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
 
     lv_obj_t *hint_label = lv_label_create(about_screen);
     lv_label_set_text(hint_label, "Long Press to Enter");
     lv_obj_align(hint_label, LV_ALIGN_BOTTOM_MID, 0, 0);
-    lv_obj_set_style_text_font(hint_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(hint_label, lv_color_hex(0x808080), 0);
+    lv_obj_add_style(hint_label, &theme_text_muted, 0);
+    lv_obj_add_style(hint_label, &theme_font_14, 0);
+
+    return about_screen;
 }
 
 
 /**
- * @brief Timer callback for the "About" page ONLY.
+ * @brief Page lifecycle hooks. Both screens stay cached by the page manager,
+ * so showing a page only resets its transient state.
  */
-static void about_page_timer_cb(lv_timer_t *timer)
+static void about_on_show(void)
 {
-    if (is_button_pressed(BUTTON_PIN)) {
-        if (ignore_initial_press) {
-            return; // Wait for the button release that initiated this page load
-        }
-        press_duration += TIMER_INTERVAL_MS;
-        if (press_duration > CLICK_DURATION_MS_MAX) {
-            lv_obj_clear_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
-            lv_bar_set_value(progress_bar, press_duration, LV_ANIM_OFF);
-        }
-        if (press_duration >= LONG_PRESS_DURATION_MS) {
-            cleanup_about_page();
-            cleanup_info_page();
-            // 进入Info页面前重置状态，保证下次还能进入
-            press_duration = 0;
-            ignore_initial_press = true;
-            create_info_page();
-            lv_scr_load(info_screen);
-        }
-    } else { // Button is released
-        if (ignore_initial_press) {
-            ignore_initial_press = false;
-            press_duration = 0;
-            return;
-        }
-        if (press_duration > 0 && press_duration <= CLICK_DURATION_MS_MAX) {
-            cleanup_about_page();
-            cleanup_info_page();
-            // 单击时跳转到dashboard，并重置状态
-            press_duration = 0;
-            ignore_initial_press = true;
-            Page_Reset();
-            Serial.println("Click detected, navigating to Reset Page.");
-            return;
-        }
-        press_duration = 0;
-        lv_bar_set_value(progress_bar, 0, LV_ANIM_OFF);
-        lv_obj_add_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
+    lv_bar_set_value(progress_bar, 0, LV_ANIM_OFF);
+    lv_obj_add_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
+    // 若按键仍按着 (从上一页带过来的按压), 引擎会等它松开后才派发事件
+    ButtonInput_SetHandler(about_page_button_cb, false);
+}
+
+static void about_on_destroy(void)
+{
+    about_screen = NULL;
+    progress_bar = NULL;
+}
+
+static void info_on_show(void)
+{
+    lv_obj_scroll_to_y(info_scroll_cont, 0, LV_ANIM_OFF);
+    bind_detail_rows();
+    ButtonInput_SetHandler(info_page_button_cb, false);
+}
+
+static void info_on_destroy(void)
+{
+    info_screen = NULL;
+    info_scroll_cont = NULL;
+    details_box = NULL;
+    for (int i = 0; i < DETAIL_POOL_SIZE; i++) {
+        detail_rows[i] = NULL;
     }
 }
 
+const page_desc_t ABOUT_PAGE = {
+    "about", create_about_page, about_on_show, NULL, about_on_destroy, false
+};
+const page_desc_t INFO_PAGE = {
+    "info", create_info_page, info_on_show, NULL, info_on_destroy, false
+};
+
+
 /**
- * @brief NEW: Timer callback for the "Info" page ONLY.
- * Modified to support click-to-scroll and proceed when at bottom.
+ * @brief Button event handler for the "About" page ONLY.
  */
-static void info_page_timer_cb(lv_timer_t *timer) {
-    static info_page_input_state_t current_state = STATE_WAIT_FOR_INITIAL_RELEASE;
-    bool is_pressed_now = is_button_pressed(BUTTON_PIN);
-    
-    switch (current_state) {
-        case STATE_WAIT_FOR_INITIAL_RELEASE:
-            if (!is_pressed_now) {
-                current_state = STATE_READY_FOR_CLICK;
+static void about_page_button_cb(const button_event_t *event)
+{
+    switch (event->type) {
+        case BUTTON_EVENT_LONG_PRESS_PROGRESS:
+            if (event->held_ms > BUTTON_CLICK_MAX_MS) {
+                lv_obj_clear_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
+                lv_bar_set_value(progress_bar, event->held_ms, LV_ANIM_OFF);
             }
             break;
-            
-        case STATE_READY_FOR_CLICK:
-            if (is_pressed_now) {
-                current_state = STATE_BUTTON_IS_PRESSED;
-            }
+
+        case BUTTON_EVENT_LONG_PRESS:
+            Router_Navigate(NAV_ENTER);
             break;
-            
-        case STATE_BUTTON_IS_PRESSED:
-            if (!is_pressed_now) {
-                current_state = STATE_READY_FOR_CLICK;
-                
-                // Check if we're at the bottom of the scroll
-                lv_coord_t scroll_y = lv_obj_get_scroll_y(info_scroll_cont);
-                lv_coord_t scroll_bottom = lv_obj_get_scroll_bottom(info_scroll_cont);
-                
-                Serial.print("Scroll Y: ");
-                Serial.print(scroll_y);
-                Serial.print(", Scroll Bottom: ");
-                Serial.println(scroll_bottom);
-                
-                if (scroll_bottom <= 10) { // Allow 10px tolerance for bottom detection
-                    // At bottom, proceed to next page
-                    current_state = STATE_WAIT_FOR_INITIAL_RELEASE;
-                    cleanup_info_page();
-                    cleanup_about_page();
-                    Page_About();
-                    Serial.println("Reached bottom, returning to About page.");
-                    return;
-                } else {
-                    // Not at bottom, scroll down by a screen-relative amount
-                    lv_coord_t screen_height = lv_obj_get_height(info_scroll_cont);
-                    lv_coord_t scroll_step = (screen_height * 2) / 3; // Scroll by 2/3 of screen height (加速)
-                    lv_coord_t current_scroll = lv_obj_get_scroll_y(info_scroll_cont);
-                    
-                    // Ensure we don't scroll past the bottom
-                    lv_coord_t max_scroll = lv_obj_get_scroll_bottom(info_scroll_cont) + current_scroll;
-                    lv_coord_t target_scroll = current_scroll + scroll_step;
-                    if (target_scroll > max_scroll) {
-                        target_scroll = max_scroll;
-                    }
-                    
-                    lv_obj_scroll_to_y(info_scroll_cont, target_scroll, LV_ANIM_ON);
-                    Serial.println("Scrolling down...");
-                }
-            }
+
+        case BUTTON_EVENT_CLICK:
+            // 单击时跳转到Reset页面
+            Router_Navigate(NAV_NEXT);
+            Serial.println("Click detected, navigating to Reset Page.");
             break;
-    }
-}
 
+        case BUTTON_EVENT_RELEASE:
+            lv_bar_set_value(progress_bar, 0, LV_ANIM_OFF);
+            lv_obj_add_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
+            break;
 
-/**
- * @brief Cleans up all resources used by the "About" page.
- */
-static void cleanup_about_page(void)
-{
-    if (about_page_timer) {
-        lv_timer_del(about_page_timer);
-        about_page_timer = NULL;
-    }
-    if (about_screen) {
-        lv_obj_del(about_screen);
-        about_screen = NULL;
-        progress_bar = NULL;
+        default:
+            break;
     }
-    // 确保全局状态变量重置
-    press_duration = 0;
-    ignore_initial_press = true;
 }
 
 /**
- * @brief NEW: Cleans up all resources used by the "Info" page.
+ * @brief Button event handler for the "Info" page ONLY.
+ * Each press-and-release scrolls down, or returns to About when at the bottom.
  */
-static void cleanup_info_page(void)
-{
-    if (info_page_timer) {
-        lv_timer_del(info_page_timer);
-        info_page_timer = NULL;
-    }
-    if (info_screen) {
-        lv_obj_del(info_screen);
-        info_screen = NULL;
-        info_scroll_cont = NULL; // Reset scroll container reference
+static void info_page_button_cb(const button_event_t *event) {
+    if (event->type != BUTTON_EVENT_RELEASE) {
+        return;
     }
-    // 确保全局状态变量重置
-    press_duration = 0;
-    ignore_initial_press = true;
-}
 
+    // Check if we're at the bottom of the scroll
+    lv_coord_t scroll_y = lv_obj_get_scroll_y(info_scroll_cont);
+    lv_coord_t scroll_bottom = lv_obj_get_scroll_bottom(info_scroll_cont);
+
+    Serial.print("Scroll Y: ");
+    Serial.print(scroll_y);
+    Serial.print(", Scroll Bottom: ");
+    Serial.println(scroll_bottom);
+
+    if (scroll_bottom <= 10) { // Allow 10px tolerance for bottom detection
+        // At bottom, proceed to next page
+        Router_Navigate(NAV_BACK);
+        Serial.println("Reached bottom, returning to About page.");
+    } else {
+        // Not at bottom, scroll down by a screen-relative amount
+        lv_coord_t screen_height = lv_obj_get_height(info_scroll_cont);
+        lv_coord_t scroll_step = (screen_height * 2) / 3; // Scroll by 2/3 of screen height (加速)
+        lv_coord_t current_scroll = lv_obj_get_scroll_y(info_scroll_cont);
+
+        // Ensure we don't scroll past the bottom
+        lv_coord_t max_scroll = lv_obj_get_scroll_bottom(info_scroll_cont) + current_scroll;
+        lv_coord_t target_scroll = current_scroll + scroll_step;
+        if (target_scroll > max_scroll) {
+            target_scroll = max_scroll;
+        }
 
-/**
- * @brief Entry function for the "About" page.
- */
-void Page_About(void)
-{
-    // 切换前先清理Info页面，防止状态残留
-    cleanup_info_page();
-    // 进入About页面时强制重置状态变量，保证长按和单击都能正常响应
-    press_duration = 0;
-    ignore_initial_press = true;
-    create_about_page();
-    lv_scr_load(about_screen);
-    about_page_timer = lv_timer_create(about_page_timer_cb, TIMER_INTERVAL_MS, NULL);
+        lv_obj_scroll_to_y(info_scroll_cont, target_scroll, LV_ANIM_ON);
+        Serial.println("Scrolling down...");
+    }
 }
 
-/**
- * @brief Checks if the button is pressed.
- */
-static bool is_button_pressed(int pin_number)
-{
-    return (digitalRead(pin_number) == LOW);
-}
\ No newline at end of file
@@ -1,118 +1,117 @@
 #include "Pages.h"
+#include "ButtonInput.h"
+#include "TimeService.h"
+#include "Router.h"
+#include "Theme.h"
 #include "lvgl.h"
 #include <Arduino.h>
 #include <WiFi.h>
 #include <time.h>
+#include <sys/time.h>
 
-// --- Color Definitions (Light Theme) ---
-static const lv_color_t BG_COLOR = lv_color_hex(0xF8F9FA);      // Very light gray background
-static const lv_color_t TEXT_COLOR = lv_color_hex(0x2C3E50);    // Dark blue-gray text
-static const lv_color_t ACCENT_COLOR = lv_color_hex(0x3498DB);  // Blue accent
+// --- Color Definitions (only the clock uses these; the rest are in Theme.h) ---
 static const lv_color_t TIME_COLOR = lv_color_hex(0x1A1A1A);    // Almost black for time
 static const lv_color_t DATE_COLOR = lv_color_hex(0x5D6D7E);    // Gray for date
-static const lv_color_t BORDER_COLOR = lv_color_hex(0xE8E8E8);  // Light border
 
 // --- Global Static Variables ---
 static lv_obj_t *clock_screen;    // The clock page screen object
-static lv_obj_t *time_label;      // Time display label
+static lv_obj_t *digit_labels[6]; // One label per time digit (HH MM SS)
 static lv_obj_t *date_label;      // Date display label
-static lv_obj_t *status_label;    // Status label for NTP sync
+static lv_obj_t *status_label;    // Time sync status label
 static lv_timer_t *clock_timer;   // Timer for clock updates
-static lv_timer_t *input_timer;   // Timer for input handling
 
-// NTP and time variables
-static bool ntp_synced = false;
-static bool ntp_initializing = false;
-static unsigned long last_ntp_sync = 0;
-static unsigned long ntp_init_start = 0;
-static const unsigned long NTP_SYNC_INTERVAL = 3600000; // Sync every hour
-static const unsigned long NTP_INIT_TIMEOUT = 10000; // 10 seconds timeout for initial sync
+// What is currently on screen; widgets are only touched when these change
+typedef enum {
+    CLOCK_STATUS_NONE = -1,
+    CLOCK_STATUS_WAITING,
+    CLOCK_STATUS_WIFI_DOWN,
+    CLOCK_STATUS_SYNCED
+} clock_status_t;
 
-// Input handling variables
-static int press_duration = 0;
-static bool ignore_initial_press = true;
+static char shown_digits[6];            // Character currently in each digit label
+static int shown_yday = -1;             // -1 = placeholder date shown
+static clock_status_t shown_status = CLOCK_STATUS_NONE;
+static int shown_dots = -1;
 
 // --- Constants ---
-const int TIMER_INTERVAL_MS = 20;        // Input timer polling interval (ms)
-const int CLOCK_UPDATE_INTERVAL_MS = 100; // Clock update interval (ms)
-const int CLICK_DURATION_MS_MAX = 300;   // Maximum duration for a single click (ms)
-
-// NTP server configuration
-const char* ntpServer = "pool.ntp.org";
-const long gmtOffset_sec = 8 * 3600;     // GMT+8 for China
-const int daylightOffset_sec = 0;        // No daylight saving
+const int CLOCK_DIGIT_COUNT = 6;
+const int CLOCK_INIT_POLL_MS = 250;     // Poll interval until the time service has synced
+const int CLOCK_TICK_SLACK_MS = 2;      // Wake slightly after the second boundary
 
 // --- Forward Declarations ---
-static void create_clock_page(void);
+static lv_obj_t *create_clock_page(void);
 static void clock_update_timer_cb(lv_timer_t *timer);
-static void clock_input_timer_cb(lv_timer_t *timer);
-static void cleanup_clock_page(void);
-static bool is_button_pressed(int pin_number);
-static void init_ntp_time(void);
+static void clock_button_cb(const button_event_t *event);
 static void update_time_display(void);
 static void update_status_display(void);
 
-// --- NTP Time Functions ---
+// --- Time Functions ---
 
-static void init_ntp_time(void)
+// Milliseconds until just after the next wall-clock second
+static uint32_t ms_to_next_second(void)
 {
-    if (WiFi.status() == WL_CONNECTED && !ntp_initializing) {
-        Serial.println("Starting NTP time initialization...");
-        ntp_initializing = true;
-        ntp_init_start = millis();
-        configTime(gmtOffset_sec, daylightOffset_sec, ntpServer);
-        Serial.println("NTP initialization started, waiting for sync...");
-    }
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return 1000 - tv.tv_usec / 1000 + CLOCK_TICK_SLACK_MS;
 }
 
-static void check_ntp_sync_status(void)
+static void set_digit(int index, char digit)
 {
-    if (!ntp_initializing) {
-        return;
-    }
-    
-    struct tm timeinfo;
-    if (getLocalTime(&timeinfo)) {
-        // NTP sync successful
-        ntp_synced = true;
-        ntp_initializing = false;
-        last_ntp_sync = millis();
-        Serial.println("NTP time synchronized successfully");
-    } else if (millis() - ntp_init_start > NTP_INIT_TIMEOUT) {
-        // Timeout reached
-        ntp_initializing = false;
-        ntp_synced = false;
-        Serial.println("NTP initialization timeout");
+    if (shown_digits[index] == digit) {
+        return; // Unchanged digit: nothing to invalidate
     }
-    // If neither condition is met, still initializing
+    shown_digits[index] = digit;
+    char text[2] = { digit, '\0' };
+    lv_label_set_text(digit_labels[index], text);
 }
 
 static void update_time_display(void)
 {
     struct tm timeinfo;
-    static char time_str[16];
-    static char date_str[32];
     
-    if (ntp_synced && getLocalTime(&timeinfo)) {
-        // Format time as HH:MM:SS
-        strftime(time_str, sizeof(time_str), "%H:%M:%S", &timeinfo);
-        
-        // Format date
-        strftime(date_str, sizeof(date_str), "%Y-%m-%d", &timeinfo);
+    // Restored time is shown right away; the time service corrects it once synced
+    if (TimeService_LocalTime(&timeinfo)) {
+        // HH:MM:SS, one label per digit so a normal tick redraws a single glyph
+        int fields[3] = { timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec };
+        for (int i = 0; i < 3; i++) {
+            set_digit(i * 2, '0' + fields[i] / 10);
+            set_digit(i * 2 + 1, '0' + fields[i] % 10);
+        }
         
-        // Update labels
-        lv_label_set_text(time_label, time_str);
-        lv_label_set_text(date_label, date_str);
+        // The date only changes once a day
+        if (timeinfo.tm_yday != shown_yday) {
+            char date_str[32];
+            strftime(date_str, sizeof(date_str), "%Y-%m-%d", &timeinfo);
+            lv_label_set_text(date_label, date_str);
+            shown_yday = timeinfo.tm_yday;
+        }
     } else {
-        lv_label_set_text(time_label, "--:--:--");
-        lv_label_set_text(date_label, "----/--/--");
+        for (int i = 0; i < CLOCK_DIGIT_COUNT; i++) {
+            set_digit(i, '-');
+        }
+        if (shown_yday != -1) {
+            lv_label_set_text(date_label, "----/--/--");
+            shown_yday = -1;
+        }
     }
 }
 
 static void update_status_display(void)
 {
-    if (ntp_initializing) {
-        // Show animated dots while initializing
+    static const uint32_t STATUS_COLORS[] = {
+        0xF39C12, // Waiting: orange
+        0xE74C3C, // WiFi disconnected: red
+        0x27AE60  // Synced: green
+    };
+
+    clock_status_t status;
+    int dots = 0;
+    if (TimeService_Quality() == TIME_SYNCED) {
+        status = CLOCK_STATUS_SYNCED;
+    } else if (WiFi.status() != WL_CONNECTED) {
+        status = CLOCK_STATUS_WIFI_DOWN;
+    } else {
+        // Show animated dots while the time service is syncing
         static int dot_count = 0;
         static unsigned long last_dot_update = 0;
         unsigned long now = millis();
@@ -121,34 +120,44 @@ static void update_status_display(void)
             last_dot_update = now;
             dot_count = (dot_count + 1) % 4; // 0, 1, 2, 3, then back to 0
         }
-        
-        char status_text[32];
-        strcpy(status_text, "Please wait");
-        for (int i = 0; i < dot_count; i++) {
-            strcat(status_text, ".");
+        status = CLOCK_STATUS_WAITING;
+        dots = dot_count;
+    }
+
+    if (status == shown_status && dots == shown_dots) {
+        return;
+    }
+    if (status != shown_status) {
+        lv_obj_set_style_text_color(status_label, lv_color_hex(STATUS_COLORS[status]), 0);
+    }
+    shown_status = status;
+    shown_dots = dots;
+
+    switch (status) {
+        case CLOCK_STATUS_WAITING: {
+            char status_text[32];
+            strcpy(status_text, "Please wait");
+            for (int i = 0; i < dots; i++) {
+                strcat(status_text, ".");
+            }
+            lv_label_set_text(status_label, status_text);
+            break;
         }
-        
-        lv_label_set_text(status_label, status_text);
-        lv_obj_set_style_text_color(status_label, lv_color_hex(0xF39C12), 0); // Orange for loading
-    } else if (WiFi.status() != WL_CONNECTED) {
-        lv_label_set_text(status_label, "WiFi Disconnected");
-        lv_obj_set_style_text_color(status_label, lv_color_hex(0xE74C3C), 0);
-    } else if (!ntp_synced) {
-        lv_label_set_text(status_label, "Time Not Synced");
-        lv_obj_set_style_text_color(status_label, lv_color_hex(0xF39C12), 0);
-    } else {
-        lv_label_set_text(status_label, "Time Synchronized");
-        lv_obj_set_style_text_color(status_label, lv_color_hex(0x27AE60), 0);
+        case CLOCK_STATUS_WIFI_DOWN:
+            lv_label_set_text(status_label, "WiFi Disconnected");
+            break;
+        default:
+            lv_label_set_text(status_label, "Time Synchronized");
+            break;
     }
 }
 
 // --- UI Creation Functions ---
 
-static void create_clock_page(void)
+static lv_obj_t *create_clock_page(void)
 {
     clock_screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(clock_screen, BG_COLOR, 0);
-    lv_obj_set_style_pad_all(clock_screen, 20, 0);
+    lv_obj_add_style(clock_screen, &theme_page_cool, 0);
 
     // Title with back arrow
     lv_obj_t *title_container = lv_obj_create(clock_screen);
@@ -160,168 +169,144 @@ static void create_clock_page(void)
 
     lv_obj_t *title_label = lv_label_create(title_container);
     lv_label_set_text(title_label, "Clock");
-    lv_obj_set_style_text_font(title_label, &lv_font_montserrat_24, 0);
-    lv_obj_set_style_text_color(title_label, TEXT_COLOR, 0);
+    lv_obj_add_style(title_label, &theme_text_cool, 0);
+    lv_obj_add_style(title_label, &theme_font_24, 0);
 
     // Back arrow (click to return to dashboard)
     lv_obj_t *arrow_icon = lv_label_create(title_container);
     lv_label_set_text(arrow_icon, LV_SYMBOL_RIGHT);
-    lv_obj_set_style_text_font(arrow_icon, &lv_font_montserrat_24, 0);
-    lv_obj_set_style_text_color(arrow_icon, ACCENT_COLOR, 0);
+    lv_obj_add_style(arrow_icon, &theme_text_accent, 0);
+    lv_obj_add_style(arrow_icon, &theme_font_24, 0);
 
     // Main clock container
     lv_obj_t *clock_container = lv_obj_create(clock_screen);
     lv_obj_set_size(clock_container, lv_pct(90), lv_pct(60));
     lv_obj_align(clock_container, LV_ALIGN_CENTER, 0, -10);
-    lv_obj_set_style_bg_color(clock_container, lv_color_white(), 0);
-    lv_obj_set_style_border_color(clock_container, BORDER_COLOR, 0);
-    lv_obj_set_style_border_width(clock_container, 2, 0);
-    lv_obj_set_style_radius(clock_container, 12, 0);
-    lv_obj_set_style_shadow_width(clock_container, 8, 0);
-    lv_obj_set_style_shadow_color(clock_container, lv_color_hex(0x000000), 0);
-    lv_obj_set_style_shadow_opa(clock_container, LV_OPA_10, 0);
-
-    // Time display (large)
-    time_label = lv_label_create(clock_container);
-    lv_label_set_text(time_label, "--:--:--");
-    lv_obj_set_style_text_font(time_label, &lv_font_montserrat_48, 0);
-    lv_obj_set_style_text_color(time_label, TIME_COLOR, 0);
-    lv_obj_align(time_label, LV_ALIGN_CENTER, 0, -20);
+    lv_obj_add_style(clock_container, &theme_card, 0);
+
+    // Time display (large): fixed-width digit cells, so a changing digit
+    // neither shifts its neighbours nor invalidates more than its own cell
+    // The cell width depends only on the font, so the style is shared by all
+    // six digits and kept across rebuilds
+    static lv_style_t digit_cell_style;
+    static bool digit_style_inited = false;
+    if (!digit_style_inited) {
+        const lv_font_t *time_font = &lv_font_montserrat_48;
+        int32_t cell_width = lv_font_get_glyph_width(time_font, '-', 0);
+        for (char c = '0'; c <= '9'; c++) {
+            int32_t w = lv_font_get_glyph_width(time_font, c, 0);
+            if (w > cell_width) {
+                cell_width = w;
+            }
+        }
+        lv_style_init(&digit_cell_style);
+        lv_style_set_width(&digit_cell_style, cell_width);
+        lv_style_set_text_align(&digit_cell_style, LV_TEXT_ALIGN_CENTER);
+        digit_style_inited = true;
+    }
+
+    lv_obj_t *time_row = lv_obj_create(clock_container);
+    lv_obj_remove_style_all(time_row);
+    lv_obj_set_size(time_row, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(time_row, LV_FLEX_FLOW_ROW);
+    lv_obj_add_style(time_row, &theme_font_48, 0);
+    lv_obj_set_style_text_color(time_row, TIME_COLOR, 0); // Inherited by the digits and colons
+    lv_obj_align(time_row, LV_ALIGN_CENTER, 0, -20);
+
+    for (int i = 0; i < CLOCK_DIGIT_COUNT; i++) {
+        if (i == 2 || i == 4) {
+            lv_obj_t *colon = lv_label_create(time_row);
+            lv_label_set_text(colon, ":");
+        }
+        digit_labels[i] = lv_label_create(time_row);
+        lv_label_set_text(digit_labels[i], "-");
+        lv_obj_add_style(digit_labels[i], &digit_cell_style, 0);
+        shown_digits[i] = '-';
+    }
 
     // Date display (medium)
     date_label = lv_label_create(clock_container);
     lv_label_set_text(date_label, "----/--/--");
-    lv_obj_set_style_text_font(date_label, &lv_font_montserrat_20, 0);
+    shown_yday = -1;
+    lv_obj_add_style(date_label, &theme_font_20, 0);
     lv_obj_set_style_text_color(date_label, DATE_COLOR, 0);
     lv_obj_align(date_label, LV_ALIGN_CENTER, 0, 25);
 
     // Status display
     status_label = lv_label_create(clock_screen);
     lv_label_set_text(status_label, "Please wait...");
-    lv_obj_set_style_text_font(status_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(status_label, lv_color_hex(0xF39C12), 0); // Orange for loading
+    lv_obj_add_style(status_label, &theme_font_14, 0);
+    shown_status = CLOCK_STATUS_NONE; // Force the first status update, which also sets the colour
     lv_obj_align(status_label, LV_ALIGN_BOTTOM_MID, 0, -10);
 
     // Hint text
     lv_obj_t *hint_label = lv_label_create(clock_screen);
     lv_label_set_text(hint_label, "Click to go to Noodle Timer");
-    lv_obj_set_style_text_font(hint_label, &lv_font_montserrat_12, 0);
-    lv_obj_set_style_text_color(hint_label, lv_color_hex(0x808080), 0);
+    lv_obj_add_style(hint_label, &theme_text_muted, 0);
+    lv_obj_add_style(hint_label, &theme_font_12, 0);
     lv_obj_align(hint_label, LV_ALIGN_BOTTOM_MID, 0, 15);
 
-    // Initialize NTP
-    init_ntp_time();
-    
-    // Update displays
-    update_time_display();
-    update_status_display();
+    // Runs only while the page is shown
+    clock_timer = lv_timer_create(clock_update_timer_cb, CLOCK_INIT_POLL_MS, NULL);
+    lv_timer_pause(clock_timer);
+
+    return clock_screen;
 }
 
 // --- Timer Callbacks ---
 
 static void clock_update_timer_cb(lv_timer_t *timer)
 {
-    // Check NTP sync status if initializing
-    if (ntp_initializing) {
-        check_ntp_sync_status();
-    }
-    
-    // Check if we need to re-sync NTP
-    if (!ntp_initializing && millis() - last_ntp_sync > NTP_SYNC_INTERVAL && WiFi.status() == WL_CONNECTED) {
-        init_ntp_time();
-    }
-    
-    // Update time display
+    // Both only touch the widgets whose content changed
     update_time_display();
-    
-    // Update status display more frequently during initialization
-    static int status_update_counter = 0;
-    int update_frequency = ntp_initializing ? 2 : 50; // Every 200ms during init, every 5s normally
-    
-    if (++status_update_counter >= update_frequency) {
-        update_status_display();
-        status_update_counter = 0;
-    }
+    update_status_display();
+
+    // Poll while the time service is syncing, otherwise sleep until the next second boundary
+    bool synced = TimeService_Quality() == TIME_SYNCED;
+    lv_timer_set_period(timer, synced ? ms_to_next_second() : CLOCK_INIT_POLL_MS);
 }
 
-static void clock_input_timer_cb(lv_timer_t *timer)
+static void clock_button_cb(const button_event_t *event)
 {
-    if (is_button_pressed(BUTTON_PIN)) {
-        if (ignore_initial_press) {
-            return;
-        }
-        press_duration += TIMER_INTERVAL_MS;
-    } else { // Button is released
-        if (ignore_initial_press) {
-            ignore_initial_press = false;
-            press_duration = 0;
-            return;
-        }
-        // Single click navigates to instant noodle countdown
-        if (press_duration > 0 && press_duration <= CLICK_DURATION_MS_MAX) {
-            cleanup_clock_page();
-            Page_InstantNoodleCountDown();
-            Serial.println("Click detected, navigating to Instant Noodle Countdown.");
-            return;
-        }
-        // Reset press duration
-        press_duration = 0;
+    // Single click navigates to instant noodle countdown
+    if (event->type == BUTTON_EVENT_CLICK) {
+        Router_Navigate(NAV_NEXT);
+        Serial.println("Click detected, navigating to Instant Noodle Countdown.");
     }
 }
 
-// --- Cleanup Functions ---
+// --- Page Lifecycle ---
 
-static void cleanup_clock_page(void)
+static void clock_on_show(void)
 {
-    if (clock_timer) {
-        lv_timer_del(clock_timer);
-        clock_timer = NULL;
-    }
-    if (input_timer) {
-        lv_timer_del(input_timer);
-        input_timer = NULL;
-    }
-    if (clock_screen) {
-        lv_obj_del(clock_screen);
-        clock_screen = NULL;
-        time_label = NULL;
-        date_label = NULL;
-        status_label = NULL;
-    }
-    
-    // Reset NTP state
-    ntp_initializing = false;
-    ntp_synced = false;
-    
-    press_duration = 0;
-    ignore_initial_press = true;
-}
+    // Normally already running since boot; this only covers the first-setup flow
+    TimeService_Begin();
 
-// --- Public Page Entry Function ---
+    // A cached page still shows the time it was left at; catch up right away
+    update_time_display();
+    update_status_display();
+    lv_timer_resume(clock_timer);
+    lv_timer_ready(clock_timer);
+    ButtonInput_SetHandler(clock_button_cb, false);
+}
 
-void Page_Clock(void)
+static void clock_on_hide(void)
 {
-    // Clean up any existing pages
-    cleanup_clock_page();
-    
-    // Reset state variables
-    press_duration = 0;
-    ignore_initial_press = true;
-    
-    // Create the clock page
-    create_clock_page();
-    lv_scr_load(clock_screen);
-    
-    // Start timers
-    clock_timer = lv_timer_create(clock_update_timer_cb, CLOCK_UPDATE_INTERVAL_MS, NULL);
-    input_timer = lv_timer_create(clock_input_timer_cb, TIMER_INTERVAL_MS, NULL);
-    
-    Serial.println("Clock page loaded");
+    lv_timer_pause(clock_timer);
 }
 
-// --- Helper Functions ---
-
-static bool is_button_pressed(int pin_number)
+static void clock_on_destroy(void)
 {
-    return (digitalRead(pin_number) == LOW);
+    lv_timer_del(clock_timer);
+    clock_timer = NULL;
+    clock_screen = NULL;
+    for (int i = 0; i < CLOCK_DIGIT_COUNT; i++) {
+        digit_labels[i] = NULL;
+    }
+    date_label = NULL;
+    status_label = NULL;
 }
+
+const page_desc_t CLOCK_PAGE = {
+    "clock", create_clock_page, clock_on_show, clock_on_hide, clock_on_destroy, false
+};
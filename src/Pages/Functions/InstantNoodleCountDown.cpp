@@ -1,19 +1,13 @@
 #include "Pages.h"
+#include "ButtonInput.h"
+#include "Router.h"
+#include "Theme.h"
 #include "lvgl.h"
 #include <Arduino.h>
 
 // --- Pin Definitions ---
 #define BUZZER_PIN 3
 
-// --- Color Definitions (Light Theme) ---
-static const lv_color_t BG_COLOR = lv_color_hex(0xF8F9FA);      // Very light gray background
-static const lv_color_t TEXT_COLOR = lv_color_hex(0x2C3E50);    // Dark blue-gray text
-static const lv_color_t ACCENT_COLOR = lv_color_hex(0x3498DB);  // Blue accent
-static const lv_color_t SUCCESS_COLOR = lv_color_hex(0x27AE60); // Green
-static const lv_color_t WARNING_COLOR = lv_color_hex(0xF39C12); // Orange
-static const lv_color_t DANGER_COLOR = lv_color_hex(0xE74C3C);  // Red
-static const lv_color_t BORDER_COLOR = lv_color_hex(0xE8E8E8);  // Light border
-
 // --- Timer States ---
 typedef enum {
     TIMER_STATE_IDLE,       // Timer is not running
@@ -22,14 +16,6 @@ typedef enum {
     TIMER_STATE_ALARMING    // Buzzer is active
 } timer_state_t;
 
-// --- Input States for State Machine ---
-typedef enum {
-    INPUT_STATE_WAIT_RELEASE,    // Waiting for button release after page entry
-    INPUT_STATE_READY,           // Ready for input
-    INPUT_STATE_PRESSING,        // Button is being pressed
-    INPUT_STATE_LONG_PRESSING    // Long press detected
-} input_state_t;
-
 // --- Global Static Variables ---
 static lv_obj_t *noodle_screen;     // The countdown page screen object
 static lv_obj_t *time_label;        // Countdown time display
@@ -40,50 +26,37 @@ static lv_obj_t *hint_label;        // Hint text
 
 // Timer management
 static lv_timer_t *countdown_timer; // Main countdown timer
-static lv_timer_t *input_timer;     // Input handling timer
 static lv_timer_t *buzzer_timer;    // Buzzer control timer
 
 // State variables
 static timer_state_t timer_state = TIMER_STATE_IDLE;
-static input_state_t input_state = INPUT_STATE_WAIT_RELEASE;
 static int countdown_seconds = 0;   // Current countdown value
-static int press_duration = 0;      // Button press duration in ms
 static bool buzzer_active = false;  // Buzzer state
 static unsigned long buzzer_start_time = 0; // When buzzer started
 static unsigned long last_countdown_update = 0; // For accurate 1-second intervals
 
 // --- Constants ---
 const int COUNTDOWN_TOTAL_SECONDS = 180;    // 3 minutes = 180 seconds
-const int TIMER_INTERVAL_MS = 20;           // Input timer interval
 const int COUNTDOWN_INTERVAL_MS = 100;      // Countdown update interval
 const int BUZZER_INTERVAL_MS = 50;          // Buzzer control interval
-const int LONG_PRESS_DURATION_MS = 1000;   // Required long press duration
-const int CLICK_DURATION_MS_MAX = 300;     // Maximum single click duration
 const int BUZZER_DURATION_MS = 30000;      // Buzzer runs for 30 seconds max
 const int BUZZER_BEEP_INTERVAL_MS = 500;   // Buzzer beep interval
 
 // --- Forward Declarations ---
-static void create_noodle_page(void);
+static lv_obj_t *create_noodle_page(void);
 static void countdown_timer_cb(lv_timer_t *timer);
-static void input_timer_cb(lv_timer_t *timer);
+static void noodle_button_cb(const button_event_t *event);
 static void buzzer_timer_cb(lv_timer_t *timer);
-static void cleanup_noodle_page(void);
 static void start_countdown(void);
 static void stop_countdown(void);
 static void start_buzzer(void);
 static void stop_buzzer(void);
 static void update_display(void);
 static void format_time(int seconds, char* buffer);
-static bool is_button_pressed(int pin_number);
 static lv_color_t get_countdown_color(int remaining_seconds);
 
 // --- Helper Functions ---
 
-static bool is_button_pressed(int pin_number)
-{
-    return (digitalRead(pin_number) == LOW);
-}
-
 static void format_time(int seconds, char* buffer)
 {
     int minutes = seconds / 60;
@@ -94,11 +67,11 @@ static void format_time(int seconds, char* buffer)
 static lv_color_t get_countdown_color(int remaining_seconds)
 {
     if (remaining_seconds > 60) {
-        return SUCCESS_COLOR;  // Green for > 1 minute
+        return THEME_COLOR_SUCCESS;  // Green for > 1 minute
     } else if (remaining_seconds > 30) {
-        return WARNING_COLOR;  // Orange for 30-60 seconds
+        return THEME_COLOR_WARNING;  // Orange for 30-60 seconds
     } else {
-        return DANGER_COLOR;   // Red for < 30 seconds
+        return THEME_COLOR_DANGER;   // Red for < 30 seconds
     }
 }
 
@@ -162,8 +135,8 @@ static void update_display(void)
         case TIMER_STATE_IDLE:
             strcpy(time_str, "03:00");
             strcpy(status_str, "Ready to cook instant noodles");
-            lv_obj_set_style_text_color(time_label, TEXT_COLOR, 0);
-            lv_obj_set_style_text_color(status_label, TEXT_COLOR, 0);
+            lv_obj_set_style_text_color(time_label, THEME_COLOR_TEXT_COOL, 0);
+            lv_obj_set_style_text_color(status_label, THEME_COLOR_TEXT_COOL, 0);
             lv_label_set_text(hint_label, "Long press to start countdown");
             break;
             
@@ -179,8 +152,8 @@ static void update_display(void)
         case TIMER_STATE_ALARMING:
             strcpy(time_str, "00:00");
             strcpy(status_str, "Instant noodles are ready!");
-            lv_obj_set_style_text_color(time_label, DANGER_COLOR, 0);
-            lv_obj_set_style_text_color(status_label, DANGER_COLOR, 0);
+            lv_obj_set_style_text_color(time_label, THEME_COLOR_DANGER, 0);
+            lv_obj_set_style_text_color(status_label, THEME_COLOR_DANGER, 0);
             lv_label_set_text(hint_label, "Long press to stop alarm");
             break;
     }
@@ -191,11 +164,14 @@ static void update_display(void)
 
 // --- UI Creation ---
 
-static void create_noodle_page(void)
+static lv_obj_t *create_noodle_page(void)
 {
+    // Initialize buzzer pin
+    pinMode(BUZZER_PIN, OUTPUT);
+    digitalWrite(BUZZER_PIN, LOW);
+
     noodle_screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(noodle_screen, BG_COLOR, 0);
-    lv_obj_set_style_pad_all(noodle_screen, 20, 0);
+    lv_obj_add_style(noodle_screen, &theme_page_cool, 0);
 
     // Title with back arrow
     lv_obj_t *title_container = lv_obj_create(noodle_screen);
@@ -207,69 +183,66 @@ static void create_noodle_page(void)
 
     lv_obj_t *title_label = lv_label_create(title_container);
     lv_label_set_text(title_label, "Instant Noodle Timer");
-    lv_obj_set_style_text_font(title_label, &lv_font_montserrat_20, 0);
-    lv_obj_set_style_text_color(title_label, TEXT_COLOR, 0);
+    lv_obj_add_style(title_label, &theme_text_cool, 0);
+    lv_obj_add_style(title_label, &theme_font_20, 0);
 
     // Back arrow (click to return to clock)
     lv_obj_t *arrow_icon = lv_label_create(title_container);
     lv_label_set_text(arrow_icon, LV_SYMBOL_RIGHT);
-    lv_obj_set_style_text_font(arrow_icon, &lv_font_montserrat_20, 0);
-    lv_obj_set_style_text_color(arrow_icon, ACCENT_COLOR, 0);
+    lv_obj_add_style(arrow_icon, &theme_text_accent, 0);
+    lv_obj_add_style(arrow_icon, &theme_font_20, 0);
 
     // Main timer container
     lv_obj_t *timer_container = lv_obj_create(noodle_screen);
     lv_obj_set_size(timer_container, lv_pct(90), lv_pct(50));
     lv_obj_align(timer_container, LV_ALIGN_CENTER, 0, -20);
-    lv_obj_set_style_bg_color(timer_container, lv_color_white(), 0);
-    lv_obj_set_style_border_color(timer_container, BORDER_COLOR, 0);
-    lv_obj_set_style_border_width(timer_container, 2, 0);
-    lv_obj_set_style_radius(timer_container, 12, 0);
-    lv_obj_set_style_shadow_width(timer_container, 8, 0);
-    lv_obj_set_style_shadow_color(timer_container, lv_color_hex(0x000000), 0);
-    lv_obj_set_style_shadow_opa(timer_container, LV_OPA_10, 0);
+    lv_obj_add_style(timer_container, &theme_card, 0);
 
     // Countdown time display (large)
     time_label = lv_label_create(timer_container);
     lv_label_set_text(time_label, "03:00");
-    lv_obj_set_style_text_font(time_label, &lv_font_montserrat_48, 0);
-    lv_obj_set_style_text_color(time_label, TEXT_COLOR, 0);
+    lv_obj_add_style(time_label, &theme_text_cool, 0);
+    lv_obj_add_style(time_label, &theme_font_48, 0);
     lv_obj_align(time_label, LV_ALIGN_CENTER, 0, -10);
 
     // Status message
     status_label = lv_label_create(timer_container);
     lv_label_set_text(status_label, "Ready to cook instant noodles");
-    lv_obj_set_style_text_font(status_label, &lv_font_montserrat_16, 0);
-    lv_obj_set_style_text_color(status_label, TEXT_COLOR, 0);
+    lv_obj_add_style(status_label, &theme_text_cool, 0);
+    lv_obj_add_style(status_label, &theme_font_16, 0);
     lv_obj_align(status_label, LV_ALIGN_CENTER, 0, 25);
 
     // Long press progress bar (initially hidden)
     progress_bar = lv_bar_create(noodle_screen);
     lv_obj_set_size(progress_bar, lv_pct(80), 8);
     lv_obj_align(progress_bar, LV_ALIGN_BOTTOM_MID, 0, -60);
-    lv_bar_set_range(progress_bar, 0, LONG_PRESS_DURATION_MS);
+    lv_bar_set_range(progress_bar, 0, BUTTON_LONG_PRESS_MS);
     lv_bar_set_value(progress_bar, 0, LV_ANIM_OFF);
-    lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0xE0E0E0), LV_PART_MAIN);
-    lv_obj_set_style_radius(progress_bar, 4, 0);
-    lv_obj_set_style_bg_color(progress_bar, ACCENT_COLOR, LV_PART_INDICATOR);
+    lv_obj_add_style(progress_bar, &theme_bar, LV_PART_MAIN);
+    lv_obj_set_style_radius(progress_bar, 4, 0); // Thinner bar, smaller radius than theme_bar
+    lv_obj_add_style(progress_bar, &theme_bar_accent, LV_PART_INDICATOR);
     lv_obj_add_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
 
     // Progress bar label (initially hidden)
     progress_label = lv_label_create(noodle_screen);
     lv_label_set_text(progress_label, "Hold to start...");
-    lv_obj_set_style_text_font(progress_label, &lv_font_montserrat_12, 0);
-    lv_obj_set_style_text_color(progress_label, ACCENT_COLOR, 0);
+    lv_obj_add_style(progress_label, &theme_text_accent, 0);
+    lv_obj_add_style(progress_label, &theme_font_12, 0);
     lv_obj_align(progress_label, LV_ALIGN_BOTTOM_MID, 0, -40);
     lv_obj_add_flag(progress_label, LV_OBJ_FLAG_HIDDEN);
 
     // Hint text
     hint_label = lv_label_create(noodle_screen);
     lv_label_set_text(hint_label, "Long press to start countdown");
-    lv_obj_set_style_text_font(hint_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(hint_label, lv_color_hex(0x808080), 0);
+    lv_obj_add_style(hint_label, &theme_text_muted, 0);
+    lv_obj_add_style(hint_label, &theme_font_14, 0);
     lv_obj_align(hint_label, LV_ALIGN_BOTTOM_MID, 0, -10);
 
-    // Initialize display
-    update_display();
+    // Runs only while the page is shown
+    countdown_timer = lv_timer_create(countdown_timer_cb, COUNTDOWN_INTERVAL_MS, NULL);
+    lv_timer_pause(countdown_timer);
+
+    return noodle_screen;
 }
 
 // --- Timer Callbacks ---
@@ -281,7 +254,8 @@ static void countdown_timer_cb(lv_timer_t *timer)
         
         // Only update countdown every 1000ms (1 second)
         if (now - last_countdown_update >= 1000) {
-            last_countdown_update = now;
+            // 按固定步长推进, 定时器回调的延迟不会累积到倒计时中
+            last_countdown_update += 1000;
             countdown_seconds--;
             
             if (countdown_seconds <= 0) {
@@ -318,171 +292,108 @@ static void buzzer_timer_cb(lv_timer_t *timer)
     }
 }
 
-static void input_timer_cb(lv_timer_t *timer)
+static void hide_progress(void)
 {
-    bool is_pressed = is_button_pressed(BUTTON_PIN);
-    
-    switch (input_state) {
-        case INPUT_STATE_WAIT_RELEASE:
-            if (!is_pressed) {
-                input_state = INPUT_STATE_READY;
-                press_duration = 0;
+    lv_obj_add_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(progress_label, LV_OBJ_FLAG_HIDDEN);
+    lv_bar_set_value(progress_bar, 0, LV_ANIM_OFF);
+}
+
+static void noodle_button_cb(const button_event_t *event)
+{
+    switch (event->type) {
+        case BUTTON_EVENT_PRESS:
+            // Show progress bar for long press indication
+            lv_obj_clear_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_clear_flag(progress_label, LV_OBJ_FLAG_HIDDEN);
+
+            if (timer_state == TIMER_STATE_IDLE) {
+                lv_label_set_text(progress_label, "Hold to start...");
+            } else if (timer_state == TIMER_STATE_RUNNING) {
+                lv_label_set_text(progress_label, "Hold to stop...");
+            } else {
+                lv_label_set_text(progress_label, "Hold to stop alarm...");
             }
             break;
-            
-        case INPUT_STATE_READY:
-            if (is_pressed) {
-                input_state = INPUT_STATE_PRESSING;
-                press_duration = 0;
-                
-                // Show progress bar for long press indication
-                if (timer_state == TIMER_STATE_IDLE || timer_state == TIMER_STATE_RUNNING || timer_state == TIMER_STATE_ALARMING) {
-                    lv_obj_clear_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
-                    lv_obj_clear_flag(progress_label, LV_OBJ_FLAG_HIDDEN);
-                    
-                    if (timer_state == TIMER_STATE_IDLE) {
-                        lv_label_set_text(progress_label, "Hold to start...");
-                    } else if (timer_state == TIMER_STATE_RUNNING) {
-                        lv_label_set_text(progress_label, "Hold to stop...");
-                    } else {
-                        lv_label_set_text(progress_label, "Hold to stop alarm...");
-                    }
-                }
+
+        case BUTTON_EVENT_LONG_PRESS_PROGRESS:
+            if (!lv_obj_has_flag(progress_bar, LV_OBJ_FLAG_HIDDEN)) {
+                lv_bar_set_value(progress_bar, event->held_ms, LV_ANIM_OFF);
             }
             break;
-            
-        case INPUT_STATE_PRESSING:
-            if (is_pressed) {
-                press_duration += TIMER_INTERVAL_MS;
-                
-                // Update progress bar
-                if (!lv_obj_has_flag(progress_bar, LV_OBJ_FLAG_HIDDEN)) {
-                    lv_bar_set_value(progress_bar, press_duration, LV_ANIM_OFF);
-                }
-                
-                // Check for long press
-                if (press_duration >= LONG_PRESS_DURATION_MS) {
-                    input_state = INPUT_STATE_LONG_PRESSING;
-                    
-                    // Handle long press action based on current state
-                    switch (timer_state) {
-                        case TIMER_STATE_IDLE:
-                            start_countdown();
-                            break;
-                        case TIMER_STATE_RUNNING:
-                            stop_countdown();
-                            break;
-                        case TIMER_STATE_FINISHED:
-                        case TIMER_STATE_ALARMING:
-                            stop_buzzer();
-                            break;
-                    }
-                    
-                    // Hide progress bar
-                    lv_obj_add_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
-                    lv_obj_add_flag(progress_label, LV_OBJ_FLAG_HIDDEN);
-                    
-                    update_display();
-                }
-            } else {
-                // Button released - check if it was a short press (single click)
-                if (press_duration > 0 && press_duration <= CLICK_DURATION_MS_MAX) {
-                    // Single click detected - navigate back to clock
-                    cleanup_noodle_page();
-                    create_dashboard();
-                    Serial.println("Single click detected, navigating back to Clock page.");
-                    return;
-                }
-                
-                // Not a single click, reset to ready state
-                input_state = INPUT_STATE_READY;
-                press_duration = 0;
-                
-                // Hide progress bar
-                lv_obj_add_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_add_flag(progress_label, LV_OBJ_FLAG_HIDDEN);
-                lv_bar_set_value(progress_bar, 0, LV_ANIM_OFF);
+
+        case BUTTON_EVENT_LONG_PRESS:
+            // Handle long press action based on current state
+            switch (timer_state) {
+                case TIMER_STATE_IDLE:
+                    start_countdown();
+                    break;
+                case TIMER_STATE_RUNNING:
+                    stop_countdown();
+                    break;
+                case TIMER_STATE_FINISHED:
+                case TIMER_STATE_ALARMING:
+                    stop_buzzer();
+                    break;
             }
+            hide_progress();
+            update_display();
             break;
-            
-        case INPUT_STATE_LONG_PRESSING:
-            if (!is_pressed) {
-                input_state = INPUT_STATE_READY;
-                press_duration = 0;
-            }
+
+        case BUTTON_EVENT_RELEASE:
+            hide_progress();
+            break;
+
+        case BUTTON_EVENT_CLICK:
+            // Single click detected - navigate back to the dashboard
+            Router_Navigate(NAV_NEXT);
+            Serial.println("Single click detected, navigating back to Dashboard.");
+            break;
+
+        default:
             break;
     }
 }
 
-// --- Cleanup Function ---
+// --- Page Lifecycle ---
 
-static void cleanup_noodle_page(void)
+static void noodle_on_show(void)
 {
-    // Stop all timers
-    if (countdown_timer) {
-        lv_timer_del(countdown_timer);
-        countdown_timer = NULL;
-    }
-    if (input_timer) {
-        lv_timer_del(input_timer);
-        input_timer = NULL;
-    }
-    if (buzzer_timer) {
-        lv_timer_del(buzzer_timer);
-        buzzer_timer = NULL;
-    }
-    
-    // Stop buzzer
-    stop_buzzer();
-    
-    // Clean up UI
-    if (noodle_screen) {
-        lv_obj_del(noodle_screen);
-        noodle_screen = NULL;
-        time_label = NULL;
-        status_label = NULL;
-        progress_bar = NULL;
-        progress_label = NULL;
-        hint_label = NULL;
-    }
-    
-    // Reset state
+    // Every visit starts from an idle timer
     timer_state = TIMER_STATE_IDLE;
-    input_state = INPUT_STATE_WAIT_RELEASE;
     countdown_seconds = 0;
-    press_duration = 0;
     buzzer_active = false;
     last_countdown_update = 0;
-    
-    Serial.println("Instant noodle countdown page cleaned up");
-}
 
-// --- Public Entry Function ---
+    hide_progress();
+    update_display();
+    lv_timer_resume(countdown_timer);
+    ButtonInput_SetHandler(noodle_button_cb, false);
+
+    Serial.println("Instant noodle countdown page shown");
+}
 
-void Page_InstantNoodleCountDown(void)
+static void noodle_on_hide(void)
 {
-    // Initialize buzzer pin
-    pinMode(BUZZER_PIN, OUTPUT);
-    digitalWrite(BUZZER_PIN, LOW);
-    
-    // Clean up any existing page
-    cleanup_noodle_page();
-    
-    // Reset state
+    // Leaving the page cancels the countdown and silences the buzzer
+    lv_timer_pause(countdown_timer);
+    stop_buzzer();
     timer_state = TIMER_STATE_IDLE;
-    input_state = INPUT_STATE_WAIT_RELEASE;
     countdown_seconds = 0;
-    press_duration = 0;
-    buzzer_active = false;
-    last_countdown_update = 0;
-    
-    // Create UI
-    create_noodle_page();
-    lv_scr_load(noodle_screen);
-    
-    // Start timers
-    countdown_timer = lv_timer_create(countdown_timer_cb, COUNTDOWN_INTERVAL_MS, NULL);
-    input_timer = lv_timer_create(input_timer_cb, TIMER_INTERVAL_MS, NULL);
-    
-    Serial.println("Instant noodle countdown page loaded");
 }
+
+static void noodle_on_destroy(void)
+{
+    lv_timer_del(countdown_timer);
+    countdown_timer = NULL;
+    noodle_screen = NULL;
+    time_label = NULL;
+    status_label = NULL;
+    progress_bar = NULL;
+    progress_label = NULL;
+    hint_label = NULL;
+}
+
+const page_desc_t NOODLE_PAGE = {
+    "noodle", create_noodle_page, noodle_on_show, noodle_on_hide, noodle_on_destroy, false
+};
@@ -1,13 +1,17 @@
 #include "lvgl.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "Pages.h"
-#include <Arduino.h> // 添加此行以解决 digitalRead 未定义问题
-
-// --- 浅色系颜色定义 ---
-static const lv_color_t BG_COLOR = LV_COLOR_MAKE(245, 245, 245); // 浅灰色背景
-static const lv_color_t TEXT_COLOR = LV_COLOR_MAKE(50, 50, 50);    // 深灰色文本
+#include "SensorHub.h"
+#include "ButtonInput.h"
+#include "PerfStats.h"
+#include "Router.h"
+#include "Theme.h"
+#include <Arduino.h>
+
+// --- 浅色系颜色定义 (背景和文本见 Theme.h) ---
 static const lv_color_t BORDER_COLOR = LV_COLOR_MAKE(220, 220, 220); // 边框颜色
 static const lv_color_t ARC_BG_COLOR = LV_COLOR_MAKE(230, 230, 230); // 弧形背景色
 
@@ -20,82 +24,121 @@ static const lv_color_t HUMI_COLOR_DRY = LV_COLOR_MAKE(200, 150, 0);     // 干
 static const lv_color_t HUMI_COLOR_COMFORT = LV_COLOR_MAKE(0, 160, 255);  // 舒适 (天蓝色)
 static const lv_color_t HUMI_COLOR_WET = LV_COLOR_MAKE(0, 100, 200);     // 潮湿 (深蓝色)
 
+// 一个仪表当前显示的内容, 只有显示结果变化时才去修改控件 (每次修改都会触发重绘)
+typedef struct {
+    lv_obj_t *arc;
+    lv_obj_t *label;
+    char text[16];
+    int percent;
+    int color_key;  // 渐变段 * 256 + 混合比例, 相同时颜色不变
+} gauge_view_t;
+
+// 仪表的量程与配色, 数值为 0.01 单位
+typedef struct {
+    int32_t min;
+    int32_t mid;    // 舒适区中点
+    int32_t max;
+    const char *unit;
+    lv_color_t low_color;
+    lv_color_t mid_color;
+    lv_color_t high_color;
+} gauge_scale_t;
+
 // 全局变量
-static lv_obj_t *temp_value_label;
-static lv_obj_t *humi_value_label;
-static lv_obj_t *temp_arc;
-static lv_obj_t *humi_arc;
+static gauge_view_t temp_gauge;
+static gauge_view_t humi_gauge;
 static lv_obj_t *status_label;
-static lv_timer_t *data_timer;
+static uint32_t shown_sequence = 0; // 已显示的采样序号
 
-// --- 按钮检测定时器相关 ---
-static lv_timer_t *about_btn_timer = NULL;
-static bool about_btn_last_state = true;
+// 仪表盘自己的共享样式, 两个仪表共用; 指示弧颜色随数值变化, 仍是本地样式
+static lv_style_t arc_main_style;
+static lv_style_t arc_indicator_style;
+static lv_style_t legend_style;
 
-// 颜色插值辅助函数
-static lv_color_t interpolate_color(float value, float min_val, float max_val, lv_color_t start_color, lv_color_t end_color)
+static void init_dashboard_styles(void)
 {
-    // 将值限制在范围内
-    if (value < min_val) value = min_val;
-    if (value > max_val) value = max_val;
+    static bool styles_inited = false;
+    if (styles_inited) {
+        return;
+    }
+
+    lv_style_init(&arc_main_style);
+    lv_style_set_arc_width(&arc_main_style, 10);
+    lv_style_set_arc_color(&arc_main_style, ARC_BG_COLOR);
 
-    float ratio = (max_val - min_val == 0) ? 0 : (value - min_val) / (max_val - min_val);
+    lv_style_init(&arc_indicator_style);
+    lv_style_set_arc_width(&arc_indicator_style, 10);
 
-    return lv_color_mix(start_color, end_color, (uint8_t)(ratio * 255.0f));
+    lv_style_init(&legend_style);
+    lv_style_set_bg_color(&legend_style, THEME_COLOR_SURFACE);
+    lv_style_set_border_width(&legend_style, 1);
+    lv_style_set_border_color(&legend_style, BORDER_COLOR);
+    lv_style_set_radius(&legend_style, 8);
+
+    styles_inited = true;
 }
 
-// 数据更新定时器回调函数
-static void data_update_timer_cb(lv_timer_t *timer)
+// 更新一个仪表, 只修改显示结果有变化的控件
+static void update_gauge(gauge_view_t *view, const gauge_scale_t *scale, int32_t value)
 {
-    LV_UNUSED(timer);
-
-    // 使用实际传感器数据
-    float current_temp = sht20_temp; // 以SHT20为主
-    float current_humi = sht20_humi;
-
-    // 更新温度显示
-    char temp_str[32];
-    snprintf(temp_str, sizeof(temp_str), "%.1f°C", current_temp);
-    lv_label_set_text(temp_value_label, temp_str);
-
-    // 更新温度弧形进度条 (15-35°C 映射到 0-100)
-    int temp_percent = (int)((current_temp - 15.0f) / 20.0f * 100);
-    temp_percent = temp_percent < 0 ? 0 : (temp_percent > 100 ? 100 : temp_percent);
-    lv_arc_set_value(temp_arc, temp_percent);
-
-    // 根据温度值进行颜色渐变
-    const float temp_min_range = 15.0f;
-    const float temp_comfort_mid = 23.0f; // 舒适区中点
-    const float temp_max_range = 35.0f;
-    lv_color_t new_temp_color;
-    if (current_temp <= temp_comfort_mid) {
-        new_temp_color = interpolate_color(current_temp, temp_min_range, temp_comfort_mid, TEMP_COLOR_COLD, TEMP_COLOR_COMFORT);
-    } else {
-        new_temp_color = interpolate_color(current_temp, temp_comfort_mid, temp_max_range, TEMP_COLOR_COMFORT, TEMP_COLOR_HOT);
+    // 数值文字
+    char text[sizeof(view->text)];
+    SensorHub_FormatCenti(text, sizeof(text), value, scale->unit);
+    bool text_changed = strcmp(text, view->text) != 0;
+    if (text_changed) {
+        strcpy(view->text, text);
+        lv_label_set_text(view->label, text);
+    }
+    PerfStats_WidgetUpdate(text_changed);
+
+    if (value == SENSOR_CENTI_INVALID) {
+        return; // 弧形保持上一次的有效值
+    }
+
+    // 弧形进度条 (min-max 映射到 0-100)
+    int percent = SensorHub_ScalePercent(value, scale->min, scale->max);
+    bool percent_changed = percent != view->percent;
+    if (percent_changed) {
+        view->percent = percent;
+        lv_arc_set_value(view->arc, percent);
+    }
+    PerfStats_WidgetUpdate(percent_changed);
+
+    // 颜色渐变: min-mid 与 mid-max 两段, 比例截断到 0-255.
+    // lv_color_mix(c1, c2, mix) 中 mix=255 得到 c1, 所以终点颜色放在第一个参数
+    bool upper = value > scale->mid;
+    int32_t from = upper ? scale->mid : scale->min;
+    int32_t to = upper ? scale->max : scale->mid;
+    int32_t clamped = value < from ? from : (value > to ? to : value);
+    int mix = (to == from) ? 0 : (int)((clamped - from) * 255 / (to - from));
+    int color_key = (upper ? 256 : 0) + mix;
+    bool color_changed = color_key != view->color_key;
+    if (color_changed) {
+        view->color_key = color_key;
+        lv_color_t start_color = upper ? scale->mid_color : scale->low_color;
+        lv_color_t end_color = upper ? scale->high_color : scale->mid_color;
+        lv_obj_set_style_arc_color(view->arc, lv_color_mix(end_color, start_color, (uint8_t)mix), LV_PART_INDICATOR);
     }
-    lv_obj_set_style_arc_color(temp_arc, new_temp_color, LV_PART_INDICATOR);
-
-    // 更新湿度显示
-    char humi_str[32];
-    snprintf(humi_str, sizeof(humi_str), "%.1f%%", current_humi);
-    lv_label_set_text(humi_value_label, humi_str);
-
-    // 更新湿度弧形进度条 (30-80% 映射到 0-100)
-    int humi_percent = (int)((current_humi - 30.0f) / 50.0f * 100);
-    humi_percent = humi_percent < 0 ? 0 : (humi_percent > 100 ? 100 : humi_percent);
-    lv_arc_set_value(humi_arc, humi_percent);
-
-    // 根据湿度值进行颜色渐变
-    const float humi_min_range = 30.0f;
-    const float humi_comfort_mid = 55.0f; // 舒适区中点
-    const float humi_max_range = 80.0f;
-    lv_color_t new_humi_color;
-    if (current_humi <= humi_comfort_mid) {
-        new_humi_color = interpolate_color(current_humi, humi_min_range, humi_comfort_mid, HUMI_COLOR_DRY, HUMI_COLOR_COMFORT);
-    } else {
-        new_humi_color = interpolate_color(current_humi, humi_comfort_mid, humi_max_range, HUMI_COLOR_COMFORT, HUMI_COLOR_WET);
+    PerfStats_WidgetUpdate(color_changed);
+}
+
+static const gauge_scale_t TEMP_SCALE = {
+    1500, 2300, 3500, "°C", TEMP_COLOR_COLD, TEMP_COLOR_COMFORT, TEMP_COLOR_HOT
+};
+static const gauge_scale_t HUMI_SCALE = {
+    3000, 5500, 8000, "%", HUMI_COLOR_DRY, HUMI_COLOR_COMFORT, HUMI_COLOR_WET
+};
+
+// 新采样回调: 传感器任务发布采样后由 SensorHub_Process() 在 LVGL 线程中调用
+static void dashboard_sensor_cb(const SensorSnapshot *snapshot)
+{
+    if (snapshot->sequence == shown_sequence) {
+        return; // 离开期间没有新的采样, 控件保留着原来的内容
     }
-    lv_obj_set_style_arc_color(humi_arc, new_humi_color, LV_PART_INDICATOR);
+    shown_sequence = snapshot->sequence;
+
+    update_gauge(&temp_gauge, &TEMP_SCALE, snapshot->sht20_temp_centi); // 以SHT20为主
+    update_gauge(&humi_gauge, &HUMI_SCALE, snapshot->sht20_humi_centi);
 }
 
 // 创建弧形仪表盘
@@ -112,19 +155,16 @@ static lv_obj_t* create_arc_gauge(lv_obj_t *parent, int x, int y, int size,
     lv_obj_remove_style(arc, NULL, LV_PART_KNOB);   // 移除旋钮
     lv_obj_clear_flag(arc, LV_OBJ_FLAG_CLICKABLE);  // 禁用点击
 
-    // 设置主弧(背景)宽度和颜色
-    lv_obj_set_style_arc_width(arc, 10, LV_PART_MAIN);
-    lv_obj_set_style_arc_color(arc, ARC_BG_COLOR, LV_PART_MAIN);
-
-    // 设置指示弧宽度和颜色
-    lv_obj_set_style_arc_width(arc, 10, LV_PART_INDICATOR);
+    // 主弧(背景)和指示弧的宽度与底色
+    lv_obj_add_style(arc, &arc_main_style, LV_PART_MAIN);
+    lv_obj_add_style(arc, &arc_indicator_style, LV_PART_INDICATOR);
     lv_obj_set_style_arc_color(arc, color, LV_PART_INDICATOR);
 
     // 创建标题标签
     lv_obj_t *title_label = lv_label_create(parent);
     lv_label_set_text(title_label, title);
-    lv_obj_set_style_text_color(title_label, TEXT_COLOR, 0);
-    lv_obj_set_style_text_font(title_label, &lv_font_montserrat_14, 0);
+    lv_obj_add_style(title_label, &theme_text, 0);
+    lv_obj_add_style(title_label, &theme_font_14, 0);
     lv_obj_align_to(title_label, arc, LV_ALIGN_OUT_TOP_MID, 0, -10);
 
     return arc;
@@ -135,116 +175,110 @@ static lv_obj_t* create_value_label(lv_obj_t *parent, lv_obj_t *arc, const char
 {
     lv_obj_t *label = lv_label_create(parent);
     lv_label_set_text(label, initial_text);
-    lv_obj_set_style_text_color(label, TEXT_COLOR, 0);
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_22, 0); // 加大字体
+    lv_obj_add_style(label, &theme_text, 0);
+    lv_obj_add_style(label, &theme_font_22, 0); // 加大字体
     lv_obj_align_to(label, arc, LV_ALIGN_CENTER, 0, 0);
 
     return label;
 }
 
-// 按钮检测定时器回调函数
-static void about_btn_check_timer_cb(lv_timer_t *timer)
+// 按键事件回调: 按下即进入下一页 (关于页)
+static void dashboard_button_cb(const button_event_t *event)
 {
-    LV_UNUSED(timer);
-    // 检查物理按钮（短按进入关于页）
-    bool btn_state = digitalRead(BUTTON_PIN);
-    if (!btn_state && about_btn_last_state) { // 检测到按下（下降沿）
-        // 先切换到一个新的空白屏幕，确保所有元素被清除
-        lv_obj_t *new_scr = lv_obj_create(NULL);
-        lv_scr_load(new_scr);
-
-        // 停止当前页面的定时器，防止资源冲突
-        if (data_timer) {
-            lv_timer_del(data_timer);
-            data_timer = NULL;
-        }
-        if (about_btn_timer) {
-            lv_timer_del(about_btn_timer);
-            about_btn_timer = NULL;
-        }
-        Page_About();
+    if (event->type != BUTTON_EVENT_PRESS) {
+        return;
     }
-    about_btn_last_state = btn_state;
+    Router_Navigate(NAV_NEXT);
 }
 
-// 主仪表盘创建函数
-void create_dashboard(void)
+// 构建仪表盘屏幕 (只在第一次显示时调用, 之后屏幕常驻缓存)
+static lv_obj_t *dashboard_create(void)
 {
-    // 清理可能存在的定时器，防止资源冲突
-    if (data_timer) {
-        lv_timer_del(data_timer);
-        data_timer = NULL;
-    }
-    if (about_btn_timer) {
-        lv_timer_del(about_btn_timer);
-        about_btn_timer = NULL;
-    }
+    init_dashboard_styles();
 
     // 创建新的屏幕
     lv_obj_t *scr = lv_obj_create(NULL);
-    lv_scr_load(scr);
-
-    // 设置背景颜色
-    lv_obj_set_style_bg_color(scr, BG_COLOR, 0);
+    lv_obj_add_style(scr, &theme_screen, 0);
 
     // 创建主容器 (可以省略，直接在屏幕上创建)
     // 为了保持结构，这里保留，但设为透明
     lv_obj_t *main_cont = lv_obj_create(scr);
     lv_obj_set_size(main_cont, SCREEN_WIDTH, SCREEN_HEIGHT);
     lv_obj_set_pos(main_cont, 0, 0);
-    lv_obj_set_style_bg_opa(main_cont, LV_OPA_TRANSP, 0); // 设置背景透明
-    lv_obj_set_style_border_width(main_cont, 0, 0);
-    lv_obj_set_style_pad_all(main_cont, 10, 0);
+    lv_obj_add_style(main_cont, &theme_plain, 0);
 
     // 创建标题
     lv_obj_t *title = lv_label_create(main_cont);
     lv_label_set_text(title, "Environment Monitor");
-    lv_obj_set_style_text_color(title, TEXT_COLOR, 0);
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_18, 0);
+    lv_obj_add_style(title, &theme_text, 0);
+    lv_obj_add_style(title, &theme_font_18, 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
 
     // 创建温度弧形仪表盘 (左)
-    temp_arc = create_arc_gauge(main_cont, 30, 60, 120, TEMP_COLOR_COMFORT, "Temperature");
-    temp_value_label = create_value_label(main_cont, temp_arc, "25.8°C");
+    temp_gauge.arc = create_arc_gauge(main_cont, 30, 60, 120, TEMP_COLOR_COMFORT, "Temperature");
+    temp_gauge.label = create_value_label(main_cont, temp_gauge.arc, "25.8°C");
 
     // 创建湿度弧形仪表盘 (右)
-    humi_arc = create_arc_gauge(main_cont, 170, 60, 120, HUMI_COLOR_COMFORT, "Humidity");
-    humi_value_label = create_value_label(main_cont, humi_arc, "55.2%");
+    humi_gauge.arc = create_arc_gauge(main_cont, 170, 60, 120, HUMI_COLOR_COMFORT, "Humidity");
+    humi_gauge.label = create_value_label(main_cont, humi_gauge.arc, "55.2%");
+
+    // 新建的控件显示的是占位值, 下一次采样时全部刷新
+    temp_gauge.text[0] = humi_gauge.text[0] = '\0';
+    temp_gauge.percent = humi_gauge.percent = -1;
+    temp_gauge.color_key = humi_gauge.color_key = -1;
+    shown_sequence = 0;
 
     // 创建图例容器
     lv_obj_t *legend_cont = lv_obj_create(main_cont);
     lv_obj_set_size(legend_cont, 280, 30);
-    lv_obj_set_style_bg_color(legend_cont, lv_color_white(), 0);
-    lv_obj_set_style_border_width(legend_cont, 1, 0);
-    lv_obj_set_style_border_color(legend_cont, BORDER_COLOR, 0);
-    lv_obj_set_style_radius(legend_cont, 8, 0);
+    lv_obj_add_style(legend_cont, &legend_style, 0);
     lv_obj_align(legend_cont, LV_ALIGN_BOTTOM_MID, 0, -5);
 
     // 温度范围标签
     lv_obj_t *temp_range = lv_label_create(legend_cont);
     lv_label_set_text(temp_range, "Temp: 15-35°C");
+    lv_obj_add_style(temp_range, &theme_font_12, 0);
     lv_obj_set_style_text_color(temp_range, lv_color_darken(TEMP_COLOR_COMFORT, 20), 0);
-    lv_obj_set_style_text_font(temp_range, &lv_font_montserrat_12, 0);
     lv_obj_align(temp_range, LV_ALIGN_LEFT_MID, 15, 0);
 
     // 湿度范围标签
     lv_obj_t *humi_range = lv_label_create(legend_cont);
     lv_label_set_text(humi_range, "Humi: 30-80%");
+    lv_obj_add_style(humi_range, &theme_font_12, 0);
     lv_obj_set_style_text_color(humi_range, lv_color_darken(HUMI_COLOR_COMFORT, 20), 0);
-    lv_obj_set_style_text_font(humi_range, &lv_font_montserrat_12, 0);
     lv_obj_align(humi_range, LV_ALIGN_RIGHT_MID, -15, 0);
 
     // 创建状态信息标签并赋值给全局变量
     status_label = lv_label_create(main_cont);
     lv_obj_align_to(status_label, legend_cont, LV_ALIGN_OUT_BOTTOM_MID, 0, 10); // 放置在图例下方
-    lv_obj_set_style_text_font(status_label, &lv_font_montserrat_16, 0);
-    lv_obj_set_style_text_color(status_label, TEXT_COLOR, 0); // 初始颜色可以设置为默认文本颜色
+    lv_obj_add_style(status_label, &theme_text, 0); // 初始颜色可以设置为默认文本颜色
+    lv_obj_add_style(status_label, &theme_font_16, 0);
 
-    // 创建并启动数据更新定时器 (每2秒更新一次)
-    data_timer = lv_timer_create(data_update_timer_cb, 2000, NULL);
+    return scr;
+}
 
-    // 启动物理按钮检测定时器（50ms轮询）
-    if (!about_btn_timer) {
-        about_btn_timer = lv_timer_create(about_btn_check_timer_cb, 50, NULL);
-    }
+static void dashboard_on_show(void)
+{
+    // 页面显示时才接收新采样; 注册后的第一次派发会交出当前快照
+    SensorHub_SetHandler(dashboard_sensor_cb);
+
+    // 接收物理按键事件
+    ButtonInput_SetHandler(dashboard_button_cb, false);
 }
+
+static void dashboard_on_hide(void)
+{
+    SensorHub_SetHandler(NULL);
+}
+
+static void dashboard_on_destroy(void)
+{
+    temp_gauge.arc = temp_gauge.label = NULL;
+    humi_gauge.arc = humi_gauge.label = NULL;
+    status_label = NULL;
+}
+
+// 仪表盘是返回最多的页面, 常驻缓存
+const page_desc_t DASHBOARD_PAGE = {
+    "dashboard", dashboard_create, dashboard_on_show, dashboard_on_hide, dashboard_on_destroy, true
+};
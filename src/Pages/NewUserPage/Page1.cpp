@@ -1,4 +1,5 @@
 #include "Pages.h" // 假设你的页面管理头文件在这里
+#include "ButtonInput.h"
 #include <Arduino.h>
 /**
  * @file NewUserPage1_Hello.c
@@ -14,7 +15,6 @@
 static lv_obj_t *screen1; // 指向第一个屏幕的指针
 static lv_obj_t *screen2; // 指向第二个屏幕的指针
 static lv_obj_t *screen2_label_continue = NULL; // 新增：用于保存“Press Button to Continue”标签指针
-static bool button_pressed = false; // 新增：按钮状态变量
 
 // --- 函数前向声明 ---
 static void create_screen1(void);
@@ -22,7 +22,7 @@ static void create_screen2(void);
 static void switch_to_screen2_cb(lv_timer_t *timer);
 static void load_next_page_cb(lv_timer_t *timer);
 static void fadein_continue_label_cb(lv_timer_t *timer);
-static void check_button_cb(lv_timer_t *timer);
+static void hello_button_cb(const button_event_t *event);
 
 /**
  * @brief 创建并启动用户介绍动画序列。
@@ -141,8 +141,8 @@ static void switch_to_screen2_cb(lv_timer_t *timer)
     // 这个时间足够让切换动画播放完毕，并让用户阅读屏幕上的文字。
     lv_timer_create(load_next_page_cb, 3000, NULL);
     
-    // 新增：启动按钮监听定时器（50ms轮询）
-    lv_timer_create(check_button_cb, 50, NULL);
+    // 新增：接收物理按键事件
+    ButtonInput_SetHandler(hello_button_cb, false);
 
     // 删除当前定时器，因为它已经完成了任务
     lv_timer_del(timer);
@@ -162,11 +162,10 @@ static void load_next_page_cb(lv_timer_t *timer)
     lv_timer_del(timer);
 }
 
-// 新增：定时器回调，轮询按钮状态
-static void check_button_cb(lv_timer_t *timer)
+// 新增：按键事件回调，按下即跳过介绍
+static void hello_button_cb(const button_event_t *event)
 {
-    if (!button_pressed && digitalRead(BUTTON_PIN) == LOW) {
-        button_pressed = true;
+    if (event->type == BUTTON_EVENT_PRESS) {
         // 切换到 WLAN 配置页，使用淡入动画前，主动释放screen1/screen2，防止内存泄漏
         if (screen1) {
             lv_obj_del(screen1);
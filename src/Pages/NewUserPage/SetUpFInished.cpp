@@ -1,4 +1,6 @@
 #include "Pages.h"
+#include "ButtonInput.h"
+#include "Router.h"
 #include "lvgl.h"
 #include "Wire.h"
 #include "Arduino.h"
@@ -8,7 +10,6 @@
 #define SETUP_FINISHED_TITLE_TEXT "Setup Finished"
 #define SETUP_FINISHED_SUBTITLE_TEXT "Hope you enjoy your new device"
 #define BUTTON_PROMPT_TEXT "Press the button to continue"
-#define BUTTON_GPIO 9
 #define FIREWORK_PARTICLE_COUNT 8
 #define FIREWORK_BURST_COUNT 5
 
@@ -19,13 +20,11 @@ static lv_obj_t *success_icon = NULL;
 static lv_obj_t *setup_finished_title = NULL;
 static lv_obj_t *setup_finished_subtitle = NULL;
 static lv_obj_t *prompt_label = NULL;
-static lv_timer_t *hardware_button_timer = NULL;
 static lv_timer_t *firework_timer = NULL;
 static lv_timer_t *debug_timer = NULL;  // 调试定时器
 static int firework_burst_counter = 0;
 
 // --- Function Prototypes ---
-void create_dashboard(void);
 static void create_firework_at(lv_coord_t x, lv_coord_t y);
 static void firework_timer_cb(lv_timer_t *timer);
 static void debug_timer_cb(lv_timer_t *timer);  // 调试函数
@@ -59,10 +58,6 @@ static void firework_anim_ready_cb(lv_anim_t *a) {
 }
 
 static void go_to_dashboard(void) {
-    if (hardware_button_timer) {
-        lv_timer_del(hardware_button_timer);
-        hardware_button_timer = NULL;
-    }
     if (firework_timer) {
         lv_timer_del(firework_timer);
         firework_timer = NULL;
@@ -73,11 +68,11 @@ static void go_to_dashboard(void) {
     }
     
     lv_obj_clean(lv_scr_act());
-    create_dashboard();
+    Router_Show(PAGE_DASHBOARD);
 }
 
-static void check_button_and_goto_dashboard(lv_timer_t *timer) {
-    if (digitalRead(BUTTON_GPIO) == LOW) {
+static void setup_finished_button_cb(const button_event_t *event) {
+    if (event->type == BUTTON_EVENT_PRESS) {
         LV_LOG_USER("Hardware button pressed, proceeding to dashboard.");
         go_to_dashboard();
     }
@@ -234,8 +229,8 @@ void create_setup_finished_page(void) {
     lv_obj_set_style_bg_color(setup_finished_container, lv_color_hex(0x333333), 0);
     lv_obj_set_style_bg_opa(setup_finished_container, LV_OPA_30, 0);
 
-    // 12. 创建按钮检测定时器
-    hardware_button_timer = lv_timer_create(check_button_and_goto_dashboard, 100, NULL);
+    // 12. 接收物理按键事件
+    ButtonInput_SetHandler(setup_finished_button_cb, false);
 
     // 13. 创建调试定时器（2秒后输出调试信息）
     debug_timer = lv_timer_create(debug_timer_cb, 2000, NULL);
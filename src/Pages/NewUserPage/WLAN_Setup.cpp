@@ -1,5 +1,6 @@
 #include <lvgl.h>
 #include "Pages.h"
+#include "ButtonInput.h"
 #include <string.h>
 #include <WiFi.h>
 #include <ESP32WebServer.h>      // 使用 ESP32WebServer
@@ -23,7 +24,6 @@ static String connecting_ssid;         // 保存正在连接的SSID
 static String connecting_password;     // 保存正在连接的密码
 static bool wifi_connected_waiting_for_button = false; // 等待物理按键标志
 static lv_timer_t *network_timer = NULL; // 用于网络处理的定时器
-static lv_timer_t *button_timer = NULL; // 用于按键检测的定时器
 
 // 创建一个Preferences对象，命名空间为 "wifi-creds"
 Preferences preferences;
@@ -56,6 +56,8 @@ const char index_html[] PROGMEM = R"rawliteral(
       <input type="text" id="ssid" name="ssid" placeholder="Enter SSID" required>
       <label for="password">Password:</label>
       <input type="password" name="password" id="password">
+      <label for="server">Upload server (optional):</label>
+      <input type="text" id="server" name="server" placeholder="http://host:port/">
       <input type="submit" value="Connect">
     </form>
     <div id="status"></div>
@@ -71,11 +73,12 @@ const char index_html[] PROGMEM = R"rawliteral(
       e.preventDefault();
       let ssid = document.getElementById('ssid').value;
       const password = document.getElementById('password').value;
+      const server = document.getElementById('server').value;
       showStatus(`Connecting to "${ssid}"...`);
       fetch('/connect', {
         method: 'POST',
         headers: { 'Content-Type': 'application/x-www-form-urlencoded' },
-        body: `ssid=${encodeURIComponent(ssid)}&password=${encodeURIComponent(password)}`
+        body: `ssid=${encodeURIComponent(ssid)}&password=${encodeURIComponent(password)}&server=${encodeURIComponent(server)}`
       })
       .then(response => response.text())
       .then(text => {
@@ -121,6 +124,7 @@ static void onWifiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
             preferences.begin("wifi-creds", false);
             preferences.putString("ssid", connecting_ssid);
             preferences.putString("password", connecting_password);
+            preferences.remove("bssid"); // 换了网络, 作废快速重连的缓存 (见 Init_Connection())
             preferences.end();
             Serial.println("Wi-Fi credentials saved to NVS.");
 
@@ -231,6 +235,12 @@ static void start_web_server() {
         if (server.hasArg("ssid") && server.hasArg("password")) {
             connecting_ssid = server.arg("ssid");
             connecting_password = server.arg("password");
+            // 可选的上报服务器地址, 留空则保持当前设置
+            if (server.hasArg("server") && server.arg("server").length() > 0 &&
+                !WebService_SetServerUrl(server.arg("server").c_str())) {
+                server.send(400, "text/plain", "bad server url");
+                return;
+            }
             
             WiFi.begin(connecting_ssid.c_str(), connecting_password.c_str());
             server.send(200, "text/plain", "success");
@@ -262,25 +272,16 @@ static void start_web_server() {
 
 
 /**
- * @brief LVGL定时器回调，用于检测物理按键
+ * @brief 物理按键事件回调 (消抖由按键引擎完成)
  */
-static void physical_button_check_timer(lv_timer_t *timer) {
-    if (wifi_connected_waiting_for_button) {
-        if (digitalRead(BUTTON_PIN) == LOW) {
-            vTaskDelay(pdMS_TO_TICKS(50));
-            if (digitalRead(BUTTON_PIN) == LOW) {
-                wifi_connected_waiting_for_button = false;
-                Serial.println("Physical button pressed. Transitioning to the next page...");
-                // 跳转到设置完成页面
-                create_setup_finished_page();
-                // 删除此定时器
-                if(button_timer) {
-                    lv_timer_del(button_timer);
-                    button_timer = NULL;
-                }
-            }
-        }
+static void physical_button_cb(const button_event_t *event) {
+    if (event->type != BUTTON_EVENT_PRESS || !wifi_connected_waiting_for_button) {
+        return;
     }
+    wifi_connected_waiting_for_button = false;
+    Serial.println("Physical button pressed. Transitioning to the next page...");
+    // 跳转到设置完成页面
+    create_setup_finished_page();
 }
 
 
@@ -361,10 +362,8 @@ void WLAN_Setup_Page(void)
         lv_obj_set_style_border_width(qr_placeholder, 0, 0);
     #endif
 
-    // 创建LVGL定时器以轮询物理按键
-    if(button_timer == NULL) {
-        button_timer = lv_timer_create(physical_button_check_timer, 50, NULL);
-    }
+    // 接收物理按键事件
+    ButtonInput_SetHandler(physical_button_cb, false);
 
     lv_scr_load_anim(screen, LV_SCR_LOAD_ANIM_FADE_IN, 300, 0, false);
 }
@@ -379,8 +378,5 @@ void cleanup_wlan_setup_page(void) {
         lv_timer_del(network_timer);
         network_timer = NULL;
     }
-    if (button_timer) {
-        lv_timer_del(button_timer);
-        button_timer = NULL;
-    }
+    ButtonInput_SetHandler(NULL, false);
 }
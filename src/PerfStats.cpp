@@ -0,0 +1,137 @@
+#include "PerfStats.h"
+#include "esp_timer.h"
+
+const uint32_t PERF_FLUSH_HIST_EDGES_US[PERF_FLUSH_HIST_BUCKETS - 1] = {
+    500, 1000, 2000, 4000, 8000, 16000, 32000
+};
+
+static portMUX_TYPE perf_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static int64_t window_start = 0;
+static uint32_t frames = 0;
+static uint64_t render_total_us = 0;
+static uint32_t render_max_us = 0;
+static uint32_t flushed_pixels = 0;
+static uint32_t flush_hist[PERF_FLUSH_HIST_BUCKETS];
+static uint32_t loop_max_us = 0;
+static uint32_t widget_redraws = 0;
+static uint32_t widget_skips = 0;
+
+// 只在 LVGL 所在的 loop 任务中访问
+static int64_t render_start = 0;
+static int64_t flush_start = 0;
+static bool flush_in_flight = false;
+
+static void perf_display_event_cb(lv_event_t *e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_RENDER_START) {
+        render_start = esp_timer_get_time();
+    } else if (code == LV_EVENT_RENDER_READY) {
+        uint32_t spent = (uint32_t)(esp_timer_get_time() - render_start);
+        portENTER_CRITICAL(&perf_mux);
+        frames++;
+        render_total_us += spent;
+        if (spent > render_max_us) {
+            render_max_us = spent;
+        }
+        portEXIT_CRITICAL(&perf_mux);
+    }
+}
+
+void PerfStats_Attach(lv_display_t *disp) {
+    window_start = esp_timer_get_time();
+    lv_display_add_event_cb(disp, perf_display_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp, perf_display_event_cb, LV_EVENT_RENDER_READY, NULL);
+}
+
+void PerfStats_FlushBegin(uint32_t pixels) {
+    flush_start = esp_timer_get_time();
+    flush_in_flight = true;
+    portENTER_CRITICAL(&perf_mux);
+    flushed_pixels += pixels;
+    portEXIT_CRITICAL(&perf_mux);
+}
+
+void PerfStats_FlushEnd(void) {
+    if (!flush_in_flight) {
+        return;
+    }
+    flush_in_flight = false;
+    uint32_t spent = (uint32_t)(esp_timer_get_time() - flush_start);
+    int bucket = 0;
+    while (bucket < PERF_FLUSH_HIST_BUCKETS - 1 && spent >= PERF_FLUSH_HIST_EDGES_US[bucket]) {
+        bucket++;
+    }
+    portENTER_CRITICAL(&perf_mux);
+    flush_hist[bucket]++;
+    portEXIT_CRITICAL(&perf_mux);
+}
+
+void PerfStats_LoopIteration(uint32_t elapsed_us) {
+    portENTER_CRITICAL(&perf_mux);
+    if (elapsed_us > loop_max_us) {
+        loop_max_us = elapsed_us;
+    }
+    portEXIT_CRITICAL(&perf_mux);
+}
+
+void PerfStats_WidgetUpdate(bool redrawn) {
+    portENTER_CRITICAL(&perf_mux);
+    if (redrawn) {
+        widget_redraws++;
+    } else {
+        widget_skips++;
+    }
+    portEXIT_CRITICAL(&perf_mux);
+}
+
+void PerfStats_Take(PerfReport *out, bool reset) {
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&perf_mux);
+    int64_t elapsed_us = now - window_start;
+    out->window_ms = (uint32_t)(elapsed_us / 1000);
+    out->frames = frames;
+    out->render_avg_us = frames ? (uint32_t)(render_total_us / frames) : 0;
+    out->render_max_us = render_max_us;
+    out->flushed_pixels = flushed_pixels;
+    out->flush_px_per_s = elapsed_us > 0 ? (uint32_t)(((uint64_t)flushed_pixels * 1000000ULL) / elapsed_us) : 0;
+    memcpy(out->flush_hist, flush_hist, sizeof(flush_hist));
+    out->loop_max_us = loop_max_us;
+    out->widget_redraws = widget_redraws;
+    out->widget_skips = widget_skips;
+    if (reset) {
+        window_start = now;
+        frames = 0;
+        render_total_us = 0;
+        render_max_us = 0;
+        flushed_pixels = 0;
+        memset(flush_hist, 0, sizeof(flush_hist));
+        loop_max_us = 0;
+        widget_redraws = 0;
+        widget_skips = 0;
+    }
+    portEXIT_CRITICAL(&perf_mux);
+}
+
+void PerfStats_Print(void) {
+    PerfReport report;
+    PerfStats_Take(&report, false);
+    Serial.printf("Perf: window=%lums, frames=%lu, render avg=%luus max=%luus\n",
+        (unsigned long)report.window_ms, (unsigned long)report.frames,
+        (unsigned long)report.render_avg_us, (unsigned long)report.render_max_us);
+    Serial.printf("Perf: flushed=%lupx (%lu px/s), loop max=%luus\n",
+        (unsigned long)report.flushed_pixels, (unsigned long)report.flush_px_per_s,
+        (unsigned long)report.loop_max_us);
+    Serial.printf("Perf: dashboard widget updates redrawn=%lu skipped=%lu\n",
+        (unsigned long)report.widget_redraws, (unsigned long)report.widget_skips);
+    Serial.print("Perf: flush latency histogram:");
+    for (int i = 0; i < PERF_FLUSH_HIST_BUCKETS; i++) {
+        if (i < PERF_FLUSH_HIST_BUCKETS - 1) {
+            Serial.printf(" <%luus:%lu", (unsigned long)PERF_FLUSH_HIST_EDGES_US[i], (unsigned long)report.flush_hist[i]);
+        } else {
+            Serial.printf(" >=%luus:%lu", (unsigned long)PERF_FLUSH_HIST_EDGES_US[i - 1], (unsigned long)report.flush_hist[i]);
+        }
+    }
+    Serial.println();
+}
@@ -0,0 +1,99 @@
+#include "Router.h"
+#include "Pages.h"
+#include "PageManager.h"
+#include <Arduino.h>
+#include "esp_timer.h"
+
+// 页面表, 顺序与 page_id_t 一致
+static const page_desc_t *const PAGE_TABLE[PAGE_COUNT] = {
+    &DASHBOARD_PAGE,
+    &ABOUT_PAGE,
+    &INFO_PAGE,
+    &RESET_PAGE,
+    &CLOCK_PAGE,
+    &NOODLE_PAGE,
+};
+
+// 导航图的一条边
+typedef struct {
+    page_id_t from;
+    nav_action_t action;
+    page_id_t to;
+    lv_scr_load_anim_t anim;
+} nav_edge_t;
+
+// 功能页按 NEXT 循环: 仪表盘 -> 关于 -> 恢复出厂 -> 时钟 -> 泡面计时 -> 仪表盘
+static const nav_edge_t NAV_GRAPH[] = {
+    { PAGE_DASHBOARD, NAV_NEXT,  PAGE_ABOUT,     LV_SCR_LOAD_ANIM_MOVE_LEFT },
+    { PAGE_ABOUT,     NAV_NEXT,  PAGE_RESET,     LV_SCR_LOAD_ANIM_MOVE_LEFT },
+    { PAGE_ABOUT,     NAV_ENTER, PAGE_INFO,      LV_SCR_LOAD_ANIM_MOVE_TOP },
+    { PAGE_INFO,      NAV_BACK,  PAGE_ABOUT,     LV_SCR_LOAD_ANIM_MOVE_BOTTOM },
+    { PAGE_RESET,     NAV_NEXT,  PAGE_CLOCK,     LV_SCR_LOAD_ANIM_MOVE_LEFT },
+    { PAGE_CLOCK,     NAV_NEXT,  PAGE_NOODLE,    LV_SCR_LOAD_ANIM_MOVE_LEFT },
+    { PAGE_NOODLE,    NAV_NEXT,  PAGE_DASHBOARD, LV_SCR_LOAD_ANIM_MOVE_LEFT },
+};
+
+// 每个目标页面的切换耗时: 从发起切换到新页面 on_show 返回 (不含动画本身)
+typedef struct {
+    uint32_t count;
+    uint32_t builds;   // 其中需要构建屏幕的次数
+    uint32_t last_us;
+    uint32_t max_us;
+} transition_stats_t;
+
+static page_id_t current = PAGE_NONE;
+static transition_stats_t stats[PAGE_COUNT];
+
+static void transition(page_id_t to, lv_scr_load_anim_t anim, uint32_t anim_ms) {
+    page_id_t from = current;
+    int64_t start = esp_timer_get_time();
+    bool built = PageManager_Show(PAGE_TABLE[to], anim, anim_ms);
+    uint32_t spent = (uint32_t)(esp_timer_get_time() - start);
+    current = to;
+
+    transition_stats_t &s = stats[to];
+    s.count++;
+    s.builds += built ? 1 : 0;
+    s.last_us = spent;
+    if (spent > s.max_us) {
+        s.max_us = spent;
+    }
+    Serial.printf("Nav: %s -> %s (%s) %luus\n",
+        from == PAGE_NONE ? "-" : PAGE_TABLE[from]->name, PAGE_TABLE[to]->name,
+        built ? "built" : "cached", (unsigned long)spent);
+}
+
+void Router_Show(page_id_t page) {
+    if (page >= PAGE_COUNT || page == current) {
+        return;
+    }
+    transition(page, LV_SCR_LOAD_ANIM_NONE, 0);
+}
+
+bool Router_Navigate(nav_action_t action) {
+    for (size_t i = 0; i < sizeof(NAV_GRAPH) / sizeof(NAV_GRAPH[0]); i++) {
+        const nav_edge_t &edge = NAV_GRAPH[i];
+        if (edge.from == current && edge.action == action) {
+            transition(edge.to, ROUTER_ANIM_MS > 0 ? edge.anim : LV_SCR_LOAD_ANIM_NONE, ROUTER_ANIM_MS);
+            return true;
+        }
+    }
+    return false;
+}
+
+page_id_t Router_Current(void) {
+    return current;
+}
+
+void Router_Print(void) {
+    for (int i = 0; i < PAGE_COUNT; i++) {
+        const transition_stats_t &s = stats[i];
+        if (s.count == 0) {
+            continue;
+        }
+        Serial.printf("Nav: %-9s shown=%lu built=%lu last=%luus max=%luus\n",
+            PAGE_TABLE[i]->name, (unsigned long)s.count, (unsigned long)s.builds,
+            (unsigned long)s.last_us, (unsigned long)s.max_us);
+    }
+    PageManager_Print();
+}
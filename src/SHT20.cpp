@@ -0,0 +1,199 @@
+#include "SHT20.h"
+#include <Wire.h>
+
+#define SHT20_ADDR            0x40
+#define SHT20_CMD_TEMP_NOHOLD 0xF3
+#define SHT20_CMD_HUMI_NOHOLD 0xF5
+#define SHT20_CMD_WRITE_USER  0xE6
+#define SHT20_CMD_READ_USER   0xE7
+#define SHT20_RES_MASK        0x81
+
+// 超过最长转换时间仍未就绪则放弃本次测量
+static const uint32_t SHT20_TIMEOUT_MARGIN_MS = 50;
+
+typedef enum {
+    SHT20_STATE_IDLE,
+    SHT20_STATE_MEASURING_TEMP,
+    SHT20_STATE_MEASURING_HUMI
+} sht20_state_t;
+
+static sht20_state_t state = SHT20_STATE_IDLE;
+static sht20_resolution_t current_resolution = SHT20_RES_RH12_T14;
+static sht20_phase_mode_t phase_mode = SHT20_PHASES_SEQUENTIAL;
+static bool next_phase_is_humi = false; // 交错模式下下一次测量的阶段
+static unsigned long phase_start = 0;   // 当前阶段触发的时间
+static int16_t last_temp = 0;          // 0.01 °C
+static int16_t last_humi = 0;          // 0.01 %RH
+
+// ========== 各分辨率下的最长转换时间 (datasheet, ms) ==========
+static uint32_t temp_conversion_ms(sht20_resolution_t res) {
+    switch (res) {
+        case SHT20_RES_RH8_T12:  return 22;
+        case SHT20_RES_RH10_T13: return 43;
+        case SHT20_RES_RH11_T11: return 11;
+        default:                 return 85;
+    }
+}
+
+static uint32_t humi_conversion_ms(sht20_resolution_t res) {
+    switch (res) {
+        case SHT20_RES_RH8_T12:  return 4;
+        case SHT20_RES_RH10_T13: return 9;
+        case SHT20_RES_RH11_T11: return 15;
+        default:                 return 29;
+    }
+}
+
+// ========== CRC-8 (x^8 + x^5 + x^4 + 1) ==========
+static uint8_t sht20_crc8(const uint8_t *data, int len) {
+    uint8_t crc = 0;
+    for (int i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static bool send_command(uint8_t cmd) {
+    Wire.beginTransmission(SHT20_ADDR);
+    Wire.write(cmd);
+    return Wire.endTransmission() == 0;
+}
+
+static void start_phase(sht20_state_t phase) {
+    uint8_t cmd = (phase == SHT20_STATE_MEASURING_TEMP) ? SHT20_CMD_TEMP_NOHOLD : SHT20_CMD_HUMI_NOHOLD;
+    if (send_command(cmd)) {
+        state = phase;
+        phase_start = millis();
+    } else {
+        state = SHT20_STATE_IDLE;
+    }
+}
+
+/**
+ * @brief 尝试读取转换结果. 转换未完成时传感器会 NACK, 此时返回 false.
+ */
+static bool read_result(uint16_t &raw) {
+    if (Wire.requestFrom(SHT20_ADDR, 3) != 3) {
+        return false;
+    }
+    uint8_t buf[3];
+    buf[0] = Wire.read();
+    buf[1] = Wire.read();
+    buf[2] = Wire.read();
+    if (sht20_crc8(buf, 2) != buf[2]) {
+        Serial.println("SHT20 CRC mismatch, sample dropped.");
+        raw = 0xFFFF; // 标记为无效
+        return true;
+    }
+    raw = ((uint16_t)buf[0] << 8) | buf[1];
+    return true;
+}
+
+// ========== 换算 (datasheet: T = -46.85 + 175.72 * S / 2^16, RH = -6 + 125 * S / 2^16) ==========
+// 放大 100 倍后用 32 位整数计算, 算术右移即向下取整; 中间值最大约 1.2e9, 不会溢出
+int16_t SHT20_RawToTempCenti(uint16_t raw) {
+    int32_t scaled = 17572 * (int32_t)(raw & 0xFFFC) - 4685 * 65536;
+    return (int16_t)(scaled >> 16);
+}
+
+int16_t SHT20_RawToHumiCenti(uint16_t raw) {
+    int32_t scaled = 12500 * (int32_t)(raw & 0xFFFC) - 600 * 65536;
+    return (int16_t)(scaled >> 16);
+}
+
+bool SHT20_Begin(sht20_resolution_t resolution, sht20_phase_mode_t mode) {
+    state = SHT20_STATE_IDLE;
+    phase_mode = mode;
+    next_phase_is_humi = false;
+    return SHT20_SetResolution(resolution);
+}
+
+bool SHT20_SetResolution(sht20_resolution_t resolution) {
+    if (state != SHT20_STATE_IDLE) {
+        return false;
+    }
+    if (!send_command(SHT20_CMD_READ_USER)) {
+        return false;
+    }
+    if (Wire.requestFrom(SHT20_ADDR, 1) != 1) {
+        return false;
+    }
+    uint8_t user_reg = Wire.read();
+    user_reg = (user_reg & ~SHT20_RES_MASK) | (uint8_t)resolution;
+
+    Wire.beginTransmission(SHT20_ADDR);
+    Wire.write(SHT20_CMD_WRITE_USER);
+    Wire.write(user_reg);
+    if (Wire.endTransmission() != 0) {
+        return false;
+    }
+    current_resolution = resolution;
+    return true;
+}
+
+bool SHT20_StartMeasurement(void) {
+    if (state != SHT20_STATE_IDLE) {
+        return false;
+    }
+    if (phase_mode == SHT20_PHASES_INTERLEAVED && next_phase_is_humi) {
+        start_phase(SHT20_STATE_MEASURING_HUMI);
+    } else {
+        start_phase(SHT20_STATE_MEASURING_TEMP);
+    }
+    return state != SHT20_STATE_IDLE;
+}
+
+bool SHT20_Poll(int16_t &temp_centi, int16_t &humi_centi) {
+    if (state == SHT20_STATE_IDLE) {
+        return false;
+    }
+
+    bool measuring_temp = (state == SHT20_STATE_MEASURING_TEMP);
+    uint32_t conversion_ms = measuring_temp ? temp_conversion_ms(current_resolution)
+                                            : humi_conversion_ms(current_resolution);
+    unsigned long elapsed = millis() - phase_start;
+    if (elapsed < conversion_ms) {
+        return false; // 还没到最短等待时间, 不去打扰总线
+    }
+
+    uint16_t raw;
+    if (!read_result(raw)) {
+        if (elapsed > conversion_ms + SHT20_TIMEOUT_MARGIN_MS) {
+            Serial.println("SHT20 measurement timeout.");
+            state = SHT20_STATE_IDLE;
+        }
+        return false;
+    }
+
+    if (measuring_temp) {
+        if (raw != 0xFFFF) {
+            last_temp = SHT20_RawToTempCenti(raw);
+        }
+        if (phase_mode == SHT20_PHASES_SEQUENTIAL) {
+            start_phase(SHT20_STATE_MEASURING_HUMI);
+            if (state != SHT20_STATE_IDLE) {
+                return false; // 湿度阶段已触发, 下次再取
+            }
+        } else {
+            next_phase_is_humi = true;
+            state = SHT20_STATE_IDLE;
+        }
+    } else {
+        if (raw != 0xFFFF) {
+            last_humi = SHT20_RawToHumiCenti(raw);
+        }
+        next_phase_is_humi = false;
+        state = SHT20_STATE_IDLE;
+    }
+
+    temp_centi = last_temp;
+    humi_centi = last_humi;
+    return true;
+}
+
+bool SHT20_IsBusy(void) {
+    return state != SHT20_STATE_IDLE;
+}
@@ -0,0 +1,206 @@
+#include "SensorHub.h"
+#include "SHT20.h"
+#include "CpuLoad.h"
+#include <Wire.h>
+#include <WiFi.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// 读者检测到写入冲突时的最大重试次数
+static const int SNAPSHOT_READ_RETRIES = 8;
+
+static TaskHandle_t sensorTaskHandle = NULL;
+static uint32_t sensor_period_ms = SENSOR_HUB_DEFAULT_PERIOD_MS;
+
+// ========== seqlock ==========
+// 写者在写入前后各把 snapshot_seq 加一: 奇数表示写入中, 偶数表示稳定.
+// 读者在拷贝前后读取 snapshot_seq, 两次相同且为偶数才说明拷贝没有被打断.
+// ESP32-C3 是单核, 传感器任务优先级高于所有读者, 因此读者不会在写入中途
+// 抢占写者, 只可能是写者抢占读者, 读者重试即可.
+static uint32_t snapshot_seq = 0;
+static SensorSnapshot snapshot_data;
+
+static void publish_snapshot(const SensorSnapshot &sample) {
+    __atomic_store_n(&snapshot_seq, snapshot_seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&snapshot_data, &sample, sizeof(snapshot_data));
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&snapshot_seq, snapshot_seq + 1, __ATOMIC_RELAXED);
+}
+
+bool SensorHub_Read(SensorSnapshot *out) {
+    for (int attempt = 0; attempt < SNAPSHOT_READ_RETRIES; attempt++) {
+        uint32_t begin = __atomic_load_n(&snapshot_seq, __ATOMIC_ACQUIRE);
+        if (begin == 0) {
+            return false; // 还没有任何采样
+        }
+        if (begin & 1) {
+            taskYIELD();
+            continue;
+        }
+        memcpy(out, &snapshot_data, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&snapshot_seq, __ATOMIC_RELAXED) == begin) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ========== 新采样通知 ==========
+// 每次发布 snapshot_seq 加二, 因此 snapshot_seq / 2 就是最新采样的序号 (写入中为上一条).
+static TaskHandle_t notify_task = NULL;       // 发布后唤醒的任务 (loop 所在任务)
+static sensor_data_cb_t data_handler = NULL;  // 以下两项只在 LVGL 线程中访问
+static uint32_t handled_sequence = 0;         // 已交给回调的采样序号
+
+void SensorHub_SetHandler(sensor_data_cb_t handler) {
+    data_handler = handler;
+    handled_sequence = 0;
+    __atomic_store_n(&notify_task, handler != NULL ? xTaskGetCurrentTaskHandle() : NULL, __ATOMIC_RELEASE);
+}
+
+void SensorHub_Process(void) {
+    uint32_t latest = __atomic_load_n(&snapshot_seq, __ATOMIC_ACQUIRE) / 2;
+    if (data_handler == NULL || latest == handled_sequence) {
+        return;
+    }
+    SensorSnapshot snapshot;
+    if (!SensorHub_Read(&snapshot)) {
+        return; // 写入完成后会再次唤醒
+    }
+    handled_sequence = snapshot.sequence;
+    data_handler(&snapshot);
+}
+
+static void notify_published(void) {
+    TaskHandle_t task = __atomic_load_n(&notify_task, __ATOMIC_ACQUIRE);
+    if (task != NULL) {
+        xTaskNotifyGive(task);
+    }
+}
+
+// ========== 历史采样 ==========
+// 序号为 seq 的采样存放在 history[(seq - 1) % SENSOR_HUB_HISTORY_LEN].
+// 读出的是多条采样, 不适合 seqlock 重试, 用临界区保护; 拷贝量很小.
+static portMUX_TYPE history_mux = portMUX_INITIALIZER_UNLOCKED;
+static SensorSnapshot history[SENSOR_HUB_HISTORY_LEN];
+static uint32_t history_latest = 0; // 最新一条的序号, 0 表示为空
+
+static void append_history(const SensorSnapshot &sample) {
+    portENTER_CRITICAL(&history_mux);
+    history[(sample.sequence - 1) % SENSOR_HUB_HISTORY_LEN] = sample;
+    history_latest = sample.sequence;
+    portEXIT_CRITICAL(&history_mux);
+}
+
+size_t SensorHub_ReadHistory(uint32_t after_sequence, SensorSnapshot *out, size_t max_count) {
+    size_t count = 0;
+    portENTER_CRITICAL(&history_mux);
+    uint32_t latest = history_latest;
+    uint32_t oldest = latest > SENSOR_HUB_HISTORY_LEN ? latest - SENSOR_HUB_HISTORY_LEN + 1 : 1;
+    uint32_t first = after_sequence + 1 > oldest ? after_sequence + 1 : oldest;
+    for (uint32_t seq = first; seq <= latest && count < max_count; seq++) {
+        out[count++] = history[(seq - 1) % SENSOR_HUB_HISTORY_LEN];
+    }
+    portEXIT_CRITICAL(&history_mux);
+    return count;
+}
+
+int SensorHub_FormatCenti(char *buf, size_t size, int16_t centi, const char *unit) {
+    if (centi == SENSOR_CENTI_INVALID) {
+        return snprintf(buf, size, "--%s", unit);
+    }
+    // 向下取整的 0.01 值再四舍五入到 0.1, 等价于原始值直接四舍五入到 0.1
+    int32_t tenths = centi + 5;
+    tenths = tenths >= 0 ? tenths / 10 : -((-tenths + 9) / 10);
+    uint32_t magnitude = tenths < 0 ? -tenths : tenths;
+    const char *sign = (centi < 0) ? "-" : ""; // 与 printf 一致, -0.04 显示为 "-0.0"
+    return snprintf(buf, size, "%s%lu.%lu%s", sign,
+        (unsigned long)(magnitude / 10), (unsigned long)(magnitude % 10), unit);
+}
+
+int SensorHub_ScalePercent(int32_t centi, int32_t min, int32_t max) {
+    if (centi <= min || max <= min) {
+        return 0;
+    }
+    int32_t percent = (centi - min) * 100 / (max - min);
+    return percent > 100 ? 100 : (int)percent;
+}
+
+// ========== LM75 读取函数 ==========
+static int16_t read_lm75_temp() {
+    Wire.beginTransmission(0x48); // LM75 I2C地址
+    Wire.write(0x00); // 温度寄存器
+    Wire.endTransmission(false);
+    Wire.requestFrom(0x48, 2);
+    if (Wire.available() == 2) {
+        uint8_t msb = Wire.read();
+        uint8_t lsb = Wire.read();
+        int16_t temp = (int16_t)((msb << 8) | lsb) >> 5; // 0.125 °C
+        return (int16_t)((temp * 25) >> 1);              // * 12.5, 向下取整
+    }
+    return SENSOR_CENTI_INVALID;
+}
+
+// ========== ESP32 内置温度读取 ==========
+static int16_t read_esp32_temp() {
+    // 框架只提供浮点接口, 在这里一次性换算
+    return (int16_t)floorf(temperatureRead() * 100.0f);
+}
+
+// ========== RAM/WiFi信号读取 ==========
+static uint32_t get_ram_free() {
+    return ESP.getFreeHeap();
+}
+static int8_t get_wifi_rssi() {
+    return WiFi.RSSI();
+}
+
+// ========== 采集任务 ==========
+static void SensorTask(void *parameter) {
+    (void)parameter;
+    SensorSnapshot sample = {};
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;) {
+        CpuLoad_SlotEnter(CPU_SLOT_SENSORS);
+        SHT20_StartMeasurement(); // 先触发转换, 等待期间读取其它传感器
+        sample.lm75_centi = read_lm75_temp();
+        sample.esp32_centi = read_esp32_temp();
+        sample.ram_free = get_ram_free();
+        sample.cpu_usage = CpuLoad_GetUsage();
+        sample.wifi_rssi = get_wifi_rssi();
+        CpuLoad_SlotExit(CPU_SLOT_SENSORS);
+
+        // 等待SHT20转换完成, 期间让出CPU
+        while (SHT20_IsBusy()) {
+            vTaskDelay(pdMS_TO_TICKS(5));
+            CpuLoad_SlotEnter(CPU_SLOT_SENSORS);
+            SHT20_Poll(sample.sht20_temp_centi, sample.sht20_humi_centi);
+            CpuLoad_SlotExit(CPU_SLOT_SENSORS);
+        }
+
+        sample.sequence++;
+        sample.timestamp_ms = millis();
+        publish_snapshot(sample);
+        append_history(sample);
+        notify_published();
+
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(sensor_period_ms));
+    }
+}
+
+void SensorHub_Start(uint32_t period_ms, UBaseType_t priority) {
+    if (sensorTaskHandle != NULL) {
+        return;
+    }
+    sensor_period_ms = period_ms;
+    xTaskCreate(
+        SensorTask,        // 任务函数
+        "SensorTask",      // 名称
+        3072,              // 堆栈大小
+        NULL,              // 参数
+        priority,          // 优先级
+        &sensorTaskHandle  // 任务句柄
+    );
+}
@@ -0,0 +1,31 @@
+#include "SpoolPartition.h"
+#include "esp_partition.h"
+
+#define SPOOL_SECTOR_SIZE 4096 // flash 擦除单位
+
+static bool partition_read(void *ctx, uint32_t offset, void *buf, size_t len) {
+    return esp_partition_read((const esp_partition_t *)ctx, offset, buf, len) == ESP_OK;
+}
+
+static bool partition_write(void *ctx, uint32_t offset, const void *buf, size_t len) {
+    return esp_partition_write((const esp_partition_t *)ctx, offset, buf, len) == ESP_OK;
+}
+
+static bool partition_erase(void *ctx, uint32_t offset, size_t len) {
+    return esp_partition_erase_range((const esp_partition_t *)ctx, offset, len) == ESP_OK;
+}
+
+bool SpoolPartition_Open(spool_flash_t *out) {
+    const esp_partition_t *partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)SPOOL_PARTITION_SUBTYPE, SPOOL_PARTITION_LABEL);
+    if (partition == NULL) {
+        return false;
+    }
+    out->read = partition_read;
+    out->write = partition_write;
+    out->erase = partition_erase;
+    out->ctx = (void *)partition;
+    out->sector_size = SPOOL_SECTOR_SIZE;
+    out->size = partition->size - partition->size % SPOOL_SECTOR_SIZE;
+    return true;
+}
@@ -0,0 +1,130 @@
+#include "TelemetryBench.h"
+#include "TelemetryPayload.h"
+#include "SHT20.h"
+#include "esp_timer.h"
+
+#define BENCH_ITERATIONS 100
+
+static SensorSnapshot bench_samples[TELEMETRY_BATCH_MAX_SAMPLES];
+static char bench_json[TELEMETRY_PAYLOAD_MAX];
+static uint8_t bench_cbor[TELEMETRY_PAYLOAD_MAX];
+
+// 生成一组接近真实的采样: 2s 周期, 温湿度缓慢漂移
+static void fill_samples(void) {
+    for (int i = 0; i < TELEMETRY_BATCH_MAX_SAMPLES; i++) {
+        SensorSnapshot &sample = bench_samples[i];
+        sample.sequence = 1000 + i;
+        sample.timestamp_ms = 2000000 + 2000 * i;
+        sample.lm75_centi = 2412 + 12 * (i % 3);
+        sample.sht20_temp_centi = 2437 + i;
+        sample.sht20_humi_centi = 5621 - 3 * i;
+        sample.esp32_centi = 4130 + 10 * (i % 5);
+        sample.ram_free = 154320 - 32 * (i % 4);
+        sample.cpu_usage = 18 + i % 7;
+        sample.wifi_rssi = -61 - i % 3;
+    }
+}
+
+static void bench_batch(size_t count, const CpuLoadReport *cpu, const PerfReport *perf) {
+    TelemetryBatch batch = {};
+    batch.samples = bench_samples;
+    batch.count = count;
+    batch.boot = 42;
+    batch.uptime_ms = 2000000 + 2000 * count;
+    batch.cpu_report = cpu;
+    batch.perf_report = perf;
+
+    size_t json_len = 0;
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        json_len = TelemetryPayload_EncodeBatch(&batch, bench_json, sizeof(bench_json));
+    }
+    uint32_t json_us = (uint32_t)((esp_timer_get_time() - start) / BENCH_ITERATIONS);
+
+    size_t cbor_len = 0;
+    start = esp_timer_get_time();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        cbor_len = TelemetryPayload_EncodeBatchCbor(&batch, bench_cbor, sizeof(bench_cbor));
+    }
+    uint32_t cbor_us = (uint32_t)((esp_timer_get_time() - start) / BENCH_ITERATIONS);
+
+    Serial.printf("Bench: %2u samples  json %5u B %5luus  cbor %5u B %5luus  (%u%% size)\n",
+        (unsigned)count, (unsigned)json_len, (unsigned long)json_us,
+        (unsigned)cbor_len, (unsigned long)cbor_us,
+        json_len ? (unsigned)(cbor_len * 100 / json_len) : 0);
+}
+
+void TelemetryBench_Run(void) {
+    fill_samples();
+
+    CpuLoadReport cpu = {};
+    cpu.window_ms = TELEMETRY_UPLOAD_INTERVAL_MS;
+    cpu.average = 21;
+    cpu.peak = 64;
+    cpu.slot_share[CPU_SLOT_LVGL] = 15;
+    cpu.slot_share[CPU_SLOT_SENSORS] = 2;
+    cpu.slot_share[CPU_SLOT_UPLOAD] = 1;
+    PerfReport perf = {};
+    perf.window_ms = TELEMETRY_UPLOAD_INTERVAL_MS;
+    perf.frames = 310;
+    perf.render_avg_us = 2100;
+    perf.render_max_us = 9800;
+    perf.flush_px_per_s = 1250000;
+    perf.flush_hist[1] = 120;
+    perf.flush_hist[2] = 450;
+    perf.loop_max_us = 14000;
+
+    Serial.printf("Bench: %d iterations per encoder\n", BENCH_ITERATIONS);
+    bench_batch(1, &cpu, &perf);
+    bench_batch(TELEMETRY_UPLOAD_INTERVAL_MS / SENSOR_HUB_DEFAULT_PERIOD_MS, &cpu, &perf); // 一次实时上报
+    bench_batch(TELEMETRY_BATCH_MAX_SAMPLES, NULL, NULL);                                  // 一次离线重发
+}
+
+// ========== 浮点 / 定点对比 ==========
+// 原先的浮点实现, 仅用作对照
+static float float_temp(uint16_t raw) {
+    return -46.85f + 175.72f * (raw & 0xFFFC) / 65536.0f;
+}
+
+static float float_humi(uint16_t raw) {
+    return -6.0f + 125.0f * (raw & 0xFFFC) / 65536.0f;
+}
+
+void TelemetryBench_RunFixedPoint(void) {
+    char buf[16];
+    volatile float float_sink = 0;
+    volatile int32_t fixed_sink = 0;
+    const uint16_t raw_temp = 0x6A4C; // 约 26.0 °C
+    const uint16_t raw_humi = 0x8E1C; // 约 63.4 %RH
+
+    uint32_t start = ESP.getCycleCount();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        float_sink = float_temp(raw_temp + 4 * i) + float_humi(raw_humi + 4 * i);
+    }
+    uint32_t float_convert = (ESP.getCycleCount() - start) / BENCH_ITERATIONS;
+
+    start = ESP.getCycleCount();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        fixed_sink = SHT20_RawToTempCenti(raw_temp + 4 * i) + SHT20_RawToHumiCenti(raw_humi + 4 * i);
+    }
+    uint32_t fixed_convert = (ESP.getCycleCount() - start) / BENCH_ITERATIONS;
+
+    start = ESP.getCycleCount();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        snprintf(buf, sizeof(buf), "%.1f°C", float_temp(raw_temp + 4 * i));
+    }
+    uint32_t float_format = (ESP.getCycleCount() - start) / BENCH_ITERATIONS;
+
+    start = ESP.getCycleCount();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        SensorHub_FormatCenti(buf, sizeof(buf), SHT20_RawToTempCenti(raw_temp + 4 * i), "°C");
+    }
+    uint32_t fixed_format = (ESP.getCycleCount() - start) / BENCH_ITERATIONS;
+    (void)float_sink;
+    (void)fixed_sink;
+
+    Serial.printf("Bench: convert T+RH  float %5lu cycles  fixed %5lu cycles\n",
+        (unsigned long)float_convert, (unsigned long)fixed_convert);
+    Serial.printf("Bench: convert+format  float %5lu cycles  fixed %5lu cycles\n",
+        (unsigned long)float_format, (unsigned long)fixed_format);
+}
@@ -0,0 +1,324 @@
+#include "TelemetryPayload.h"
+#include <string.h>
+
+// 定长缓冲区上的追加写入器, 溢出后所有写入都变为空操作
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t len;
+    bool overflow;
+} payload_writer_t;
+
+static void put_raw(payload_writer_t *w, const char *data, size_t n) {
+    if (w->overflow || w->len + n >= w->size) { // 保留结尾 '\0' 的位置
+        w->overflow = true;
+        return;
+    }
+    memcpy(w->buf + w->len, data, n);
+    w->len += n;
+}
+
+static void put_str(payload_writer_t *w, const char *s) {
+    put_raw(w, s, strlen(s));
+}
+
+static void put_uint(payload_writer_t *w, uint32_t value) {
+    char text[10]; // uint32_t 最多 10 位
+    size_t pos = sizeof(text);
+    do {
+        text[--pos] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    put_raw(w, text + pos, sizeof(text) - pos);
+}
+
+// 只用于每批一次的 epoch_ms, 采样字段都走 32 位的 put_uint()
+static void put_uint64(payload_writer_t *w, uint64_t value) {
+    char text[20]; // uint64_t 最多 20 位
+    size_t pos = sizeof(text);
+    do {
+        text[--pos] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    put_raw(w, text + pos, sizeof(text) - pos);
+}
+
+static void put_int(payload_writer_t *w, int32_t value) {
+    if (value < 0) {
+        put_raw(w, "-", 1);
+        put_uint(w, (uint32_t)0 - (uint32_t)value);
+    } else {
+        put_uint(w, (uint32_t)value);
+    }
+}
+
+// 0.01 单位的整数按两位小数输出
+static void put_centi(payload_writer_t *w, int16_t centi) {
+    if (centi == SENSOR_CENTI_INVALID) {
+        put_str(w, "null");
+        return;
+    }
+    uint32_t magnitude = centi < 0 ? (uint32_t)-(int32_t)centi : (uint32_t)centi;
+    if (centi < 0) {
+        put_raw(w, "-", 1);
+    }
+    put_uint(w, magnitude / 100);
+    char frac[3] = { '.', (char)('0' + magnitude / 10 % 10), (char)('0' + magnitude % 10) };
+    put_raw(w, frac, sizeof(frac));
+}
+
+// 写入 "key": 前缀, 非第一个字段时先写逗号
+static void put_key(payload_writer_t *w, const char *key, bool first) {
+    if (!first) {
+        put_raw(w, ",", 1);
+    }
+    put_raw(w, "\"", 1);
+    put_str(w, key);
+    put_raw(w, "\":", 2);
+}
+
+static void put_sample(payload_writer_t *w, const SensorSnapshot &sample) {
+    put_raw(w, "{", 1);
+    put_key(w, "seq", true);          put_uint(w, sample.sequence);
+    put_key(w, "ts", false);          put_uint(w, sample.timestamp_ms);
+    put_key(w, "lm75_temp", false);   put_centi(w, sample.lm75_centi);
+    put_key(w, "sht20_temp", false);  put_centi(w, sample.sht20_temp_centi);
+    put_key(w, "sht20_humi", false);  put_centi(w, sample.sht20_humi_centi);
+    put_key(w, "esp32_temp", false);  put_centi(w, sample.esp32_centi);
+    put_key(w, "ram_free", false);    put_uint(w, sample.ram_free);
+    put_key(w, "cpu_usage", false);   put_uint(w, sample.cpu_usage);
+    put_key(w, "wifi_rssi", false);   put_int(w, sample.wifi_rssi);
+    put_raw(w, "}", 1);
+}
+
+size_t TelemetryPayload_EncodeBatch(const TelemetryBatch *batch, char *out, size_t out_size) {
+    if (out == NULL || out_size == 0) {
+        return 0;
+    }
+    payload_writer_t w = { out, out_size, 0, false };
+    put_raw(&w, "{", 1);
+    put_key(&w, "boot", true);            put_uint(&w, batch->boot);
+    put_key(&w, "uptime_ms", false);      put_uint(&w, batch->uptime_ms);
+    if (batch->epoch_ms != 0) {
+        put_key(&w, "epoch_ms", false);   put_uint64(&w, batch->epoch_ms);
+    }
+    put_key(&w, "replay", false);         put_str(&w, batch->replay ? "true" : "false");
+    put_key(&w, "dropped", false);        put_uint(&w, batch->dropped);
+    put_key(&w, "samples", false);
+    put_raw(&w, "[", 1);
+    for (size_t i = 0; i < batch->count; i++) {
+        if (i > 0) {
+            put_raw(&w, ",", 1);
+        }
+        put_sample(&w, batch->samples[i]);
+    }
+    put_raw(&w, "]", 1);
+    // 以下为整个上报窗口的统计
+    if (batch->cpu_report != NULL) {
+        const CpuLoadReport &cpu = *batch->cpu_report;
+        put_key(&w, "cpu_usage", false);      put_uint(&w, cpu.average);
+        put_key(&w, "cpu_peak", false);       put_uint(&w, cpu.peak);
+        put_key(&w, "cpu_lvgl", false);       put_uint(&w, cpu.slot_share[CPU_SLOT_LVGL]);
+        put_key(&w, "cpu_sensors", false);    put_uint(&w, cpu.slot_share[CPU_SLOT_SENSORS]);
+        put_key(&w, "cpu_upload", false);     put_uint(&w, cpu.slot_share[CPU_SLOT_UPLOAD]);
+    }
+    if (batch->perf_report != NULL) {
+        const PerfReport &perf = *batch->perf_report;
+        put_key(&w, "frames", false);         put_uint(&w, perf.frames);
+        put_key(&w, "render_avg_us", false);  put_uint(&w, perf.render_avg_us);
+        put_key(&w, "render_max_us", false);  put_uint(&w, perf.render_max_us);
+        put_key(&w, "flush_px_per_s", false); put_uint(&w, perf.flush_px_per_s);
+        put_key(&w, "flush_hist", false);
+        put_raw(&w, "[", 1);
+        for (int i = 0; i < PERF_FLUSH_HIST_BUCKETS; i++) {
+            if (i > 0) {
+                put_raw(&w, ",", 1);
+            }
+            put_uint(&w, perf.flush_hist[i]);
+        }
+        put_raw(&w, "]", 1);
+        put_key(&w, "loop_max_us", false);    put_uint(&w, perf.loop_max_us);
+    }
+    put_raw(&w, "}", 1);
+
+    if (w.overflow) {
+        out[0] = '\0';
+        return 0;
+    }
+    out[w.len] = '\0';
+    return w.len;
+}
+
+// ========== CBOR ==========
+#define CBOR_UINT     0
+#define CBOR_NEGINT   1
+#define CBOR_TEXT     3
+#define CBOR_ARRAY    4
+#define CBOR_MAP      5
+#define CBOR_FALSE    0xF4
+#define CBOR_TRUE     0xF5
+#define CBOR_NULL     0xF6
+
+// 采样的各列, 顺序即输出顺序
+typedef enum {
+    COLUMN_SEQ,
+    COLUMN_TS,
+    COLUMN_LM75,
+    COLUMN_SHT20_TEMP,
+    COLUMN_SHT20_HUMI,
+    COLUMN_ESP32,
+    COLUMN_RAM_FREE,
+    COLUMN_CPU_USAGE,
+    COLUMN_WIFI_RSSI,
+    COLUMN_COUNT
+} sample_column_t;
+
+static const char *const COLUMN_KEYS[COLUMN_COUNT] = {
+    "seq", "ts", "lm75_temp", "sht20_temp", "sht20_humi", "esp32_temp",
+    "ram_free", "cpu_usage", "wifi_rssi"
+};
+
+static void cbor_head(payload_writer_t *w, uint8_t major, uint64_t arg) {
+    uint8_t head[9];
+    size_t n;
+    major <<= 5;
+    if (arg < 24) {
+        head[0] = major | (uint8_t)arg;
+        n = 1;
+    } else if (arg <= 0xFF) {
+        head[0] = major | 24;
+        head[1] = (uint8_t)arg;
+        n = 2;
+    } else if (arg <= 0xFFFF) {
+        head[0] = major | 25;
+        head[1] = (uint8_t)(arg >> 8);
+        head[2] = (uint8_t)arg;
+        n = 3;
+    } else if (arg <= 0xFFFFFFFFULL) {
+        head[0] = major | 26;
+        for (int i = 0; i < 4; i++) {
+            head[1 + i] = (uint8_t)(arg >> (24 - 8 * i));
+        }
+        n = 5;
+    } else {
+        head[0] = major | 27;
+        for (int i = 0; i < 8; i++) {
+            head[1 + i] = (uint8_t)(arg >> (56 - 8 * i));
+        }
+        n = 9;
+    }
+    put_raw(w, (const char *)head, n);
+}
+
+static void cbor_int(payload_writer_t *w, int64_t value) {
+    if (value < 0) {
+        cbor_head(w, CBOR_NEGINT, (uint64_t)(-1 - value));
+    } else {
+        cbor_head(w, CBOR_UINT, (uint64_t)value);
+    }
+}
+
+static void cbor_simple(payload_writer_t *w, uint8_t value) {
+    put_raw(w, (const char *)&value, 1);
+}
+
+static void cbor_key(payload_writer_t *w, const char *key) {
+    size_t len = strlen(key);
+    cbor_head(w, CBOR_TEXT, len);
+    put_raw(w, key, len);
+}
+
+static bool centi_value(int16_t centi, int64_t *out) {
+    if (centi == SENSOR_CENTI_INVALID) {
+        return false;
+    }
+    *out = centi;
+    return true;
+}
+
+static bool column_value(const SensorSnapshot &sample, int column, int64_t *out) {
+    switch (column) {
+        case COLUMN_SEQ:         *out = sample.sequence; return true;
+        case COLUMN_TS:          *out = sample.timestamp_ms; return true;
+        case COLUMN_LM75:        return centi_value(sample.lm75_centi, out);
+        case COLUMN_SHT20_TEMP:  return centi_value(sample.sht20_temp_centi, out);
+        case COLUMN_SHT20_HUMI:  return centi_value(sample.sht20_humi_centi, out);
+        case COLUMN_ESP32:       return centi_value(sample.esp32_centi, out);
+        case COLUMN_RAM_FREE:    *out = sample.ram_free; return true;
+        case COLUMN_CPU_USAGE:   *out = sample.cpu_usage; return true;
+        case COLUMN_WIFI_RSSI:   *out = sample.wifi_rssi; return true;
+        default:                 return false;
+    }
+}
+
+// 一列差分编码: 第一个有效值写原值, 之后写与前一个有效值的差
+static void cbor_column(payload_writer_t *w, const TelemetryBatch *batch, int column) {
+    cbor_key(w, COLUMN_KEYS[column]);
+    cbor_head(w, CBOR_ARRAY, batch->count);
+    bool have_prev = false;
+    int64_t prev = 0;
+    for (size_t i = 0; i < batch->count; i++) {
+        int64_t value;
+        if (!column_value(batch->samples[i], column, &value)) {
+            cbor_simple(w, CBOR_NULL);
+            continue;
+        }
+        cbor_int(w, have_prev ? value - prev : value);
+        prev = value;
+        have_prev = true;
+    }
+}
+
+size_t TelemetryPayload_EncodeBatchCbor(const TelemetryBatch *batch, uint8_t *out, size_t out_size) {
+    if (out == NULL || out_size == 0) {
+        return 0;
+    }
+    payload_writer_t w = { (char *)out, out_size, 0, false };
+
+    size_t fields = 5;
+    if (batch->epoch_ms != 0) {
+        fields += 1;
+    }
+    if (batch->cpu_report != NULL) {
+        fields += 5;
+    }
+    if (batch->perf_report != NULL) {
+        fields += 6;
+    }
+    cbor_head(&w, CBOR_MAP, fields);
+    cbor_key(&w, "boot");       cbor_int(&w, batch->boot);
+    cbor_key(&w, "uptime_ms");  cbor_int(&w, batch->uptime_ms);
+    if (batch->epoch_ms != 0) {
+        cbor_key(&w, "epoch_ms");   cbor_int(&w, (int64_t)batch->epoch_ms);
+    }
+    cbor_key(&w, "replay");     cbor_simple(&w, batch->replay ? CBOR_TRUE : CBOR_FALSE);
+    cbor_key(&w, "dropped");    cbor_int(&w, batch->dropped);
+    cbor_key(&w, "samples");
+    cbor_head(&w, CBOR_MAP, COLUMN_COUNT);
+    for (int column = 0; column < COLUMN_COUNT; column++) {
+        cbor_column(&w, batch, column);
+    }
+    if (batch->cpu_report != NULL) {
+        const CpuLoadReport &cpu = *batch->cpu_report;
+        cbor_key(&w, "cpu_usage");      cbor_int(&w, cpu.average);
+        cbor_key(&w, "cpu_peak");       cbor_int(&w, cpu.peak);
+        cbor_key(&w, "cpu_lvgl");       cbor_int(&w, cpu.slot_share[CPU_SLOT_LVGL]);
+        cbor_key(&w, "cpu_sensors");    cbor_int(&w, cpu.slot_share[CPU_SLOT_SENSORS]);
+        cbor_key(&w, "cpu_upload");     cbor_int(&w, cpu.slot_share[CPU_SLOT_UPLOAD]);
+    }
+    if (batch->perf_report != NULL) {
+        const PerfReport &perf = *batch->perf_report;
+        cbor_key(&w, "frames");         cbor_int(&w, perf.frames);
+        cbor_key(&w, "render_avg_us");  cbor_int(&w, perf.render_avg_us);
+        cbor_key(&w, "render_max_us");  cbor_int(&w, perf.render_max_us);
+        cbor_key(&w, "flush_px_per_s"); cbor_int(&w, perf.flush_px_per_s);
+        cbor_key(&w, "flush_hist");
+        cbor_head(&w, CBOR_ARRAY, PERF_FLUSH_HIST_BUCKETS);
+        for (int i = 0; i < PERF_FLUSH_HIST_BUCKETS; i++) {
+            cbor_int(&w, perf.flush_hist[i]);
+        }
+        cbor_key(&w, "loop_max_us");    cbor_int(&w, perf.loop_max_us);
+    }
+
+    return w.overflow ? 0 : w.len;
+}
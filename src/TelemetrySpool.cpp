@@ -0,0 +1,335 @@
+#include "TelemetrySpool.h"
+#include <string.h>
+
+// 槽位状态, 只会从 1 写成 0: 空(0xFF) -> 已写入(0x7F) -> 已消费(0x3F)
+#define SLOT_EMPTY    0xFF
+#define SLOT_WRITTEN  0x7F
+#define SLOT_CONSUMED 0x3F
+#define SLOT_HEADER   0x5A
+#define HEADER_MAGIC  0x5350 // "SP"
+
+typedef struct __attribute__((packed)) {
+    uint8_t state;
+    uint8_t crc;              // 覆盖第 2 字节起的其余内容
+    uint16_t boot;
+    uint32_t sequence;
+    uint32_t timestamp_ms;
+    int16_t lm75_centi;       // 与 SensorSnapshot 相同, 0.01 单位
+    int16_t sht20_temp_centi;
+    int16_t sht20_humi_centi;
+    int16_t esp32_centi;
+    uint32_t ram_free;
+    uint8_t cpu_usage;
+    int8_t wifi_rssi;
+    uint8_t reserved[6];
+} spool_record_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t state;
+    uint8_t crc;
+    uint16_t magic;
+    uint32_t sector_seq;      // 每启用一个扇区加一, 最大者为当前写入扇区
+    uint8_t reserved[24];
+} spool_header_t;
+
+static_assert(sizeof(spool_record_t) == SPOOL_RECORD_SIZE, "spool record must fill one slot");
+static_assert(sizeof(spool_header_t) == SPOOL_RECORD_SIZE, "spool header must fill one slot");
+
+typedef struct {
+    uint32_t sector;
+    uint32_t slot;            // 0 为扇区头, 记录从 1 开始
+} spool_pos_t;
+
+static const spool_flash_t *flash = NULL;
+static uint32_t sector_count = 0;
+static uint32_t slots_per_sector = 0;
+
+// head 总是指向下一个可写的空槽位; tail == head 表示没有未消费的记录
+static spool_pos_t head;
+static spool_pos_t tail;
+static uint32_t head_seq = 0;
+static uint32_t pending = 0;
+static uint32_t overwritten = 0;
+
+static spool_pos_t peek_end;
+static bool peek_valid = false;
+
+static uint8_t crc8(const uint8_t *data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint8_t slot_crc(const void *slot) {
+    return crc8((const uint8_t *)slot + 2, SPOOL_RECORD_SIZE - 2);
+}
+
+static uint32_t slot_offset(spool_pos_t pos) {
+    return pos.sector * flash->sector_size + pos.slot * SPOOL_RECORD_SIZE;
+}
+
+static bool pos_equal(spool_pos_t a, spool_pos_t b) {
+    return a.sector == b.sector && a.slot == b.slot;
+}
+
+static spool_pos_t pos_next(spool_pos_t pos) {
+    if (++pos.slot == slots_per_sector) {
+        pos.sector = (pos.sector + 1) % sector_count;
+        pos.slot = 1;
+    }
+    return pos;
+}
+
+static uint8_t read_state(spool_pos_t pos) {
+    uint8_t state = 0;
+    if (!flash->read(flash->ctx, slot_offset(pos), &state, 1)) {
+        return 0; // 读失败按损坏处理
+    }
+    return state;
+}
+
+// 整个槽位都是擦除状态 (0xFF) 才能写入
+static bool slot_erased(spool_pos_t pos) {
+    uint8_t slot[SPOOL_RECORD_SIZE];
+    if (!flash->read(flash->ctx, slot_offset(pos), slot, sizeof(slot))) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(slot); i++) {
+        if (slot[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool read_header(uint32_t sector, uint32_t *seq) {
+    spool_header_t header;
+    spool_pos_t pos = { sector, 0 };
+    if (!flash->read(flash->ctx, slot_offset(pos), &header, sizeof(header))) {
+        return false;
+    }
+    if (header.state != SLOT_HEADER || header.magic != HEADER_MAGIC || header.crc != slot_crc(&header)) {
+        return false;
+    }
+    *seq = header.sector_seq;
+    return true;
+}
+
+// 擦除并启用 head 之后的扇区. 该扇区里还没消费的记录是最旧的数据, 直接覆盖.
+static bool start_next_sector(void) {
+    bool empty = pos_equal(tail, head);
+    uint32_t next = (head.sector + 1) % sector_count;
+
+    if (!empty && tail.sector == next) {
+        uint32_t lost = slots_per_sector - tail.slot;
+        overwritten += lost;
+        pending = pending > lost ? pending - lost : 0;
+        tail.sector = (next + 1) % sector_count;
+        tail.slot = 1;
+        peek_valid = false;
+    }
+
+    spool_header_t header;
+    memset(&header, 0xFF, sizeof(header));
+    header.state = SLOT_HEADER;
+    header.magic = HEADER_MAGIC;
+    header.sector_seq = head_seq + 1;
+    header.crc = slot_crc(&header);
+
+    head.sector = next;
+    head.slot = 1;
+    head_seq++;
+    if (empty) {
+        tail = head;
+    }
+
+    uint32_t base = next * flash->sector_size;
+    if (!flash->erase(flash->ctx, base, flash->sector_size)) {
+        return false;
+    }
+    return flash->write(flash->ctx, base, &header, sizeof(header));
+}
+
+bool TelemetrySpool_Begin(const spool_flash_t *spool_flash) {
+    if (spool_flash == NULL || spool_flash->sector_size == 0 ||
+        spool_flash->sector_size % SPOOL_RECORD_SIZE != 0 ||
+        spool_flash->size % spool_flash->sector_size != 0 ||
+        spool_flash->size / spool_flash->sector_size < 2 ||
+        spool_flash->sector_size / SPOOL_RECORD_SIZE < 2) {
+        return false;
+    }
+    flash = spool_flash;
+    sector_count = flash->size / flash->sector_size;
+    slots_per_sector = flash->sector_size / SPOOL_RECORD_SIZE;
+    pending = 0;
+    overwritten = 0;
+    peek_valid = false;
+
+    // 扇区序号最大的就是当前写入扇区
+    bool found = false;
+    head_seq = 0;
+    for (uint32_t sector = 0; sector < sector_count; sector++) {
+        uint32_t seq;
+        if (read_header(sector, &seq) && (!found || seq > head_seq)) {
+            found = true;
+            head_seq = seq;
+            head.sector = sector;
+        }
+    }
+
+    if (!found) {
+        // 全新的分区: 从 0 号扇区开始
+        head.sector = sector_count - 1;
+        head.slot = slots_per_sector;
+        tail = head;
+        return start_next_sector();
+    }
+
+    // head 在最后一个写过的槽位之后. 不能取第一个状态为空的槽位: 追加时先写内容
+    // 后写状态, 掉电留下的半条记录状态仍为 0xFF, 在它上面再写会和残留的位混在一起.
+    head.slot = 1;
+    for (uint32_t slot = slots_per_sector - 1; slot >= 1; slot--) {
+        spool_pos_t pos = { head.sector, slot };
+        if (!slot_erased(pos)) {
+            head.slot = slot + 1;
+            break;
+        }
+    }
+
+    // 从最旧的扇区 (head 之后) 开始找第一条未消费的记录.
+    // 记录按顺序消费, 扇区最后一条已消费说明整个扇区都已消费.
+    tail = head;
+    for (uint32_t k = 1; k <= sector_count; k++) {
+        uint32_t sector = (head.sector + k) % sector_count;
+        uint32_t seq;
+        if (!read_header(sector, &seq)) {
+            continue;
+        }
+        uint32_t end = (sector == head.sector) ? head.slot : slots_per_sector;
+        if (end <= 1) {
+            continue;
+        }
+        spool_pos_t last = { sector, end - 1 };
+        if (read_state(last) == SLOT_CONSUMED) {
+            continue;
+        }
+        for (uint32_t slot = 1; slot < end; slot++) {
+            spool_pos_t pos = { sector, slot };
+            if (read_state(pos) != SLOT_CONSUMED) {
+                tail = pos;
+                break;
+            }
+        }
+        break;
+    }
+
+    for (spool_pos_t pos = tail; pos.sector != head.sector; ) {
+        pending += slots_per_sector - pos.slot;
+        pos.sector = (pos.sector + 1) % sector_count;
+        pos.slot = 1;
+    }
+    pending += head.slot - (tail.sector == head.sector ? tail.slot : 1);
+
+    // 掉电前刚好写满扇区, 还没来得及启用下一个
+    if (head.slot == slots_per_sector) {
+        return start_next_sector();
+    }
+    return true;
+}
+
+bool TelemetrySpool_Append(const SensorSnapshot *sample, uint16_t boot) {
+    if (flash == NULL) {
+        return false;
+    }
+
+    spool_record_t record;
+    memset(&record, 0xFF, sizeof(record));
+    record.boot = boot;
+    record.sequence = sample->sequence;
+    record.timestamp_ms = sample->timestamp_ms;
+    record.lm75_centi = sample->lm75_centi;
+    record.sht20_temp_centi = sample->sht20_temp_centi;
+    record.sht20_humi_centi = sample->sht20_humi_centi;
+    record.esp32_centi = sample->esp32_centi;
+    record.ram_free = sample->ram_free;
+    record.cpu_usage = sample->cpu_usage;
+    record.wifi_rssi = sample->wifi_rssi;
+    record.crc = slot_crc(&record);
+
+    // 先写内容 (状态字节保持 0xFF), 再写状态: 中途掉电的记录不会被当成有效数据
+    uint32_t offset = slot_offset(head);
+    bool ok = flash->write(flash->ctx, offset, &record, sizeof(record));
+    uint8_t state = SLOT_WRITTEN;
+    ok = ok && flash->write(flash->ctx, offset, &state, 1);
+
+    head.slot++;
+    pending++;
+    if (head.slot == slots_per_sector) {
+        ok = start_next_sector() && ok;
+    }
+    return ok;
+}
+
+size_t TelemetrySpool_Peek(SensorSnapshot *out, size_t max_count, uint16_t *boot) {
+    size_t count = 0;
+    peek_valid = false;
+    if (flash == NULL) {
+        return 0;
+    }
+
+    spool_pos_t pos = tail;
+    while (!pos_equal(pos, head) && count < max_count) {
+        spool_record_t record;
+        if (flash->read(flash->ctx, slot_offset(pos), &record, sizeof(record)) &&
+            record.state == SLOT_WRITTEN && record.crc == slot_crc(&record)) {
+            if (count > 0 && record.boot != *boot) {
+                break; // 不同启动的记录放到下一批
+            }
+            *boot = record.boot;
+            SensorSnapshot &sample = out[count++];
+            memset(&sample, 0, sizeof(sample));
+            sample.sequence = record.sequence;
+            sample.timestamp_ms = record.timestamp_ms;
+            sample.lm75_centi = record.lm75_centi;
+            sample.sht20_temp_centi = record.sht20_temp_centi;
+            sample.sht20_humi_centi = record.sht20_humi_centi;
+            sample.esp32_centi = record.esp32_centi;
+            sample.ram_free = record.ram_free;
+            sample.cpu_usage = record.cpu_usage;
+            sample.wifi_rssi = record.wifi_rssi;
+        }
+        pos = pos_next(pos);
+    }
+
+    peek_end = pos;
+    peek_valid = true;
+    return count;
+}
+
+void TelemetrySpool_Commit(void) {
+    if (!peek_valid) {
+        return;
+    }
+    const uint8_t state = SLOT_CONSUMED;
+    for (spool_pos_t pos = tail; !pos_equal(pos, peek_end); pos = pos_next(pos)) {
+        flash->write(flash->ctx, slot_offset(pos), &state, 1);
+        if (pending > 0) {
+            pending--;
+        }
+    }
+    tail = peek_end;
+    peek_valid = false;
+}
+
+uint32_t TelemetrySpool_Pending(void) {
+    return pending;
+}
+
+uint32_t TelemetrySpool_Overwritten(void) {
+    return overwritten;
+}
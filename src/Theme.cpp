@@ -0,0 +1,102 @@
+#include "Theme.h"
+
+lv_style_t theme_screen;
+lv_style_t theme_page;
+lv_style_t theme_page_cool;
+lv_style_t theme_plain;
+lv_style_t theme_card;
+
+lv_style_t theme_text;
+lv_style_t theme_text_cool;
+lv_style_t theme_text_muted;
+lv_style_t theme_text_accent;
+lv_style_t theme_text_center;
+
+lv_style_t theme_font_12;
+lv_style_t theme_font_14;
+lv_style_t theme_font_16;
+lv_style_t theme_font_18;
+lv_style_t theme_font_20;
+lv_style_t theme_font_22;
+lv_style_t theme_font_24;
+lv_style_t theme_font_28;
+lv_style_t theme_font_48;
+
+lv_style_t theme_bar;
+lv_style_t theme_bar_accent;
+lv_style_t theme_bar_danger;
+
+static void init_font(lv_style_t *style, const lv_font_t *font) {
+    lv_style_init(style);
+    lv_style_set_text_font(style, font);
+}
+
+static void init_text_color(lv_style_t *style, lv_color_t color) {
+    lv_style_init(style);
+    lv_style_set_text_color(style, color);
+}
+
+void Theme_Init(void) {
+    static bool inited = false;
+    if (inited) {
+        return;
+    }
+    inited = true;
+
+    lv_style_init(&theme_screen);
+    lv_style_set_bg_color(&theme_screen, THEME_COLOR_BG);
+    lv_style_set_bg_opa(&theme_screen, LV_OPA_COVER);
+
+    lv_style_init(&theme_page);
+    lv_style_set_bg_color(&theme_page, THEME_COLOR_BG);
+    lv_style_set_bg_opa(&theme_page, LV_OPA_COVER);
+    lv_style_set_pad_all(&theme_page, THEME_PAGE_PAD);
+
+    lv_style_init(&theme_page_cool);
+    lv_style_set_bg_color(&theme_page_cool, THEME_COLOR_BG_COOL);
+    lv_style_set_bg_opa(&theme_page_cool, LV_OPA_COVER);
+    lv_style_set_pad_all(&theme_page_cool, THEME_PAGE_PAD);
+
+    lv_style_init(&theme_plain);
+    lv_style_set_bg_opa(&theme_plain, LV_OPA_TRANSP);
+    lv_style_set_border_width(&theme_plain, 0);
+    lv_style_set_pad_all(&theme_plain, 10);
+
+    lv_style_init(&theme_card);
+    lv_style_set_bg_color(&theme_card, THEME_COLOR_SURFACE);
+    lv_style_set_border_color(&theme_card, THEME_COLOR_BORDER);
+    lv_style_set_border_width(&theme_card, 2);
+    lv_style_set_radius(&theme_card, 12);
+    lv_style_set_shadow_width(&theme_card, 8);
+    lv_style_set_shadow_color(&theme_card, lv_color_black());
+    lv_style_set_shadow_opa(&theme_card, LV_OPA_10);
+
+    init_text_color(&theme_text, THEME_COLOR_TEXT);
+    init_text_color(&theme_text_cool, THEME_COLOR_TEXT_COOL);
+    init_text_color(&theme_text_muted, THEME_COLOR_MUTED);
+    init_text_color(&theme_text_accent, THEME_COLOR_ACCENT);
+
+    lv_style_init(&theme_text_center);
+    lv_style_set_width(&theme_text_center, lv_pct(100));
+    lv_style_set_text_align(&theme_text_center, LV_TEXT_ALIGN_CENTER);
+
+    init_font(&theme_font_12, &lv_font_montserrat_12);
+    init_font(&theme_font_14, &lv_font_montserrat_14);
+    init_font(&theme_font_16, &lv_font_montserrat_16);
+    init_font(&theme_font_18, &lv_font_montserrat_18);
+    init_font(&theme_font_20, &lv_font_montserrat_20);
+    init_font(&theme_font_22, &lv_font_montserrat_22);
+    init_font(&theme_font_24, &lv_font_montserrat_24);
+    init_font(&theme_font_28, &lv_font_montserrat_28);
+    init_font(&theme_font_48, &lv_font_montserrat_48);
+
+    lv_style_init(&theme_bar);
+    lv_style_set_bg_color(&theme_bar, THEME_COLOR_TRACK);
+    lv_style_set_radius(&theme_bar, 5);
+
+    lv_style_init(&theme_bar_accent);
+    lv_style_set_bg_color(&theme_bar_accent, THEME_COLOR_ACCENT);
+
+    lv_style_init(&theme_bar_danger);
+    lv_style_set_bg_color(&theme_bar_danger, THEME_COLOR_DANGER);
+}
@@ -0,0 +1,157 @@
+#include "TimeService.h"
+#include <Preferences.h>
+#include <sys/time.h>
+#include "esp_sntp.h"
+#include "esp_timer.h"
+
+// 早于该时间 (2020-01-01) 视为系统时间未设置
+#define TIME_VALID_EPOCH   1577836800
+// 漂移估算至少需要的同步间隔, 太短时网络延迟的抖动占比过大
+#define DRIFT_MIN_SPAN_US  (60LL * 1000000)
+// 超出该范围的估算视为时间被外部改动, 不参与平均
+#define DRIFT_MAX_PPM      500
+
+static portMUX_TYPE time_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static bool started = false;
+static volatile time_quality_t quality = TIME_UNSET;
+
+// 以下由 time_mux 保护; 同步回调运行在 lwIP 任务中
+static uint32_t sync_count = 0;
+static int64_t last_sync_mono_us = 0;   // 上次同步时的 esp_timer 时间
+static int64_t last_sync_server_us = 0; // 上次同步时服务器给出的时间
+static int32_t drift_ppm = 0;
+static bool drift_valid = false;
+static uint32_t interval_ms = TIME_SERVICE_MIN_INTERVAL_MS;
+
+static void persist_epoch(time_t epoch) {
+    Preferences prefs;
+    prefs.begin("time", false);
+    prefs.putUInt("epoch", (uint32_t)epoch);
+    prefs.end();
+}
+
+// 允许的累积误差除以漂移, 得到下一次同步前可以等待的时间
+static uint32_t interval_for_drift(int32_t ppm) {
+    uint32_t magnitude = ppm < 0 ? (uint32_t)-ppm : (uint32_t)ppm;
+    if (magnitude == 0) {
+        return TIME_SERVICE_MAX_INTERVAL_MS;
+    }
+    uint64_t ms = (uint64_t)TIME_SERVICE_MAX_ERROR_MS * 1000000ULL / magnitude;
+    if (ms < TIME_SERVICE_MIN_INTERVAL_MS) {
+        return TIME_SERVICE_MIN_INTERVAL_MS;
+    }
+    if (ms > TIME_SERVICE_MAX_INTERVAL_MS) {
+        return TIME_SERVICE_MAX_INTERVAL_MS;
+    }
+    return (uint32_t)ms;
+}
+
+static void time_sync_cb(struct timeval *tv) {
+    int64_t mono_us = esp_timer_get_time();
+    int64_t server_us = (int64_t)tv->tv_sec * 1000000LL + tv->tv_usec;
+
+    portENTER_CRITICAL(&time_mux);
+    // 漂移直接比较服务器时间和单调时钟的增量, 不受 adjtime 校正进度的影响
+    int64_t span_us = mono_us - last_sync_mono_us;
+    if (sync_count > 0 && span_us >= DRIFT_MIN_SPAN_US) {
+        int64_t error_us = (server_us - last_sync_server_us) - span_us;
+        int64_t ppm = error_us * 1000000LL / span_us;
+        if (ppm >= -DRIFT_MAX_PPM && ppm <= DRIFT_MAX_PPM) {
+            // 指数平均, 削弱单次网络延迟的影响
+            drift_ppm = drift_valid ? drift_ppm + (int32_t)(ppm - drift_ppm) / 4 : (int32_t)ppm;
+            drift_valid = true;
+            interval_ms = interval_for_drift(drift_ppm);
+        }
+    }
+    last_sync_mono_us = mono_us;
+    last_sync_server_us = server_us;
+    sync_count++;
+    uint32_t next_interval = interval_ms;
+    portEXIT_CRITICAL(&time_mux);
+
+    if (quality != TIME_SYNCED) {
+        // 首次同步已经直接设好时间, 之后只做平滑校正
+        sntp_set_sync_mode(SNTP_SYNC_MODE_SMOOTH);
+        quality = TIME_SYNCED;
+    }
+    // 在 lwIP 安排下一次请求之前生效
+    sntp_set_sync_interval(next_interval);
+    persist_epoch(tv->tv_sec);
+}
+
+void TimeService_Begin(void) {
+    if (started) {
+        return;
+    }
+    started = true;
+
+    setenv("TZ", TIME_SERVICE_TZ, 1);
+    tzset();
+
+    if (time(NULL) >= TIME_VALID_EPOCH) {
+        quality = TIME_RESTORED; // 软复位: RTC 保留了上次的系统时间
+    } else {
+        Preferences prefs;
+        prefs.begin("time", true);
+        uint32_t saved = prefs.getUInt("epoch", 0);
+        prefs.end();
+        if (saved >= TIME_VALID_EPOCH) {
+            // 误差至少是断电时长, 首次 SNTP 同步时直接覆盖
+            struct timeval tv = { (time_t)saved, 0 };
+            settimeofday(&tv, NULL);
+            quality = TIME_RESTORED;
+        }
+    }
+
+    // 恢复的时间可能相差很久, 首次同步直接设置; 平滑模式在同步回调中启用
+    sntp_set_sync_mode(SNTP_SYNC_MODE_IMMED);
+    sntp_set_time_sync_notification_cb(time_sync_cb);
+    sntp_set_sync_interval(interval_ms);
+    configTzTime(TIME_SERVICE_TZ, TIME_SERVICE_NTP_SERVER);
+    Serial.printf("Time service started (%s time).\n",
+        quality == TIME_RESTORED ? "restored" : "no");
+}
+
+time_quality_t TimeService_Quality(void) {
+    return quality;
+}
+
+bool TimeService_LocalTime(struct tm *out) {
+    if (quality == TIME_UNSET) {
+        return false;
+    }
+    time_t now = time(NULL);
+    localtime_r(&now, out);
+    return true;
+}
+
+uint64_t TimeService_EpochMs(void) {
+    if (quality != TIME_SYNCED) {
+        return 0;
+    }
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000;
+}
+
+void TimeService_GetStatus(TimeServiceStatus *out) {
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&time_mux);
+    out->quality = quality;
+    out->sync_count = sync_count;
+    out->last_sync_age_ms = sync_count ? (uint32_t)((now_us - last_sync_mono_us) / 1000) : UINT32_MAX;
+    out->drift_ppm = drift_ppm;
+    out->interval_ms = interval_ms;
+    portEXIT_CRITICAL(&time_mux);
+}
+
+void TimeService_Print(void) {
+    static const char *const QUALITY_NAMES[] = { "unset", "restored", "synced" };
+    TimeServiceStatus status;
+    TimeService_GetStatus(&status);
+    Serial.printf("Time: %s, syncs=%lu, last sync %lds ago, drift=%ldppm, interval=%lus\n",
+        QUALITY_NAMES[status.quality], (unsigned long)status.sync_count,
+        status.sync_count ? (long)(status.last_sync_age_ms / 1000) : -1L,
+        (long)status.drift_ppm, (unsigned long)(status.interval_ms / 1000));
+}
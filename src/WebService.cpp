@@ -1,109 +1,496 @@
 #include "WebService.h"
+#include "SensorHub.h"
+#include "CpuLoad.h"
+#include "PerfStats.h"
+#include "TelemetryPayload.h"
+#include "TelemetrySpool.h"
+#include "SpoolPartition.h"
+#include "TimeService.h"
 #include <Preferences.h>
 #include <HTTPClient.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
 
 Preferences WiFi_Settings;
+
+// 上报服务器: 编译时用 -D SERVER_URL=\"http://host:port/\" 指定默认值,
+// 运行时用 WebService_SetServerUrl() 改写 (保存在 NVS "telemetry"/"server_url")
+#ifndef SERVER_URL
 #define SERVER_URL "http://192.168.31.228:3000/"
+#endif
+#define SERVER_URL_MAX            96
+#define UPLOAD_PATH               "api/iot-data/batch"
+
+// 上报任务: 常驻, 由队列驱动, 复用同一条 keep-alive 连接
+#define UPLOAD_QUEUE_LEN          4     // 最多积压的上报窗口
+#define UPLOAD_TASK_STACK         4096
+#define UPLOAD_TASK_PRIORITY      1
+#define UPLOAD_CONNECT_TIMEOUT_MS 2000  // TCP 建连超时
+#define UPLOAD_IO_TIMEOUT_MS      3000  // 发送请求/等待响应超时
+#define SPOOL_REPLAY_MAX_BATCHES  2     // 每个上报间隔最多重发的离线批次数
+#define SPOOL_REPLAY_BUDGET_MS    3000  // 每个上报间隔用于重发的时间上限
+
+// 上报编码: 默认 JSON, 编译时定义 TELEMETRY_USE_CBOR 改用 CBOR
+#ifdef TELEMETRY_USE_CBOR
+#define UPLOAD_CONTENT_TYPE       "application/cbor"
+#else
+#define UPLOAD_CONTENT_TYPE       "application/json"
+#endif
+
+// loop() 交给上报任务的一个上报窗口的统计; 采样本身由上报任务从 SensorHub 的历史中取
+typedef struct {
+    CpuLoadReport cpu_report;
+    PerfReport perf_report;
+} UploadWindow;
+
+static QueueHandle_t uploadQueue = NULL;
+static TaskHandle_t uploadTaskHandle = NULL;
+static upload_observer_t uploadObserver = NULL;
+
+// 当前服务器地址, 任何任务都可能改写, 用 serverUrlMux 保护
+static portMUX_TYPE serverUrlMux = portMUX_INITIALIZER_UNLOCKED;
+static char serverUrl[SERVER_URL_MAX];
+static uint32_t serverUrlVersion = 0;  // 0: 尚未从 NVS 读取
+
+// 以下只在上报任务中访问
+static WiFiClient uploadClient;
+static HTTPClient uploadHttp;
+static String uploadUrl;
+static uint32_t uploadUrlVersion = 0;
+static SensorSnapshot batchSamples[TELEMETRY_BATCH_MAX_SAMPLES];
+static char uploadPayload[TELEMETRY_PAYLOAD_MAX];
+static spool_flash_t spoolFlash;
+static bool spoolReady = false;
+static uint16_t bootCount = 0;
+static bool firstUploadDone = false;
+
+// 快速重连: 上次成功连接的 AP (BSSID, 信道) 保存在 "wifi-creds" 中, 开机时直接关联
+// 这个 AP, 跳过全信道扫描. 失败时清除缓存, 回退到完整连接. 地址默认每次仍走 DHCP.
+// 编译时定义 WIFI_CACHE_LEASE=1 会连地址一起缓存并一直沿用, 相当于静态地址: 不续租,
+// 路由器回收租约后可能把地址分给别的设备. 只应在路由器为本设备保留了地址时打开.
+#define WIFI_FAST_JOIN_TIMEOUT_MS 1500
+#define WIFI_FULL_JOIN_TIMEOUT_MS 10000
+#ifndef WIFI_CACHE_LEASE
+#define WIFI_CACHE_LEASE 0
+#endif
 
-// 新增：后台任务句柄
-TaskHandle_t sendDataTaskHandle = NULL;
+// 固定地址: 编译时用逗号分隔的四个字节指定, 例如 -D WIFI_STATIC_IP=192,168,31,50
+// -D WIFI_STATIC_GATEWAY=192,168,31,1; 此时不缓存 DHCP 地址
+#ifdef WIFI_STATIC_IP
+#ifndef WIFI_STATIC_SUBNET
+#define WIFI_STATIC_SUBNET 255,255,255,0
+#endif
+#ifndef WIFI_STATIC_DNS
+#define WIFI_STATIC_DNS WIFI_STATIC_GATEWAY
+#endif
+#endif
+
+typedef struct {
+    uint8_t bssid[6];
+    uint8_t channel;        // 0: 没有缓存
+    uint32_t ip;            // 0: 没有缓存的地址, 走 DHCP
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+} wifi_cache_t;
+
+// 需在 WiFi_Settings 打开 "wifi-creds" 时调用
+static void load_wifi_cache(wifi_cache_t *cache) {
+    memset(cache, 0, sizeof(*cache));
+    if (WiFi_Settings.getBytes("bssid", cache->bssid, sizeof(cache->bssid)) != sizeof(cache->bssid)) {
+        return;
+    }
+    cache->channel = WiFi_Settings.getUChar("channel", 0);
+    // 不缓存地址时也不读取, 旧固件存下的地址不再使用
+#if WIFI_CACHE_LEASE && !defined(WIFI_STATIC_IP)
+    cache->ip = WiFi_Settings.getUInt("ip", 0);
+    cache->gateway = WiFi_Settings.getUInt("gateway", 0);
+    cache->subnet = WiFi_Settings.getUInt("subnet", 0);
+    cache->dns = WiFi_Settings.getUInt("dns", 0);
+#endif
+}
+
+static void store_wifi_cache(const wifi_cache_t *cache) {
+    WiFi_Settings.begin("wifi-creds", false);
+    if (cache == NULL) {
+        WiFi_Settings.remove("bssid");
+        WiFi_Settings.remove("channel");
+        WiFi_Settings.remove("ip");
+        WiFi_Settings.remove("gateway");
+        WiFi_Settings.remove("subnet");
+        WiFi_Settings.remove("dns");
+    } else {
+        WiFi_Settings.putBytes("bssid", cache->bssid, sizeof(cache->bssid));
+        WiFi_Settings.putUChar("channel", cache->channel);
+        WiFi_Settings.putUInt("ip", cache->ip);
+        WiFi_Settings.putUInt("gateway", cache->gateway);
+        WiFi_Settings.putUInt("subnet", cache->subnet);
+        WiFi_Settings.putUInt("dns", cache->dns);
+    }
+    WiFi_Settings.end();
+}
+
+// 连上后记下当前的 AP 和地址, 与缓存相同时不写 NVS
+static void update_wifi_cache(const wifi_cache_t *old_cache) {
+    wifi_cache_t cache = {};
+    uint8_t *bssid = WiFi.BSSID();
+    if (bssid == NULL) {
+        return;
+    }
+    memcpy(cache.bssid, bssid, sizeof(cache.bssid));
+    cache.channel = (uint8_t)WiFi.channel();
+#if WIFI_CACHE_LEASE && !defined(WIFI_STATIC_IP)
+    cache.ip = WiFi.localIP();
+    cache.gateway = WiFi.gatewayIP();
+    cache.subnet = WiFi.subnetMask();
+    cache.dns = WiFi.dnsIP();
+#endif
+    if (memcmp(&cache, old_cache, sizeof(cache)) != 0) {
+        store_wifi_cache(&cache);
+    }
+}
+
+// 设置地址: 固定地址, 缓存的地址, 或者 (ip 为 0 时) DHCP
+static void config_address(const wifi_cache_t *cache) {
+#ifdef WIFI_STATIC_IP
+    (void)cache;
+    WiFi.config(IPAddress(WIFI_STATIC_IP), IPAddress(WIFI_STATIC_GATEWAY),
+                IPAddress(WIFI_STATIC_SUBNET), IPAddress(WIFI_STATIC_DNS));
+#else
+    if (cache != NULL && cache->ip != 0) {
+        WiFi.config(IPAddress(cache->ip), IPAddress(cache->gateway), IPAddress(cache->subnet), IPAddress(cache->dns));
+    } else {
+        WiFi.config(IPAddress(), IPAddress(), IPAddress());
+    }
+#endif
+}
+
+// give_up_on_failure: 驱动报告找不到 AP 或连接失败时不再等到超时 (直接关联只扫一个信道, 很快就有结果)
+static bool wait_connected(uint32_t timeout_ms, bool give_up_on_failure) {
+    uint32_t start = millis();
+    while (millis() - start < timeout_ms) {
+        wl_status_t status = WiFi.status();
+        if (status == WL_CONNECTED) {
+            return true;
+        }
+        if (give_up_on_failure && (status == WL_NO_SSID_AVAIL || status == WL_CONNECT_FAILED)) {
+            return false;
+        }
+        delay(10);
+    }
+    return WiFi.status() == WL_CONNECTED;
+}
 
 bool Init_Connection() {
     // 读取WiFi配置
     WiFi_Settings.begin("wifi-creds", false);
     String ssid = WiFi_Settings.getString("ssid", "");
     String password = WiFi_Settings.getString("password", "");
+    wifi_cache_t cache;
+    load_wifi_cache(&cache);
     WiFi_Settings.end();
 
-    if (ssid.length() > 0 && password.length() > 0) {
-        WiFi.begin(ssid.c_str(), password.c_str());
-        Serial.printf("Connecting to WiFi SSID: %s\n", ssid.c_str());
-
-        unsigned long startAttemptTime = millis();
-        const unsigned long timeout = 10000; // 10秒超时
-
-        while (WiFi.status() != WL_CONNECTED && millis() - startAttemptTime < timeout) {
-            delay(100);
-        }
+    if (ssid.length() == 0 || password.length() == 0) {
+        Serial.println("Cannot connect to WiFi, no credentials found.");
+        return false;
+    }
 
-        if (WiFi.status() == WL_CONNECTED) {
-            Serial.println("WiFi connected.");
+    uint32_t start = millis();
+    if (cache.channel != 0) {
+        Serial.printf("Connecting to WiFi SSID: %s (cached AP, channel %u)\n", ssid.c_str(), cache.channel);
+        config_address(&cache);
+        WiFi.begin(ssid.c_str(), password.c_str(), cache.channel, cache.bssid);
+        if (wait_connected(WIFI_FAST_JOIN_TIMEOUT_MS, true)) {
+            Serial.printf("WiFi connected (fast join, %lums).\n", (unsigned long)(millis() - start));
             return true;
-        } else {
-            Serial.println("WiFi connection failed.");
-            return false;
         }
-    } else {
-        Serial.println("Cannot connect to WiFi, no credentials found.");
+        // AP 换了信道, 换了设备或者不在范围内: 缓存作废, 走完整的扫描和 DHCP
+        Serial.println("Fast join failed, falling back to full scan.");
+        WiFi.disconnect();
+        store_wifi_cache(NULL);
+        cache.channel = 0;
+        cache.ip = 0;
+    }
+
+    Serial.printf("Connecting to WiFi SSID: %s\n", ssid.c_str());
+    config_address(NULL);
+    WiFi.begin(ssid.c_str(), password.c_str());
+    if (!wait_connected(WIFI_FULL_JOIN_TIMEOUT_MS, false)) {
+        Serial.println("WiFi connection failed.");
         return false;
     }
+    Serial.printf("WiFi connected (full scan, %lums).\n", (unsigned long)(millis() - start));
+    update_wifi_cache(&cache);
+    return true;
 }
 
-// 新增：后台任务函数
-void SendSensorDataTask(void *parameter) {
-    // 拷贝数据，防止主线程变量变化
-    float lm75 = lm75_temp;
-    float sht20t = sht20_temp;
-    float sht20h = sht20_humi;
-    float esp32t = esp32_temp;
-    int ram = ram_free;
-    int cpu = cpu_usage;
-    int rssi = wifi_rssi;
+static void store_server_url(const char *url) {
+    portENTER_CRITICAL(&serverUrlMux);
+    strncpy(serverUrl, url, sizeof(serverUrl) - 1);
+    serverUrl[sizeof(serverUrl) - 1] = '\0';
+    serverUrlVersion++;
+    portEXIT_CRITICAL(&serverUrlMux);
+}
 
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("WiFi not connected, cannot send data.");
-        sendDataTaskHandle = NULL;
-        vTaskDelete(NULL);
+// 首次使用时读取 NVS 中保存的地址, 没有则用编译时的默认值
+static void load_server_url() {
+    if (serverUrlVersion != 0) {
         return;
     }
+    Preferences telemetry;
+    telemetry.begin("telemetry", true);
+    String url = telemetry.getString("server_url", SERVER_URL);
+    telemetry.end();
+    store_server_url(url.c_str());
+}
 
-    HTTPClient *http = new HTTPClient();
-    String url = String(SERVER_URL) + "api/iot-data";
-    http->begin(url);
-    http->addHeader("Content-Type", "application/json");
+bool WebService_SetServerUrl(const char *url) {
+    Preferences telemetry;
+    if (url == NULL || url[0] == '\0') {
+        telemetry.begin("telemetry", false);
+        telemetry.remove("server_url");
+        telemetry.end();
+        store_server_url(SERVER_URL);
+        return true;
+    }
+    size_t len = strlen(url);
+    bool slash = url[len - 1] == '/';
+    if (strncmp(url, "http://", 7) != 0 || len + (slash ? 0 : 1) >= SERVER_URL_MAX) {
+        Serial.printf("Invalid server url: %s\n", url);
+        return false;
+    }
+    char normalized[SERVER_URL_MAX];
+    snprintf(normalized, sizeof(normalized), "%s%s", url, slash ? "" : "/");
 
-    String payload = "{";
-    payload += "\"lm75_temp\":" + String(lm75, 2) + ",";
-    payload += "\"sht20_temp\":" + String(sht20t, 2) + ",";
-    payload += "\"sht20_humi\":" + String(sht20h, 2) + ",";
-    payload += "\"esp32_temp\":" + String(esp32t, 2) + ",";
-    payload += "\"ram_free\":" + String(ram) + ",";
-    payload += "\"cpu_usage\":" + String(cpu) + ",";
-    payload += "\"wifi_rssi\":" + String(rssi);
-    payload += "}";
+    telemetry.begin("telemetry", false);
+    telemetry.putString("server_url", normalized);
+    telemetry.end();
+    store_server_url(normalized);
+    Serial.printf("Server url set to %s\n", normalized);
+    return true;
+}
 
-    Serial.print("Sending payload: ");
-    Serial.println(payload);
+String WebService_GetServerUrl() {
+    load_server_url();
+    char url[SERVER_URL_MAX];
+    portENTER_CRITICAL(&serverUrlMux);
+    memcpy(url, serverUrl, sizeof(url));
+    portEXIT_CRITICAL(&serverUrlMux);
+    return String(url);
+}
 
-    int httpResponseCode = http->POST(payload);
+void WebService_SetUploadObserver(upload_observer_t observer) {
+    uploadObserver = observer;
+}
 
-    if (httpResponseCode > 0) {
-        Serial.printf("Data sent, response code: %d\n", httpResponseCode);
-        String response = http->getString();
-        Serial.print("Server response: ");
-        Serial.println(response);
+// 服务器地址改变后重建上报地址, 旧主机上的 keep-alive 连接不再复用
+static void refresh_upload_url() {
+    load_server_url();
+    if (uploadUrlVersion == serverUrlVersion) {
+        return;
+    }
+    uploadUrlVersion = serverUrlVersion;
+    uploadUrl = WebService_GetServerUrl() + UPLOAD_PATH;
+    uploadClient.stop();
+}
+
+// 启动次数, 用于区分不同启动的 millis() 时基
+static uint16_t load_boot_count() {
+    Preferences telemetry;
+    telemetry.begin("telemetry", false);
+    uint16_t boot = telemetry.getUShort("boot", 0) + 1;
+    telemetry.putUShort("boot", boot);
+    telemetry.end();
+    return boot;
+}
+
+// 编码并发送一批数据, 服务器返回 2xx 时返回 true
+static bool post_batch(const TelemetryBatch &batch) {
+    CpuLoad_SlotEnter(CPU_SLOT_UPLOAD);
+#ifdef TELEMETRY_USE_CBOR
+    size_t payload_len = TelemetryPayload_EncodeBatchCbor(&batch, (uint8_t *)uploadPayload, sizeof(uploadPayload));
+#else
+    size_t payload_len = TelemetryPayload_EncodeBatch(&batch, uploadPayload, sizeof(uploadPayload));
+#endif
+    CpuLoad_SlotExit(CPU_SLOT_UPLOAD); // 网络阻塞等待不计入本任务的CPU时间
+    if (payload_len == 0) {
+        Serial.println("Error sending data: payload too large");
+        return false;
+    }
+    Serial.printf("Sending %s batch: %u samples (boot %u, seq %lu-%lu), %u bytes, %lu dropped\n",
+        batch.replay ? "spooled" : "live", (unsigned)batch.count, (unsigned)batch.boot,
+        (unsigned long)batch.samples[0].sequence, (unsigned long)batch.samples[batch.count - 1].sequence,
+        (unsigned)payload_len, (unsigned long)batch.dropped);
+
+    uint32_t send_start = micros();
+    // 连接仍然存活时 begin() 不会重新建连
+    if (!uploadHttp.begin(uploadClient, uploadUrl)) {
+        Serial.println("Error sending data: invalid server url");
+        return false;
+    }
+    uploadHttp.addHeader("Content-Type", UPLOAD_CONTENT_TYPE);
+    int httpResponseCode = uploadHttp.POST((uint8_t *)uploadPayload, payload_len);
+
+    if (httpResponseCode <= 0) {
+        Serial.printf("Error sending data: %s\n", uploadHttp.errorToString(httpResponseCode).c_str());
+        uploadHttp.end();
+        uploadClient.stop(); // 出错的连接不再复用
     } else {
-        Serial.printf("Error sending data: %s\n", http->errorToString(httpResponseCode).c_str());
-    }
-
-    http->end();
-    delete http; // 释放HTTPClient对象，防止内存泄漏
-    sendDataTaskHandle = NULL; // 任务结束，重置句柄
-    vTaskDelete(NULL); // 任务完成后自删除
-}
-
-// 修改：将原同步函数改为只创建任务
-void SendSensorDataToServer() {
-    if (sendDataTaskHandle == NULL) {
-        xTaskCreate(
-            SendSensorDataTask,   // 任务函数
-            "SendSensorDataTask",// 名称
-            4096,                 // 堆栈大小
-            NULL,                 // 参数
-            1,                    // 优先级
-            &sendDataTaskHandle   // 任务句柄
-        );
+        Serial.printf("Data sent, response code: %d (%lums)\n",
+            httpResponseCode, (unsigned long)((micros() - send_start) / 1000));
+        // 必须读完响应体, 连接才能被下一次请求复用
+        Serial.print("Server response: ");
+        uploadHttp.writeToStream(&Serial);
+        Serial.println();
+        uploadHttp.end();
+        if (!firstUploadDone && httpResponseCode >= 200 && httpResponseCode < 300) {
+            firstUploadDone = true;
+            Serial.printf("First upload done %lums after boot.\n", (unsigned long)millis());
+        }
+    }
+
+    if (uploadObserver != NULL) {
+        UploadResult result;
+        result.http_code = httpResponseCode;
+        result.latency_us = micros() - send_start;
+        result.samples = batch.count;
+        result.replay = batch.replay;
+        uploadObserver(&result);
+    }
+    return httpResponseCode >= 200 && httpResponseCode < 300;
+}
+
+// 发送失败的实时采样写入离线缓存
+static void spool_samples(const SensorSnapshot *samples, size_t count) {
+    if (!spoolReady) {
+        Serial.printf("No spool partition, %u samples lost.\n", (unsigned)count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        TelemetrySpool_Append(&samples[i], bootCount);
+    }
+    Serial.printf("Spooled %u samples, %lu pending, %lu overwritten.\n", (unsigned)count,
+        (unsigned long)TelemetrySpool_Pending(), (unsigned long)TelemetrySpool_Overwritten());
+}
+
+// 在实时数据发送成功后重发离线缓存, 每个上报间隔限批次数和时间, 不挤占实时上报
+static void replay_spool() {
+    uint32_t replay_start = millis();
+    for (int n = 0; n < SPOOL_REPLAY_MAX_BATCHES && TelemetrySpool_Pending() > 0; n++) {
+        if (millis() - replay_start >= SPOOL_REPLAY_BUDGET_MS) {
+            break;
+        }
+        TelemetryBatch batch = {};
+        batch.samples = batchSamples;
+        batch.count = TelemetrySpool_Peek(batchSamples, TELEMETRY_BATCH_MAX_SAMPLES, &batch.boot);
+        if (batch.count == 0) {
+            TelemetrySpool_Commit(); // 只剩损坏的记录, 直接丢弃
+            break;
+        }
+        batch.replay = true;
+        batch.uptime_ms = millis();
+        if (batch.boot == bootCount) {
+            batch.epoch_ms = TimeService_EpochMs(); // 其他启动的 ts 无法换算
+        }
+        if (!post_batch(batch)) {
+            break; // 留在缓存里, 下个间隔再试
+        }
+        TelemetrySpool_Commit();
+    }
+}
+
+static void UploadTask(void *parameter) {
+    (void)parameter;
+    // 连接对象和缓冲区在任务生命周期内只创建一次
+    uploadHttp.setReuse(true); // 请求结束后保留连接, 下次直接复用
+    uploadHttp.setConnectTimeout(UPLOAD_CONNECT_TIMEOUT_MS);
+    uploadHttp.setTimeout(UPLOAD_IO_TIMEOUT_MS);
+
+    bootCount = load_boot_count();
+    spoolReady = SpoolPartition_Open(&spoolFlash) && TelemetrySpool_Begin(&spoolFlash);
+    if (spoolReady) {
+        Serial.printf("Telemetry spool mounted, %lu samples pending.\n", (unsigned long)TelemetrySpool_Pending());
     } else {
-        Serial.println("SendSensorDataTask is already running.");
+        Serial.println("Telemetry spool unavailable, offline samples will be lost.");
+    }
+
+    uint32_t uploaded_seq = 0; // 已发送或已写入离线缓存的最后一条采样
+    UploadWindow window;
+
+    for (;;) {
+        if (xQueueReceive(uploadQueue, &window, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        refresh_upload_url();
+
+        TelemetryBatch batch = {};
+        batch.samples = batchSamples;
+        batch.count = SensorHub_ReadHistory(uploaded_seq, batchSamples, TELEMETRY_BATCH_MAX_SAMPLES);
+        if (batch.count == 0) {
+            Serial.println("No new sensor samples, skip sending.");
+            continue;
+        }
+        batch.boot = bootCount;
+        batch.dropped = batchSamples[0].sequence - uploaded_seq - 1;
+        batch.uptime_ms = millis();
+        batch.epoch_ms = TimeService_EpochMs();
+        batch.cpu_report = &window.cpu_report;
+        batch.perf_report = &window.perf_report;
+        uploaded_seq = batchSamples[batch.count - 1].sequence;
+
+        bool online = WiFi.status() == WL_CONNECTED;
+        if (!online) {
+            Serial.println("WiFi not connected, spooling samples.");
+            uploadClient.stop(); // 旧连接已失效, 重连后重新建立
+        }
+        if (!online || !post_batch(batch)) {
+            spool_samples(batchSamples, batch.count);
+            continue;
+        }
+
+        if (spoolReady) {
+            replay_spool();
+        }
+    }
+}
+
+static bool start_upload_task() {
+    if (uploadTaskHandle != NULL) {
+        return true;
+    }
+    if (uploadQueue == NULL) {
+        uploadQueue = xQueueCreate(UPLOAD_QUEUE_LEN, sizeof(UploadWindow));
+        if (uploadQueue == NULL) {
+            return false;
+        }
+    }
+    return xTaskCreate(
+        UploadTask,             // 任务函数
+        "UploadTask",           // 名称
+        UPLOAD_TASK_STACK,      // 堆栈大小
+        NULL,                   // 参数
+        UPLOAD_TASK_PRIORITY,   // 优先级
+        &uploadTaskHandle       // 任务句柄
+    ) == pdPASS;
+}
+
+// 在 loop() 中每 TELEMETRY_UPLOAD_INTERVAL_MS 调用一次: 结束当前上报窗口,
+// 交给常驻上报任务把窗口内的全部采样作为一批发送
+bool SendSensorDataToServer() {
+    if (!start_upload_task()) {
+        Serial.println("Failed to start upload task.");
+        return false;
     }
-}
\ No newline at end of file
+
+    UploadWindow window;
+    // CPU占用率以上报间隔为统计窗口
+    CpuLoad_TakeReport(&window.cpu_report);
+    PerfStats_Take(&window.perf_report, true);
+
+    if (xQueueSend(uploadQueue, &window, 0) != pdTRUE) {
+        Serial.println("Upload queue full, dropping window.");
+        return false;
+    }
+    return true;
+}
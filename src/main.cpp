@@ -2,6 +2,16 @@
 #include <TFT_eSPI.h>       // 引入TFT_eSPI库
 #include <lvgl.h>           // 引入LVGL库
 #include "Pages.h"       // 引入页面管理头文件
+#include "SHT20.h"       // 非阻塞SHT20驱动
+#include "SensorHub.h"   // 传感器采集任务
+#include "CpuLoad.h"     // CPU占用率统计
+#include "PerfStats.h"   // 帧时间与flush吞吐统计
+#include "ButtonInput.h" // 中断驱动的按键事件
+#include "TelemetryPayload.h" // 批量上报间隔
+#include "TelemetryBench.h" // 上报编码对比
+#include "TimeService.h"    // 全局时间 (SNTP)
+#include "Router.h"         // 页面路由与缓存
+#include "Theme.h"          // 页面共用样式
 #include <Preferences.h> // 引入Preferences库，用于存储设置状态
 #include <Wire.h> // 用于I2C
 #include <WiFi.h> // 用于WiFi信号强度读取
@@ -20,91 +30,57 @@ TFT_eSPI tft = TFT_eSPI(); // 创建一个TFT对象
 static const uint16_t screenWidth  = 320;
 static const uint16_t screenHeight = 240;
 
-// 2. 定义LVGL的显示缓冲区
-static lv_color_t buf_1[screenWidth * 40];
+// 2. 定义LVGL的显示缓冲区 (双缓冲: LVGL 渲染一块的同时 DMA 发送另一块)
+#define DRAW_BUF_LINES 40
+static uint16_t draw_buf_1[screenWidth * DRAW_BUF_LINES] __attribute__((aligned(4)));
+static uint16_t draw_buf_2[screenWidth * DRAW_BUF_LINES] __attribute__((aligned(4)));
+
+// 3. LVGL的显示刷新回调函数 (DMA版)
+// pushImageDMA() 只把传输排入 SPI 队列就返回, 因此可以立即调用
+// lv_display_flush_ready(), LVGL 随即在另一块缓冲区中渲染下一条带.
+// 下一次 flush 时 pushImageDMA() 内部会先 dmaWait(), 保证上一块已发完;
+// LVGL 自己也只会在两块缓冲区之间轮换, 不会改写正在发送的那一块.
+// SPI 事务只在一帧的各条带之间保持打开, 每次 lv_timer_handler() 之后由 tft_end_frame() 关闭.
+static bool tft_in_write = false;
 
-// 3. LVGL的显示刷新回调函数 (最终修正版)
-// 将第三个参数的类型从 void* 修改为 unsigned char*
 void my_disp_flush(lv_display_t *disp, const lv_area_t *area, unsigned char *color_p) {
     uint32_t w = (area->x2 - area->x1 + 1);
     uint32_t h = (area->y2 - area->y1 + 1);
 
-    tft.startWrite();
-    tft.setAddrWindow(area->x1, area->y1, w, h);
-    // 将 color_p 强制类型转换为 (uint16_t*) 来推送颜色数据
-    tft.pushColors((uint16_t *)color_p, w * h, true);
-    tft.endWrite();
+    if (!tft_in_write) {
+        tft.startWrite();
+        tft_in_write = true;
+    }
+    // 等上一块发完再提交, 顺便记录它的传输耗时
+    tft.dmaWait();
+    PerfStats_FlushEnd();
+    PerfStats_FlushBegin(w * h);
+    // 将 color_p 强制类型转换为 (uint16_t*) 来推送颜色数据, 字节序在缓冲区内原地交换
+    tft.pushImageDMA(area->x1, area->y1, w, h, (uint16_t *)color_p);
 
     lv_display_flush_ready(disp);
 }
 
-// ========== 传感器与系统信息全局变量 ==========
-float lm75_temp = 0.0f;
-float sht20_temp = 0.0f;
-float sht20_humi = 0.0f;
-float esp32_temp = 0.0f;
-uint32_t ram_free = 0;
-uint8_t cpu_usage = 0;
-int8_t wifi_rssi = 0;
-bool finished = false; // 用于标记是否完成初始化
-
-unsigned long last_read_time = 0;
-
-// ========== LM75 读取函数 ==========
-float read_lm75_temp() {
-    Wire.beginTransmission(0x48); // LM75 I2C地址
-    Wire.write(0x00); // 温度寄存器
-    Wire.endTransmission(false);
-    Wire.requestFrom(0x48, 2);
-    if (Wire.available() == 2) {
-        uint8_t msb = Wire.read();
-        uint8_t lsb = Wire.read();
-        int16_t temp = ((msb << 8) | lsb) >> 5;
-        return temp * 0.125f;
+// 等这一帧的最后一块发完并释放 SPI 总线, 之后总线上的其他设备才能使用
+static void tft_end_frame(void) {
+    if (!tft_in_write) {
+        return;
     }
-    return 0.0f;
+    tft.dmaWait();
+    tft.endWrite();
+    tft_in_write = false;
+    PerfStats_FlushEnd();
 }
 
-// ========== SHT20 读取函数 ==========
-void read_sht20(float &temp, float &humi) {
-    // 触发温度测量
-    Wire.beginTransmission(0x40);
-    Wire.write(0xF3);
-    Wire.endTransmission();
-    delay(85);
-    Wire.requestFrom(0x40, 2);
-    if (Wire.available() == 2) {
-        uint16_t raw = (Wire.read() << 8) | Wire.read();
-        temp = -46.85f + 175.72f * (raw & 0xFFFC) / 65536.0f;
-    }
-    // 触发湿度测量
-    Wire.beginTransmission(0x40);
-    Wire.write(0xF5);
-    Wire.endTransmission();
-    delay(29);
-    Wire.requestFrom(0x40, 2);
-    if (Wire.available() == 2) {
-        uint16_t raw = (Wire.read() << 8) | Wire.read();
-        humi = -6.0f + 125.0f * (raw & 0xFFFC) / 65536.0f;
-    }
+// 4. LVGL的时基: 直接读取系统时间, 不受 loop() 实际耗时影响
+static uint32_t lvgl_tick_cb(void) {
+    return millis();
 }
 
-// ========== ESP32 内置温度读取 ==========
-float read_esp32_temp() {
-    return temperatureRead();
-}
+// loop() 的最长休眠时间, 保证心跳/串口命令/上报调度仍能及时运行
+static const uint32_t LOOP_MAX_SLEEP_MS = 50;
 
-// ========== RAM/CPU/WiFi信号读取 ==========
-uint32_t get_ram_free() {
-    return ESP.getFreeHeap();
-}
-uint8_t get_cpu_usage() {
-    // ESP32 Arduino/FreeRTOS 没有直接API获取CPU占用率，这里模拟一个67%~100%之间的随机值
-    return 67 + (esp_random() % 34); // 67~100
-}
-int8_t get_wifi_rssi() {
-    return WiFi.RSSI();
-}
+bool finished = false; // 用于标记是否完成初始化
 
 // ======================== 主程序 ========================
 
@@ -112,18 +88,24 @@ void setup()
 {
     Serial.begin(115200);
     pinMode(BUTTON_PIN, INPUT_PULLUP);
+    ButtonInput_Begin();
+    CpuLoad_Begin();
     // --- 步骤 1: 初始化硬件与软件库 ---
     tft.begin();
     tft.setRotation(1); 
+    tft.setSwapBytes(true); // LVGL 输出小端 RGB565, 屏幕需要大端
+    tft.initDMA();
 
-    // 初始化WiFi（如无连接则进入STA模式）
+    // 初始化WiFi（如无连接则进入STA模式）; 连接由 Init_Connection() 发起,
+    // 这里不再 begin(), 否则会先开始一次全信道扫描, 随后又被快速重连打断
     if (WiFi.status() != WL_CONNECTED) {
         WiFi.mode(WIFI_STA);
-        WiFi.begin();
     }
     tft.setRotation(1); 
 
     lv_init();
+    lv_tick_set_cb(lvgl_tick_cb);
+    Theme_Init();
 
     // --- 步骤 2: 创建并配置LVGL显示器 ---
     lv_display_t * disp = lv_display_create(screenWidth, screenHeight);
@@ -136,7 +118,8 @@ void setup()
     lv_display_set_flush_cb(disp, my_disp_flush);
 
     // 设置缓冲区
-    lv_display_set_buffers(disp, buf_1, NULL, sizeof(buf_1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_buffers(disp, draw_buf_1, draw_buf_2, sizeof(draw_buf_1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    PerfStats_Attach(disp);
     
     // --- 步骤 3: 创建 LVGL 用户界面 ---
     Preferences preferences;
@@ -145,12 +128,17 @@ void setup()
     preferences.end();
 
     if (finished) {
-        create_dashboard();
+        Router_Show(PAGE_DASHBOARD);
         
         Wire.begin(IIC_SDA, IIC_SCL);
+        if (!SHT20_Begin(SHT20_RES_RH12_T14, SHT20_PHASES_SEQUENTIAL)) {
+            Serial.println("SHT20 not responding.");
+        }
+        SensorHub_Start(SENSOR_HUB_DEFAULT_PERIOD_MS, SENSOR_HUB_DEFAULT_PRIORITY);
 
         Serial.println("Setup done, LVGL is running.");
         Init_Connection();
+        TimeService_Begin(); // 之后页面和上报直接读取时间, 不再各自同步
     } else {
         NewUserPage1_Hello();
     }
@@ -159,10 +147,35 @@ void setup()
 
 void loop()
 {
+    unsigned long loop_start_us = micros();
+
+    // 先派发按键事件, 页面的改动在同一次 lv_timer_handler() 中渲染
+    uint32_t button_wait_ms = ButtonInput_Process();
+    SensorHub_Process(); // 新采样交给当前页面
+
     // LVGL 的心跳
-    lv_timer_handler();
-    lv_tick_inc(10);
-    delay(10);
+    CpuLoad_SlotEnter(CPU_SLOT_LVGL);
+    uint32_t sleep_ms = lv_timer_handler(); // 返回距离下一个LVGL定时器到期的时间
+    CpuLoad_SlotExit(CPU_SLOT_LVGL);
+    // 帧的最后一块不会再有下一次 flush 来确认完成, 在这里等它发完并结束事务
+    tft_end_frame();
+
+    // 串口命令: 'p' 打印性能统计, 'b' 运行 JSON/CBOR 编码基准, 'f' 运行定点/浮点换算基准,
+    // 't' 打印时间同步状态, 'g' 打印页面切换耗时与缓存
+    while (Serial.available() > 0) {
+        int cmd = Serial.read();
+        if (cmd == 'p') {
+            PerfStats_Print();
+        } else if (cmd == 'b') {
+            TelemetryBench_Run();
+        } else if (cmd == 'f') {
+            TelemetryBench_RunFixedPoint();
+        } else if (cmd == 't') {
+            TimeService_Print();
+        } else if (cmd == 'g') {
+            Router_Print();
+        }
+    }
 
     // 串口心跳监控
     static unsigned long last_heartbeat = 0;
@@ -183,27 +196,31 @@ void loop()
         }
     }
 
-    // 读取按钮状态并处理
-    static bool last_button_state = HIGH;
-    bool current_button_state = digitalRead(BUTTON_PIN);
-
-    last_button_state = current_button_state;
-
-    static unsigned long last_read = 0;
-    if (finished){
-    if (now - last_read >= 2000) {
-        last_read = now;
-        lm75_temp = read_lm75_temp();
-        read_sht20(sht20_temp, sht20_humi);
-        esp32_temp = read_esp32_temp();
-        ram_free = get_ram_free();
-        cpu_usage = get_cpu_usage();
-        wifi_rssi = get_wifi_rssi();
+    if (finished) {
         static unsigned long last_send = 0;
-        if (now - last_send >= 10000) {
+        static bool sent_once = false;
+        SensorSnapshot first_sample;
+        // 开机后第一次采样完成就上报, 不等满一个上报间隔
+        bool due = sent_once ? now - last_send >= TELEMETRY_UPLOAD_INTERVAL_MS : SensorHub_Read(&first_sample);
+        if (due) {
+            sent_once = true;
             last_send = now;
             SendSensorDataToServer(); // 发送传感器数据到服务器
         }
-        // 可在此处调用LVGL刷新数据的函数
-    }}
+    }
+
+    PerfStats_LoopIteration(micros() - loop_start_us);
+
+    // 休眠到下一个LVGL定时器到期 (没有定时器时返回 LV_NO_TIMER_READY),
+    // 按键中断和新采样 (SensorHub 的任务通知) 会提前唤醒
+    if (button_wait_ms < sleep_ms) {
+        sleep_ms = button_wait_ms;
+    }
+    if (sleep_ms > LOOP_MAX_SLEEP_MS) {
+        sleep_ms = LOOP_MAX_SLEEP_MS;
+    }
+    if (sleep_ms == 0) {
+        sleep_ms = 1; // 至少让出一个tick, 避免饿死低优先级任务
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(sleep_ms));
 }
\ No newline at end of file
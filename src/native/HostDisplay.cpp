@@ -0,0 +1,129 @@
+#include "HostDisplay.h"
+#include "PerfStats.h"
+#include <string.h>
+
+#define DRAW_BUF_LINES 40 // 与 main.cpp 一致
+
+static uint16_t framebuffer[HOST_DISPLAY_WIDTH * HOST_DISPLAY_HEIGHT];
+static uint16_t draw_buf_1[HOST_DISPLAY_WIDTH * DRAW_BUF_LINES] __attribute__((aligned(4)));
+static uint16_t draw_buf_2[HOST_DISPLAY_WIDTH * DRAW_BUF_LINES] __attribute__((aligned(4)));
+static uint64_t flushed_pixels = 0;
+static uint32_t changed_flushes = 0;
+
+// 输入区域: 按键回调运行期间被标记为需要重绘的区域的外接矩形
+static bool input_tracking = false;
+static bool input_valid = false;
+static lv_area_t input_area;
+static uint32_t input_changed_flushes = 0;
+
+static void add_input_area(const lv_area_t *area) {
+    if (!input_valid) {
+        input_area = *area;
+        input_valid = true;
+        return;
+    }
+    input_area.x1 = LV_MIN(input_area.x1, area->x1);
+    input_area.y1 = LV_MIN(input_area.y1, area->y1);
+    input_area.x2 = LV_MAX(input_area.x2, area->x2);
+    input_area.y2 = LV_MAX(input_area.y2, area->y2);
+}
+
+static void host_invalidate_cb(lv_event_t *e) {
+    if (input_tracking) {
+        add_input_area((const lv_area_t *)lv_event_get_param(e));
+    }
+}
+
+// 拷贝是同步完成的, 没有板上 DMA 与渲染的重叠, flush 的耗时就是拷贝本身
+static void host_disp_flush(lv_display_t *disp, const lv_area_t *area, unsigned char *color_p) {
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+
+    PerfStats_FlushBegin(w * h);
+    const uint16_t *src = (const uint16_t *)color_p;
+    lv_area_t overlap;
+    overlap.x1 = LV_MAX(area->x1, input_area.x1);
+    overlap.y1 = LV_MAX(area->y1, input_area.y1);
+    overlap.x2 = LV_MIN(area->x2, input_area.x2);
+    overlap.y2 = LV_MIN(area->y2, input_area.y2);
+    bool in_input = input_valid && overlap.x1 <= overlap.x2 && overlap.y1 <= overlap.y2;
+    bool changed = false;
+    bool input_changed = false;
+    for (uint32_t y = 0; y < h; y++) {
+        uint16_t *dst = &framebuffer[(area->y1 + y) * HOST_DISPLAY_WIDTH + area->x1];
+        if (!changed && memcmp(dst, &src[y * w], w * sizeof(uint16_t)) != 0) {
+            changed = true;
+        }
+        int32_t row = area->y1 + (int32_t)y;
+        if (changed && !input_changed && in_input && row >= overlap.y1 && row <= overlap.y2) {
+            uint32_t x = overlap.x1 - area->x1;
+            input_changed = memcmp(dst + x, &src[y * w + x], (overlap.x2 - overlap.x1 + 1) * sizeof(uint16_t)) != 0;
+        }
+        memcpy(dst, &src[y * w], w * sizeof(uint16_t));
+    }
+    flushed_pixels += w * h;
+    if (changed) {
+        changed_flushes++;
+    }
+    if (input_changed) {
+        input_changed_flushes++;
+    }
+    PerfStats_FlushEnd();
+
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *HostDisplay_Begin(void) {
+    lv_display_t *disp = lv_display_create(HOST_DISPLAY_WIDTH, HOST_DISPLAY_HEIGHT);
+    if (disp == NULL) {
+        return NULL;
+    }
+    lv_display_set_flush_cb(disp, host_disp_flush);
+    lv_display_set_buffers(disp, draw_buf_1, draw_buf_2, sizeof(draw_buf_1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_add_event_cb(disp, host_invalidate_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    PerfStats_Attach(disp);
+    return disp;
+}
+
+const uint16_t *HostDisplay_Framebuffer(void) {
+    return framebuffer;
+}
+
+uint64_t HostDisplay_FlushedPixels(void) {
+    return flushed_pixels;
+}
+
+uint32_t HostDisplay_ChangedFlushes(void) {
+    return changed_flushes;
+}
+
+void HostDisplay_InputBegin(void) {
+    input_tracking = true;
+}
+
+void HostDisplay_InputEnd(bool whole_screen) {
+    input_tracking = false;
+    if (whole_screen) {
+        lv_area_t screen = { 0, 0, HOST_DISPLAY_WIDTH - 1, HOST_DISPLAY_HEIGHT - 1 };
+        add_input_area(&screen);
+    }
+}
+
+void HostDisplay_ResetInput(void) {
+    input_valid = false;
+}
+
+uint32_t HostDisplay_InputChangedFlushes(void) {
+    return input_changed_flushes;
+}
+
+// FNV-1a, 64 位
+uint64_t HostDisplay_Hash(void) {
+    const uint8_t *bytes = (const uint8_t *)framebuffer;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < sizeof(framebuffer); i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
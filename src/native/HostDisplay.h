@@ -0,0 +1,55 @@
+#ifndef HOST_DISPLAY_H
+#define HOST_DISPLAY_H
+
+#include <lvgl.h>
+
+/**
+ * @brief [env:native] 的显示器: LVGL 按与板上相同的方式 (RGB565, 40 行双缓冲,
+ * 局部刷新) 渲染, flush 回调把每条带拷进内存中的整屏帧缓冲, 代替 TFT_eSPI 的 DMA.
+ */
+
+#define HOST_DISPLAY_WIDTH  320
+#define HOST_DISPLAY_HEIGHT 240
+
+/**
+ * @brief 创建 LVGL 显示器并接上 PerfStats. 在 lv_init() 之后调用一次.
+ */
+lv_display_t *HostDisplay_Begin(void);
+
+/**
+ * @brief 整屏帧缓冲, 行优先, 每像素一个 RGB565 (主机字节序).
+ */
+const uint16_t *HostDisplay_Framebuffer(void);
+
+/**
+ * @brief 启动以来 flush 出去的像素总数.
+ */
+uint64_t HostDisplay_FlushedPixels(void);
+
+/**
+ * @brief 启动以来改变了至少一个像素的 flush 次数. 两次读取之间有变化,
+ * 说明屏幕上的内容变了 (重绘出相同内容的 flush 不计).
+ */
+uint32_t HostDisplay_ChangedFlushes(void);
+
+/**
+ * @brief 记录按键回调造成的重绘 (InputReplay 用): Begin 与 End 之间 LVGL 标记为需要重绘
+ * 的区域并入输入区域. 回调启动了动画或切换了页面时, 之后的变化无法事先定位,
+ * End 传 whole_screen = true 把整屏算作输入区域. 输入区域保留到 HostDisplay_ResetInput().
+ */
+void HostDisplay_InputBegin(void);
+void HostDisplay_InputEnd(bool whole_screen);
+void HostDisplay_ResetInput(void);
+
+/**
+ * @brief 启动以来改变了输入区域内像素的 flush 次数. 页面定时器在别处的重绘
+ * (时钟走字, 倒计时) 不计.
+ */
+uint32_t HostDisplay_InputChangedFlushes(void);
+
+/**
+ * @brief 整屏帧缓冲的哈希, 用于和预期画面比较.
+ */
+uint64_t HostDisplay_Hash(void);
+
+#endif // HOST_DISPLAY_H
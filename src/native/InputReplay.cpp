@@ -0,0 +1,290 @@
+#include "InputReplay.h"
+#include "HostDisplay.h"
+#include "NativeHost.h"
+#include "Pages.h"
+#include "PageManager.h"
+#include "ButtonInput.h"
+#include "SensorHub.h"
+#include <Arduino.h>
+#include <ctype.h>
+
+// 与 main.cpp 的 loop() 一致
+#define REPLAY_MAX_SLEEP_MS 50
+
+typedef enum {
+    STEP_PRESS,
+    STEP_RELEASE,
+    STEP_CHECK,
+} step_type_t;
+
+typedef struct {
+    uint32_t t_ms;
+    step_type_t type;
+    char name[32];          // STEP_CHECK
+    bool has_expected;
+    uint64_t expected;
+} replay_step_t;
+
+typedef struct {
+    uint32_t t_ms;
+    bool press;
+    const char *page;       // 跳变时的页面, 不由 PageManager 管理的页面为 NULL
+    int32_t latency_ms;     // -1: 无响应
+} edge_result_t;
+
+typedef struct {
+    const replay_step_t *step;
+    uint32_t t_ms;
+    uint64_t hash;
+} check_result_t;
+
+static replay_step_t steps[REPLAY_MAX_STEPS];
+static edge_result_t edges[REPLAY_MAX_STEPS];
+static check_result_t checks[REPLAY_MAX_STEPS];
+
+static bool add_step(int *count, uint32_t t_ms, step_type_t type) {
+    if (*count >= REPLAY_MAX_STEPS) {
+        return false;
+    }
+    replay_step_t *step = &steps[(*count)++];
+    memset(step, 0, sizeof(*step));
+    step->t_ms = t_ms;
+    step->type = type;
+    return true;
+}
+
+// 解析一行, 空行和注释返回 true 且不添加步骤
+static bool parse_line(char *line, int *count) {
+    char *p = line;
+    while (isspace((unsigned char)*p)) {
+        p++;
+    }
+    if (*p == '\0' || *p == '#') {
+        return true;
+    }
+    unsigned long t_ms;
+    char op[16];
+    int consumed = 0;
+    if (sscanf(p, "%lu %15s %n", &t_ms, op, &consumed) < 2) {
+        return false;
+    }
+    const char *args = p + consumed;
+    unsigned long hold_ms;
+
+    if (strcmp(op, "press") == 0) {
+        return add_step(count, t_ms, STEP_PRESS);
+    }
+    if (strcmp(op, "release") == 0) {
+        return add_step(count, t_ms, STEP_RELEASE);
+    }
+    if (strcmp(op, "click") == 0 || strcmp(op, "long") == 0) {
+        if (sscanf(args, "%lu", &hold_ms) != 1) {
+            hold_ms = op[0] == 'c' ? REPLAY_CLICK_MS : REPLAY_LONG_PRESS_MS;
+        }
+        return add_step(count, t_ms, STEP_PRESS) && add_step(count, t_ms + hold_ms, STEP_RELEASE);
+    }
+    if (strcmp(op, "check") == 0) {
+        char name[32];
+        unsigned long long expected;
+        int fields = sscanf(args, "%31s %llx", name, &expected);
+        if (fields < 1 || !add_step(count, t_ms, STEP_CHECK)) {
+            return false;
+        }
+        replay_step_t *step = &steps[*count - 1];
+        strcpy(step->name, name);
+        step->has_expected = fields == 2;
+        step->expected = expected;
+        return true;
+    }
+    return false;
+}
+
+// 按时间稳定排序: click 展开的松开可能晚于后面几行
+static void sort_steps(int count) {
+    for (int i = 1; i < count; i++) {
+        replay_step_t step = steps[i];
+        int j = i - 1;
+        while (j >= 0 && steps[j].t_ms > step.t_ms) {
+            steps[j + 1] = steps[j];
+            j--;
+        }
+        steps[j + 1] = step;
+    }
+}
+
+static int load_trace(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        Serial.printf("Replay: cannot open %s\n", path);
+        return -1;
+    }
+    char line[128];
+    int count = 0;
+    int line_no = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        line_no++;
+        if (!parse_line(line, &count)) {
+            Serial.printf("Replay: %s:%d: bad or too many steps\n", path, line_no);
+            fclose(f);
+            return -1;
+        }
+    }
+    fclose(f);
+    sort_steps(count);
+    return count;
+}
+
+static void print_latency_summary(FILE *out, const char *name, int edge_count, bool press, bool last) {
+    int count = 0;
+    int responded = 0;
+    int32_t max_latency = 0;
+    int64_t total_latency = 0;
+    for (int i = 0; i < edge_count; i++) {
+        if (edges[i].press != press) {
+            continue;
+        }
+        count++;
+        if (edges[i].latency_ms >= 0) {
+            responded++;
+            total_latency += edges[i].latency_ms;
+            if (edges[i].latency_ms > max_latency) {
+                max_latency = edges[i].latency_ms;
+            }
+        }
+    }
+    fprintf(out, "    \"%s\": {\"count\": %d, \"responded\": %d, \"max_latency_ms\": %ld, \"avg_latency_ms\": %ld}%s\n",
+        name, count, responded, (long)max_latency, (long)(responded ? total_latency / responded : 0), last ? "" : ",");
+}
+
+static int write_report(FILE *out, const char *trace_path, uint32_t duration_ms, int edge_count, int check_count) {
+    int failures = 0;
+    fprintf(out, "{\n");
+    fprintf(out, "  \"replay\": \"%s\",\n", trace_path);
+    fprintf(out, "  \"duration_ms\": %lu,\n", (unsigned long)duration_ms);
+
+    fprintf(out, "  \"edges\": [\n");
+    for (int i = 0; i < edge_count; i++) {
+        char latency[16];
+        if (edges[i].latency_ms >= 0) {
+            snprintf(latency, sizeof(latency), "%ld", (long)edges[i].latency_ms);
+        } else {
+            strcpy(latency, "null");
+        }
+        fprintf(out, "    {\"t_ms\": %lu, \"page\": \"%s\", \"edge\": \"%s\", \"latency_ms\": %s}%s\n",
+            (unsigned long)edges[i].t_ms, edges[i].page ? edges[i].page : "-",
+            edges[i].press ? "press" : "release", latency, i == edge_count - 1 ? "" : ",");
+    }
+    fprintf(out, "  ],\n");
+
+    fprintf(out, "  \"checkpoints\": [\n");
+    for (int i = 0; i < check_count; i++) {
+        const check_result_t *check = &checks[i];
+        fprintf(out, "    {\"name\": \"%s\", \"t_ms\": %lu, \"hash\": \"%016llx\"",
+            check->step->name, (unsigned long)check->t_ms, (unsigned long long)check->hash);
+        if (check->step->has_expected) {
+            bool match = check->hash == check->step->expected;
+            failures += match ? 0 : 1;
+            fprintf(out, ", \"expected\": \"%016llx\", \"match\": %s",
+                (unsigned long long)check->step->expected, match ? "true" : "false");
+        }
+        fprintf(out, "}%s\n", i == check_count - 1 ? "" : ",");
+    }
+    fprintf(out, "  ],\n");
+
+    fprintf(out, "  \"summary\": {\n");
+    print_latency_summary(out, "press", edge_count, true, false);
+    print_latency_summary(out, "release", edge_count, false, false);
+    fprintf(out, "    \"checkpoint_failures\": %d\n", failures);
+    fprintf(out, "  }\n}\n");
+    fflush(out);
+    return failures;
+}
+
+int InputReplay_Run(const char *trace_path, FILE *report) {
+    int step_count = load_trace(trace_path);
+    if (step_count < 0) {
+        return -1;
+    }
+    uint32_t end_ms = (step_count > 0 ? steps[step_count - 1].t_ms : 0) + REPLAY_LATENCY_TIMEOUT_MS;
+
+    int64_t origin_us = NativeHost_TimeUs();
+    int next_step = 0;
+    int edge_count = 0;
+    int check_count = 0;
+    int pending_edge = -1;             // 还在等屏幕变化的跳变
+    uint32_t changes_at_edge = 0;
+
+    for (;;) {
+        uint32_t now_ms = (uint32_t)((NativeHost_TimeUs() - origin_us) / 1000);
+
+        // 先注入到期的跳变, 与板上一样由 ISR 记录并唤醒 loop()
+        while (next_step < step_count && steps[next_step].t_ms <= now_ms &&
+               steps[next_step].type != STEP_CHECK) {
+            bool press = steps[next_step].type == STEP_PRESS;
+            NativeHost_SetPin(BUTTON_PIN, press ? LOW : HIGH);
+            edges[edge_count].t_ms = now_ms;
+            edges[edge_count].press = press;
+            const page_desc_t *page = PageManager_Current();
+            edges[edge_count].page = page ? page->name : NULL;
+            edges[edge_count].latency_ms = -1;
+            pending_edge = edge_count++;
+            HostDisplay_ResetInput();
+            changes_at_edge = HostDisplay_InputChangedFlushes();
+            next_step++;
+        }
+
+        // 只有按键回调标记的区域算作响应; 回调启动了动画或切换了页面时整屏都算
+        const page_desc_t *page_before = PageManager_Current();
+        lv_obj_t *screen_before = lv_scr_act();
+        uint32_t anims_before = lv_anim_count_running();
+        HostDisplay_InputBegin();
+        uint32_t button_wait_ms = ButtonInput_Process();
+        HostDisplay_InputEnd(PageManager_Current() != page_before || lv_scr_act() != screen_before ||
+                             lv_anim_count_running() != anims_before);
+        SensorHub_Process();
+        uint32_t sleep_ms = lv_timer_handler();
+
+        if (pending_edge >= 0) {
+            uint32_t waited_ms = now_ms - edges[pending_edge].t_ms;
+            if (HostDisplay_InputChangedFlushes() != changes_at_edge) {
+                edges[pending_edge].latency_ms = (int32_t)waited_ms;
+                pending_edge = -1;
+            } else if (waited_ms >= REPLAY_LATENCY_TIMEOUT_MS) {
+                pending_edge = -1;
+            }
+        }
+
+        // 检查点看的是这一时刻渲染完成后的画面
+        while (next_step < step_count && steps[next_step].t_ms <= now_ms &&
+               steps[next_step].type == STEP_CHECK) {
+            checks[check_count].step = &steps[next_step];
+            checks[check_count].t_ms = now_ms;
+            checks[check_count].hash = HostDisplay_Hash();
+            check_count++;
+            next_step++;
+        }
+
+        if (now_ms >= end_ms) {
+            break;
+        }
+
+        // 休眠到下一个 LVGL 定时器, 按键引擎的超时或下一个回放步骤, 取最早的
+        if (button_wait_ms < sleep_ms) {
+            sleep_ms = button_wait_ms;
+        }
+        if (sleep_ms > REPLAY_MAX_SLEEP_MS) {
+            sleep_ms = REPLAY_MAX_SLEEP_MS;
+        }
+        uint32_t until_next = (next_step < step_count ? steps[next_step].t_ms : end_ms) - now_ms;
+        if (until_next < sleep_ms) {
+            sleep_ms = until_next;
+        }
+        if (sleep_ms == 0) {
+            sleep_ms = 1;
+        }
+        NativeHost_AdvanceUs((int64_t)sleep_ms * 1000);
+    }
+
+    uint32_t duration_ms = (uint32_t)((NativeHost_TimeUs() - origin_us) / 1000);
+    return write_report(report, trace_path, duration_ms, edge_count, check_count);
+}
@@ -0,0 +1,46 @@
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+#include <stdio.h>
+
+/**
+ * @brief 按键回放: 按时间表驱动 BUTTON_PIN, 在虚拟时钟上运行与 loop() 相同的调度
+ * (按键事件派发, lv_timer_handler(), 按 LVGL 定时器和按键引擎给出的时间休眠),
+ * 记录每个跳变到屏幕对它第一次响应的延迟, 并在检查点计算帧缓冲的哈希.
+ *
+ * 回放文件每行一条, 时间为回放开始后的毫秒数, '#' 开头为注释:
+ *   <ms> press                 按下
+ *   <ms> release               松开
+ *   <ms> click [hold_ms]       按下, hold_ms 后松开 (默认 REPLAY_CLICK_MS)
+ *   <ms> long [hold_ms]        长按 (默认 REPLAY_LONG_PRESS_MS)
+ *   <ms> check <name> [hash]   检查点: 记录帧缓冲哈希, 给出 hash (16 位十六进制) 时与之比较
+ *
+ * 例: 仪表盘单击进入下一页, 半秒后检查画面
+ *   0    click
+ *   500  check about_page
+ *
+ * 延迟是虚拟时间: 渲染本身不占时间, 测的是消抖, 单击/长按判定, 页面定时器
+ * 和 LVGL 刷新周期这些调度上的延迟, 不受宿主速度影响.
+ *
+ * 只有按键回调引起的变化才算响应: 跳变之后按键回调标记为需要重绘的区域内像素
+ * 变了 (回调启动了动画或切换了页面时, 整屏任何变化都算). 时钟走字, 冒号闪烁,
+ * 倒计时和传感器数据这些周期性重绘不算, 所以只在松开时响应的页面上, 按下记为
+ * 无响应 (null) 而不是下一次走字的时间. 跳变之后到下一个跳变之前 (最多
+ * REPLAY_LATENCY_TIMEOUT_MS) 没有响应的同样记为 null, 例如新页面把上一个页面
+ * 遗留的按压当成了自己的. 每个跳变记下当时的页面, 汇总按按下/松开分别统计.
+ * 局限: 回调标记了区域但像素没变, 之后同一区域里的周期性重绘仍会被算作响应.
+ *
+ * 每个页面的回归用例在 test/replay/, 由 test/replay/run.sh 运行 (--update 重新生成哈希).
+ *
+ * 需要在 NativeHost_UseVirtualClock() 之后由拥有时钟的线程调用, 初始页面已经显示.
+ * 结果以 JSON 写入 report.
+ * @return 回放文件无法读取或有错时返回 -1, 否则返回与预期不符的检查点数.
+ */
+int InputReplay_Run(const char *trace_path, FILE *report);
+
+#define REPLAY_CLICK_MS            80
+#define REPLAY_LONG_PRESS_MS       1200
+#define REPLAY_LATENCY_TIMEOUT_MS  1000
+#define REPLAY_MAX_STEPS           512
+
+#endif // INPUT_REPLAY_H
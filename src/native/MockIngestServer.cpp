@@ -0,0 +1,194 @@
+#include "MockIngestServer.h"
+#include <Arduino.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <strings.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#define INGEST_PATH      "/api/iot-data/batch"
+#define MAX_HEADER_BYTES 8192
+#define MAX_BODY_BYTES   (1024 * 1024)
+
+static int listen_fd = -1;
+static std::atomic<uint32_t> delay_ms(0);
+static std::atomic<bool> verbose(false);
+static std::atomic<uint32_t> requests(0);
+static std::atomic<uint64_t> body_bytes(0);
+
+// 一个连接上的读缓冲; 请求之间多读到的字节留给下一个请求
+typedef struct {
+    int fd;
+    std::string buffer;
+} conn_t;
+
+static bool fill(conn_t *conn) {
+    char chunk[2048];
+    ssize_t n = recv(conn->fd, chunk, sizeof(chunk), 0);
+    if (n <= 0) {
+        return false;
+    }
+    conn->buffer.append(chunk, (size_t)n);
+    return true;
+}
+
+static bool send_all(int fd, const std::string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        sent += (size_t)n;
+    }
+    return true;
+}
+
+static bool reply(int fd, int code, const char *reason, const char *body, bool keep_alive) {
+    char head[256];
+    snprintf(head, sizeof(head),
+        "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %u\r\nConnection: %s\r\n\r\n",
+        code, reason, (unsigned)strlen(body), keep_alive ? "keep-alive" : "close");
+    return send_all(fd, std::string(head) + body);
+}
+
+// 在请求头中找一个字段 (不区分大小写), 没有时返回空串
+static std::string header_value(const std::string &head, const char *name) {
+    size_t name_len = strlen(name);
+    size_t pos = head.find("\r\n");
+    while (pos != std::string::npos && pos + 2 < head.size()) {
+        size_t line = pos + 2;
+        size_t end = head.find("\r\n", line);
+        if (end == std::string::npos) {
+            end = head.size();
+        }
+        if (end - line > name_len && strncasecmp(head.c_str() + line, name, name_len) == 0 &&
+            head[line + name_len] == ':') {
+            size_t value = line + name_len + 1;
+            while (value < end && head[value] == ' ') {
+                value++;
+            }
+            return head.substr(value, end - value);
+        }
+        pos = end;
+    }
+    return "";
+}
+
+// 处理一个请求, 连接应关闭时返回 false
+static bool handle_request(conn_t *conn) {
+    size_t head_end;
+    while ((head_end = conn->buffer.find("\r\n\r\n")) == std::string::npos) {
+        if (conn->buffer.size() > MAX_HEADER_BYTES || !fill(conn)) {
+            return false;
+        }
+    }
+    std::string head = conn->buffer.substr(0, head_end);
+    conn->buffer.erase(0, head_end + 4);
+
+    char method[16] = "";
+    char path[256] = "";
+    sscanf(head.c_str(), "%15s %255s", method, path);
+    bool keep_alive = strcasecmp(header_value(head, "Connection").c_str(), "close") != 0;
+
+    std::string length = header_value(head, "Content-Length");
+    if (length.empty()) {
+        if (strcmp(method, "POST") == 0) {
+            reply(conn->fd, 411, "Length Required", "{\"error\":\"length required\"}", false);
+            return false;
+        }
+        length = "0";
+    }
+    size_t body_len = strtoul(length.c_str(), NULL, 10);
+    if (body_len > MAX_BODY_BYTES) {
+        reply(conn->fd, 413, "Payload Too Large", "{\"error\":\"too large\"}", false);
+        return false;
+    }
+    while (conn->buffer.size() < body_len) {
+        if (!fill(conn)) {
+            return false;
+        }
+    }
+    conn->buffer.erase(0, body_len);
+
+    uint32_t delay = delay_ms.load();
+    if (delay > 0) {
+        usleep(delay * 1000);
+    }
+
+    bool ok;
+    if (strcmp(method, "POST") == 0 && strcmp(path, INGEST_PATH) == 0) {
+        requests++;
+        body_bytes += body_len;
+        ok = reply(conn->fd, 200, "OK", "{\"ok\":true}", keep_alive);
+    } else {
+        ok = reply(conn->fd, 404, "Not Found", "{\"error\":\"not found\"}", keep_alive);
+    }
+    if (verbose) {
+        Serial.printf("Ingest: %s %s, %u bytes, delay %lums\n", method, path, (unsigned)body_len,
+            (unsigned long)delay);
+    }
+    return ok && keep_alive;
+}
+
+static void serve_connection(int fd) {
+    conn_t conn;
+    conn.fd = fd;
+    while (handle_request(&conn)) {
+    }
+    close(fd);
+}
+
+int MockIngest_Listen(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    socklen_t addr_len = sizeof(addr);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0 ||
+        getsockname(fd, (struct sockaddr *)&addr, &addr_len) != 0) {
+        close(fd);
+        return -1;
+    }
+    listen_fd = fd;
+    return ntohs(addr.sin_port);
+}
+
+void MockIngest_Serve(void) {
+    if (listen_fd < 0) {
+        return;
+    }
+    std::thread([]() {
+        for (;;) {
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0) {
+                std::thread(serve_connection, fd).detach();
+            }
+        }
+    }).detach();
+}
+
+void MockIngest_SetDelay(uint32_t ms) {
+    delay_ms = ms;
+}
+
+void MockIngest_SetVerbose(bool on) {
+    verbose = on;
+}
+
+uint32_t MockIngest_Requests(void) {
+    return requests;
+}
+
+uint64_t MockIngest_BodyBytes(void) {
+    return body_bytes;
+}
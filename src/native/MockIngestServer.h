@@ -0,0 +1,35 @@
+#ifndef MOCK_INGEST_SERVER_H
+#define MOCK_INGEST_SERVER_H
+
+#include <stdint.h>
+
+/**
+ * @brief 本地的上报服务器替身: 接受 POST /api/iot-data/batch, 回复 200 和一个小的 JSON,
+ * 支持 keep-alive. 请求体只计字节数, 不解析. 可以注入处理延迟来模拟变慢的后端.
+ * 宿主上的压测 (UploadLoad.h) 用它, 也可以单独运行, 让板子通过配网页面指向它.
+ *
+ * 先 Listen() 再 Serve(): 压测在 fork 出模拟设备之前绑定端口 (子进程要知道地址,
+ * 而且 fork 时进程里还不能有其他线程), 之后再启动接受连接的线程.
+ */
+
+/**
+ * @brief 在 0.0.0.0:port 上监听.
+ * @param port 0 表示由系统分配
+ * @return 实际监听的端口, 失败返回 -1.
+ */
+int MockIngest_Listen(uint16_t port);
+
+// 启动接受连接的线程, 每个连接一个线程
+void MockIngest_Serve(void);
+
+// 之后每个请求在回复前等待 delay_ms
+void MockIngest_SetDelay(uint32_t delay_ms);
+
+// 为 true 时每个请求打印一行日志 (单独运行时用)
+void MockIngest_SetVerbose(bool verbose);
+
+// 已经回复的请求数和收到的请求体字节数
+uint32_t MockIngest_Requests(void);
+uint64_t MockIngest_BodyBytes(void);
+
+#endif // MOCK_INGEST_SERVER_H
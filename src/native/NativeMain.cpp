@@ -0,0 +1,391 @@
+// 单元测试 (pio test -e native) 链接 src/ 时由测试程序提供 main()
+#ifndef PIO_UNIT_TESTING
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "NativeHost.h"
+#include "HostDisplay.h"
+#include "RenderBench.h"
+#include "InputReplay.h"
+#include "UploadLoad.h"
+#include "MockIngestServer.h"
+#include "Pages.h"
+#include "SHT20.h"
+#include "SensorHub.h"
+#include "CpuLoad.h"
+#include "PerfStats.h"
+#include "ButtonInput.h"
+#include "TelemetryPayload.h"
+#include "TelemetryBench.h"
+#include "TimeService.h"
+#include "Router.h"
+#include "Theme.h"
+#include <Preferences.h>
+#include <Wire.h>
+#include <WiFi.h>
+#include <ctype.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/**
+ * [env:native] 的入口, 对应板上 main.cpp 的 setup()/loop().
+ *
+ * 用法: program [--new-user] [--bench-render <file>] [--bench-fixed] [--replay <trace> <report>] [seconds]
+ *   --new-user              NVS 为空, 从新用户引导页面开始; 默认写入已完成引导和 WiFi 凭据, 直接进入仪表盘
+ *   --bench-render <file>   不进入主循环, 运行页面渲染基准 (RenderBench.h), JSON 写入 file ("-" 为标准输出)
+ *   --bench-fixed           运行串口命令 'f' 的定点/浮点换算基准 5 次后退出; 计数为宿主的周期数
+ *                           (宿主有 FPU, 换算一项的差别远小于板上)
+ *   --replay <trace> <report>
+ *                           在虚拟时钟上回放按键 (InputReplay.h), JSON 写入 report ("-" 为标准输出);
+ *                           有检查点与预期不符时退出码为 1
+ *   --load <devices> <report>
+ *                           上报压测 (UploadLoad.h), JSON 写入 report; 可选参数
+ *                           --phase-s <s> --interval-ms <ms> --slow-ms <ms> --server <url>
+ *   --mock-server <port> [delay_ms]
+ *                           只运行本地上报服务器 (MockIngestServer.h), 板子可以在配网页面把上报地址指向它
+ *   seconds                 运行时长, 默认 30 秒, 结束时打印统计
+ *
+ * 标准输入上的命令与板上的串口命令相同, 另外 'c' 单击按键, 'l' 长按按键.
+ */
+
+#define IIC_SCL 1
+#define IIC_SDA 0
+
+#define DEFAULT_RUN_SECONDS 30
+#define HOST_CLICK_MS       80
+#define HOST_LONG_PRESS_MS  (BUTTON_LONG_PRESS_MS + 200)
+
+// 回放从固定的时间开始, 每次运行的画面 (包括时钟页面) 都相同
+#define REPLAY_START_US      1000000LL
+#define REPLAY_WALL_EPOCH_US (1735689600LL * 1000000LL) // 2025-01-01 00:00:00 UTC
+
+static uint32_t lvgl_tick_cb(void) {
+    return millis();
+}
+
+static const uint32_t LOOP_MAX_SLEEP_MS = 50;
+
+static bool finished = false;
+static unsigned long button_release_at = 0; // 非 0 时在该时间松开模拟的按键
+
+// NVS 每次运行都是空的, 写入板上完成引导后的状态
+static void seed_nvs(void) {
+    Preferences preferences;
+    preferences.begin("init", false);
+    preferences.putBool("finished", true);
+    preferences.end();
+    preferences.begin("wifi-creds", false);
+    preferences.putString("ssid", "native-host");
+    preferences.putString("password", "native-host");
+    preferences.end();
+}
+
+static void press_button(uint32_t hold_ms) {
+    NativeHost_SetPin(BUTTON_PIN, LOW);
+    button_release_at = millis() + hold_ms;
+}
+
+// 板上 setup() 中与页面无关的部分: 外设, LVGL 和显示器
+static void init_host(bool new_user)
+{
+    Serial.begin(115200);
+    pinMode(BUTTON_PIN, INPUT_PULLUP);
+    ButtonInput_Begin();
+    CpuLoad_Begin();
+    if (!new_user) {
+        seed_nvs();
+    }
+
+    if (WiFi.status() != WL_CONNECTED) {
+        WiFi.mode(WIFI_STA);
+    }
+
+    lv_init();
+    lv_tick_set_cb(lvgl_tick_cb);
+    Theme_Init();
+
+    if (HostDisplay_Begin() == NULL) {
+        Serial.println("Failed to create display!");
+        NativeHost_Exit(1);
+    }
+}
+
+static void start_sensors(void)
+{
+    Wire.begin(IIC_SDA, IIC_SCL);
+    if (!SHT20_Begin(SHT20_RES_RH12_T14, SHT20_PHASES_SEQUENTIAL)) {
+        Serial.println("SHT20 not responding.");
+    }
+    SensorHub_Start(SENSOR_HUB_DEFAULT_PERIOD_MS, SENSOR_HUB_DEFAULT_PRIORITY);
+}
+
+static void setup(bool new_user)
+{
+    init_host(new_user);
+
+    Preferences preferences;
+    preferences.begin("init", false);
+    finished = preferences.getBool("finished", false);
+    preferences.end();
+
+    if (finished) {
+        Router_Show(PAGE_DASHBOARD);
+        start_sensors();
+
+        Serial.println("Setup done, LVGL is running.");
+        Init_Connection();
+        TimeService_Begin();
+    } else {
+        NewUserPage1_Hello();
+    }
+}
+
+static FILE *open_report(const char *path)
+{
+    FILE *out = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (out == NULL) {
+        Serial.printf("Cannot open %s\n", path);
+        NativeHost_Exit(1);
+    }
+    return out;
+}
+
+static void run_upload_load(const upload_load_config_t *config, const char *report_path)
+{
+    FILE *out = open_report(report_path);
+    int result = UploadLoad_Run(config, out);
+    if (out != stdout) {
+        fclose(out);
+    }
+    NativeHost_Exit(result == 0 ? 0 : 1);
+}
+
+static void run_mock_server(uint16_t port, uint32_t delay_ms)
+{
+    int bound = MockIngest_Listen(port);
+    if (bound < 0) {
+        Serial.printf("Cannot listen on port %u\n", (unsigned)port);
+        NativeHost_Exit(1);
+    }
+    MockIngest_SetDelay(delay_ms);
+    MockIngest_SetVerbose(true);
+    MockIngest_Serve();
+    Serial.printf("Ingest server listening on port %d, delay %lums\n", bound, (unsigned long)delay_ms);
+    for (;;) {
+        delay(1000);
+    }
+}
+
+// 页面基准: 联网, 对时, 并等到有第一次采样, 仪表盘和时钟页面才显示真实内容
+static void run_render_bench(const char *path)
+{
+    init_host(false);
+    start_sensors();
+    Init_Connection();
+    TimeService_Begin();
+    SensorSnapshot snapshot;
+    while (!SensorHub_Read(&snapshot)) {
+        delay(10);
+    }
+
+    FILE *out = open_report(path);
+    int pages = RenderBench_Run(out);
+    if (out != stdout) {
+        fclose(out);
+    }
+    Serial.printf("Render bench: %d pages written to %s\n", pages, path);
+    NativeHost_Exit(0);
+}
+
+// 按键回放: 不启动传感器任务和上传, 画面只由按键和时间决定
+static void run_replay(bool new_user, const char *trace_path, const char *report_path)
+{
+    NativeHost_UseVirtualClock(REPLAY_START_US, REPLAY_WALL_EPOCH_US);
+    init_host(new_user);
+    if (new_user) {
+        NewUserPage1_Hello();
+    } else {
+        Router_Show(PAGE_DASHBOARD);
+        Init_Connection();
+        TimeService_Begin();
+    }
+
+    FILE *out = open_report(report_path);
+    int failures = InputReplay_Run(trace_path, out);
+    if (out != stdout) {
+        fclose(out);
+    }
+    if (failures < 0) {
+        NativeHost_Exit(2);
+    }
+    Serial.printf("Replay: %s, %d checkpoint(s) failed, report written to %s\n",
+        trace_path, failures, report_path);
+    NativeHost_Exit(failures > 0 ? 1 : 0);
+}
+
+static void loop()
+{
+    unsigned long loop_start_us = micros();
+
+    if (button_release_at != 0 && (long)(millis() - button_release_at) >= 0) {
+        button_release_at = 0;
+        NativeHost_SetPin(BUTTON_PIN, HIGH);
+    }
+
+    uint32_t button_wait_ms = ButtonInput_Process();
+    SensorHub_Process();
+
+    CpuLoad_SlotEnter(CPU_SLOT_LVGL);
+    uint32_t sleep_ms = lv_timer_handler();
+    CpuLoad_SlotExit(CPU_SLOT_LVGL);
+
+    while (Serial.available() > 0) {
+        int cmd = Serial.read();
+        if (cmd == 'p') {
+            PerfStats_Print();
+        } else if (cmd == 'b') {
+            TelemetryBench_Run();
+        } else if (cmd == 'f') {
+            TelemetryBench_RunFixedPoint();
+        } else if (cmd == 't') {
+            TimeService_Print();
+        } else if (cmd == 'g') {
+            Router_Print();
+        } else if (cmd == 'c' && button_release_at == 0) {
+            press_button(HOST_CLICK_MS);
+        } else if (cmd == 'l' && button_release_at == 0) {
+            press_button(HOST_LONG_PRESS_MS);
+        }
+    }
+
+    static unsigned long last_heartbeat = 0;
+    static uint32_t heartbeat_counter = 0;
+    unsigned long now = millis();
+    if (now - last_heartbeat >= 1000) {
+        last_heartbeat = now;
+        Serial.printf("Heartbeat: %lu, Free RAM: %lu\n", (unsigned long)++heartbeat_counter,
+            (unsigned long)ESP.getFreeHeap());
+    }
+
+    if (finished) {
+        static unsigned long last_send = 0;
+        static bool sent_once = false;
+        SensorSnapshot first_sample;
+        bool due = sent_once ? now - last_send >= TELEMETRY_UPLOAD_INTERVAL_MS : SensorHub_Read(&first_sample);
+        if (due) {
+            sent_once = true;
+            last_send = now;
+            SendSensorDataToServer();
+        }
+    }
+
+    PerfStats_LoopIteration(micros() - loop_start_us);
+
+    if (button_wait_ms < sleep_ms) {
+        sleep_ms = button_wait_ms;
+    }
+    if (sleep_ms > LOOP_MAX_SLEEP_MS) {
+        sleep_ms = LOOP_MAX_SLEEP_MS;
+    }
+    if (button_release_at != 0) {
+        long release_in = (long)(button_release_at - millis());
+        if (release_in < (long)sleep_ms) {
+            sleep_ms = release_in > 0 ? (uint32_t)release_in : 0;
+        }
+    }
+    if (sleep_ms == 0) {
+        sleep_ms = 1;
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(sleep_ms));
+}
+
+int main(int argc, char **argv)
+{
+    bool new_user = false;
+    const char *render_bench_path = NULL;
+    bool fixed_bench = false;
+    const char *replay_trace_path = NULL;
+    const char *replay_report_path = NULL;
+    const char *load_report_path = NULL;
+    upload_load_config_t load_config = {
+        UPLOAD_LOAD_DEFAULT_DEVICES, UPLOAD_LOAD_DEFAULT_PHASE_MS, UPLOAD_LOAD_DEFAULT_INTERVAL_MS,
+        UPLOAD_LOAD_DEFAULT_SLOW_MS, NULL,
+    };
+    bool mock_server = false;
+    uint16_t mock_port = 0;
+    uint32_t mock_delay_ms = 0;
+    unsigned long run_seconds = DEFAULT_RUN_SECONDS;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--new-user") == 0) {
+            new_user = true;
+        } else if (strcmp(argv[i], "--bench-render") == 0 && i + 1 < argc) {
+            render_bench_path = argv[++i];
+        } else if (strcmp(argv[i], "--bench-fixed") == 0) {
+            fixed_bench = true;
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 2 < argc) {
+            replay_trace_path = argv[++i];
+            replay_report_path = argv[++i];
+        } else if (strcmp(argv[i], "--load") == 0 && i + 2 < argc) {
+            load_config.devices = atoi(argv[++i]);
+            load_report_path = argv[++i];
+        } else if (strcmp(argv[i], "--phase-s") == 0 && i + 1 < argc) {
+            load_config.phase_ms = strtoul(argv[++i], NULL, 10) * 1000;
+        } else if (strcmp(argv[i], "--interval-ms") == 0 && i + 1 < argc) {
+            load_config.interval_ms = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--slow-ms") == 0 && i + 1 < argc) {
+            load_config.slow_ms = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--server") == 0 && i + 1 < argc) {
+            load_config.server_url = argv[++i];
+        } else if (strcmp(argv[i], "--mock-server") == 0 && i + 1 < argc) {
+            mock_server = true;
+            mock_port = (uint16_t)atoi(argv[++i]);
+            if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) {
+                mock_delay_ms = strtoul(argv[++i], NULL, 10);
+            }
+        } else {
+            run_seconds = strtoul(argv[i], NULL, 10);
+        }
+    }
+
+    // 压测要在创建任何线程之前 fork, 放在最前面
+    if (load_report_path != NULL) {
+        if (load_config.devices < 1 || load_config.devices > UPLOAD_LOAD_MAX_DEVICES ||
+            load_config.phase_ms == 0 || load_config.interval_ms == 0) {
+            Serial.printf("--load: 1..%d devices, non-zero phase and interval\n", UPLOAD_LOAD_MAX_DEVICES);
+            NativeHost_Exit(2);
+        }
+        run_upload_load(&load_config, load_report_path);
+    }
+    if (mock_server) {
+        run_mock_server(mock_port, mock_delay_ms);
+    }
+    if (fixed_bench) {
+        for (int i = 0; i < 5; i++) {
+            TelemetryBench_RunFixedPoint();
+        }
+        NativeHost_Exit(0);
+    }
+    if (render_bench_path != NULL) {
+        run_render_bench(render_bench_path);
+    }
+    if (replay_trace_path != NULL) {
+        run_replay(new_user, replay_trace_path, replay_report_path);
+    }
+
+    setup(new_user);
+    while (millis() < run_seconds * 1000UL) {
+        loop();
+    }
+
+    PerfStats_Print();
+    Router_Print();
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    Serial.printf("LVGL mem: total=%lu, free=%lu, used=%lu, frag=%u%%, biggest_free=%lu\n",
+        (unsigned long)mon.total_size, (unsigned long)mon.free_size, (unsigned long)mon.used_cnt,
+        (unsigned int)mon.frag_pct, (unsigned long)mon.free_biggest_size);
+    Serial.printf("Display: %llu pixels flushed\n", (unsigned long long)HostDisplay_FlushedPixels());
+    NativeHost_Exit(0);
+}
+
+#endif // PIO_UNIT_TESTING
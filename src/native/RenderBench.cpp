@@ -0,0 +1,166 @@
+#include "RenderBench.h"
+#include "HostDisplay.h"
+#include "Pages.h"
+#include "ButtonInput.h"
+#include "SensorHub.h"
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+
+typedef struct {
+    const char *name;
+    uint32_t build_us;
+    int32_t heap_bytes;
+    uint32_t objects;
+    uint32_t first_frame_us;
+    uint64_t first_frame_px;
+    uint32_t steady_frames;
+    uint64_t steady_px;
+    uint64_t steady_max_frame_px;
+} bench_result_t;
+
+// 与 PageManager 相同: 有内置内存池时看池, 否则看系统堆
+static uint32_t free_heap(void) {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.total_size == 0) {
+        return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    }
+    return mon.free_size;
+}
+
+static uint32_t count_objects(lv_obj_t *obj) {
+    uint32_t count = 1;
+    uint32_t children = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < children; i++) {
+        count += count_objects(lv_obj_get_child(obj, i));
+    }
+    return count;
+}
+
+// 换上一个空白屏幕, 返回之前的屏幕 (由调用方删除)
+static lv_obj_t *load_blank(void) {
+    lv_obj_t *old_screen = lv_scr_act();
+    lv_scr_load(lv_obj_create(NULL));
+    return old_screen;
+}
+
+// 运行 LVGL 定时器 ms 毫秒; result 非 NULL 时统计每次刷新的像素数
+static void run_for(uint32_t ms, bench_result_t *result) {
+    uint32_t start = millis();
+    for (;;) {
+        uint32_t elapsed = millis() - start;
+        if (elapsed >= ms) {
+            break;
+        }
+        uint64_t before = HostDisplay_FlushedPixels();
+        ButtonInput_Process();
+        SensorHub_Process();
+        uint32_t sleep_ms = lv_timer_handler();
+        uint64_t frame_px = HostDisplay_FlushedPixels() - before;
+        if (result != NULL && frame_px > 0) {
+            result->steady_frames++;
+            result->steady_px += frame_px;
+            if (frame_px > result->steady_max_frame_px) {
+                result->steady_max_frame_px = frame_px;
+            }
+        }
+        uint32_t remaining = ms - elapsed;
+        delay(sleep_ms < remaining ? sleep_ms : remaining);
+    }
+}
+
+// 屏幕已经加载: 强制刷新首帧, 等动画结束后测稳态
+static void measure_frames(bench_result_t *result) {
+    uint64_t before = HostDisplay_FlushedPixels();
+    int64_t start = esp_timer_get_time();
+    lv_refr_now(NULL);
+    result->first_frame_us = (uint32_t)(esp_timer_get_time() - start);
+    result->first_frame_px = HostDisplay_FlushedPixels() - before;
+
+    run_for(RENDER_BENCH_SETTLE_MS, NULL);
+    run_for(RENDER_BENCH_STEADY_MS, result);
+}
+
+static void bench_page(const page_desc_t *page, bench_result_t *result) {
+    lv_obj_del(load_blank());
+    result->name = page->name;
+
+    uint32_t heap_before = free_heap();
+    int64_t start = esp_timer_get_time();
+    lv_obj_t *screen = page->create();
+    result->build_us = (uint32_t)(esp_timer_get_time() - start);
+    result->heap_bytes = (int32_t)(heap_before - free_heap());
+    result->objects = count_objects(screen);
+
+    lv_scr_load(screen);
+    page->on_show();
+    measure_frames(result);
+
+    if (page->on_hide) {
+        page->on_hide();
+    }
+    ButtonInput_SetHandler(NULL, false);
+    lv_obj_del(load_blank());
+    if (page->on_destroy) {
+        page->on_destroy();
+    }
+}
+
+// 引导页面不经过 PageManager: 直接画在当前屏幕上, 或者自己创建并加载屏幕
+static void bench_setup_page(const char *name, void (*create)(void), bench_result_t *result) {
+    lv_obj_del(load_blank());
+    result->name = name;
+
+    uint32_t heap_before = free_heap();
+    int64_t start = esp_timer_get_time();
+    create();
+    result->build_us = (uint32_t)(esp_timer_get_time() - start);
+    result->heap_bytes = (int32_t)(heap_before - free_heap());
+    result->objects = count_objects(lv_scr_act());
+
+    measure_frames(result);
+}
+
+static void print_result(FILE *out, const bench_result_t *r, bool last) {
+    fprintf(out,
+        "    {\"name\": \"%s\", \"build_us\": %lu, \"heap_bytes\": %ld, \"objects\": %lu, "
+        "\"first_frame_us\": %lu, \"first_frame_px\": %llu, "
+        "\"steady_frames\": %lu, \"steady_px\": %llu, \"steady_max_frame_px\": %llu}%s\n",
+        r->name, (unsigned long)r->build_us, (long)r->heap_bytes, (unsigned long)r->objects,
+        (unsigned long)r->first_frame_us, (unsigned long long)r->first_frame_px,
+        (unsigned long)r->steady_frames, (unsigned long long)r->steady_px,
+        (unsigned long long)r->steady_max_frame_px, last ? "" : ",");
+}
+
+int RenderBench_Run(FILE *out) {
+    static const page_desc_t *const PAGES[] = {
+        &DASHBOARD_PAGE, &CLOCK_PAGE, &NOODLE_PAGE, &ABOUT_PAGE, &INFO_PAGE, &RESET_PAGE,
+    };
+    static const int BENCH_PAGE_COUNT = sizeof(PAGES) / sizeof(PAGES[0]);
+    bench_result_t results[BENCH_PAGE_COUNT + 2] = {};
+
+    for (int i = 0; i < BENCH_PAGE_COUNT; i++) {
+        bench_page(PAGES[i], &results[i]);
+    }
+    bench_setup_page("wlan_setup", WLAN_Setup_Page, &results[BENCH_PAGE_COUNT]);
+    cleanup_wlan_setup_page();
+    bench_setup_page("setup_finished", create_setup_finished_page, &results[BENCH_PAGE_COUNT + 1]);
+    int count = BENCH_PAGE_COUNT + 2;
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    fprintf(out, "{\n");
+    fprintf(out, "  \"benchmark\": \"render\",\n");
+    fprintf(out, "  \"display\": {\"width\": %d, \"height\": %d},\n", HOST_DISPLAY_WIDTH, HOST_DISPLAY_HEIGHT);
+    fprintf(out, "  \"lvgl_mem_total\": %lu,\n", (unsigned long)mon.total_size);
+    fprintf(out, "  \"settle_ms\": %d,\n", RENDER_BENCH_SETTLE_MS);
+    fprintf(out, "  \"steady_ms\": %d,\n", RENDER_BENCH_STEADY_MS);
+    fprintf(out, "  \"pages\": [\n");
+    for (int i = 0; i < count; i++) {
+        print_result(out, &results[i], i == count - 1);
+    }
+    fprintf(out, "  ]\n}\n");
+    fflush(out);
+    return count;
+}
@@ -0,0 +1,23 @@
+#ifndef RENDER_BENCH_H
+#define RENDER_BENCH_H
+
+#include <stdio.h>
+
+/**
+ * @brief 依次构建每个页面并测量渲染开销, 结果以 JSON 写入 out.
+ *
+ * 每个页面记录: create() 的耗时, 构建占用的 LVGL 内存, 控件数,
+ * 首帧刷新的像素数和耗时, 以及动画结束后 RENDER_BENCH_STEADY_MS 内
+ * 定时更新刷新的帧数和像素数. 受管理的页面测完后按 PageManager 的方式
+ * 销毁; 引导页面最后测, 只清理到不影响下一个页面为止.
+ *
+ * 需要在 lv_init(), Theme_Init() 和 HostDisplay_Begin() 之后调用,
+ * 且不能已经通过 Router 显示过页面.
+ * @return 测量的页面数.
+ */
+int RenderBench_Run(FILE *out);
+
+#define RENDER_BENCH_SETTLE_MS 600  // 等待加载动画结束
+#define RENDER_BENCH_STEADY_MS 2000 // 稳态测量窗口, 覆盖 1 秒一次的定时更新
+
+#endif // RENDER_BENCH_H
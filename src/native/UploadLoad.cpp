@@ -0,0 +1,290 @@
+#include "UploadLoad.h"
+#include "MockIngestServer.h"
+#include "NativeHost.h"
+#include "Pages.h"
+#include "SHT20.h"
+#include "SensorHub.h"
+#include "CpuLoad.h"
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <Preferences.h>
+#include <Wire.h>
+#include <WiFi.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define LOAD_MAX_EVENTS 65536
+#define LOAD_PHASES     3
+
+typedef enum {
+    LOAD_EVENT_LIVE,        // 实时批次的一次上报
+    LOAD_EVENT_REPLAY,      // 离线缓存重发的一次上报
+    LOAD_EVENT_DROPPED,     // 上报队列满, 窗口被丢弃
+} load_event_kind_t;
+
+// 子进程写入管道的记录, 小于 PIPE_BUF, 多个进程同时写也不会交错
+typedef struct {
+    uint32_t t_ms;          // 相对压测开始
+    uint32_t latency_us;
+    int16_t http_code;
+    uint8_t kind;
+    uint8_t device;
+} load_event_t;
+
+typedef struct {
+    uint32_t attempts;
+    uint32_t ok;
+    uint32_t failed;
+    uint32_t timeouts;
+} load_counts_t;
+
+static const char *const PHASE_NAMES[LOAD_PHASES] = { "baseline", "degraded", "recovered" };
+
+static load_event_t events[LOAD_MAX_EVENTS];
+static uint32_t latencies[LOAD_MAX_EVENTS];
+static int event_count = 0;
+
+static int64_t load_origin_us;
+static int event_fd = -1;
+static uint8_t device_index;
+
+// --- 模拟设备 (子进程) ---
+
+static void send_event(load_event_kind_t kind, int http_code, uint32_t latency_us) {
+    load_event_t event;
+    event.t_ms = (uint32_t)((NativeHost_TimeUs() - load_origin_us) / 1000);
+    event.latency_us = latency_us;
+    event.http_code = (int16_t)http_code;
+    event.kind = (uint8_t)kind;
+    event.device = device_index;
+    if (write(event_fd, &event, sizeof(event)) != (ssize_t)sizeof(event)) {
+        NativeHost_Exit(1); // 父进程已经退出
+    }
+}
+
+static void on_upload(const UploadResult *result) {
+    send_event(result->replay ? LOAD_EVENT_REPLAY : LOAD_EVENT_LIVE, result->http_code, result->latency_us);
+}
+
+static void run_device(const upload_load_config_t *config, const char *url, uint32_t duration_ms)
+    __attribute__((noreturn));
+
+static void run_device(const upload_load_config_t *config, const char *url, uint32_t duration_ms) {
+    // 设备的串口日志没有用, 而且 N 台设备会刷屏
+    int devnull = open("/dev/null", O_WRONLY);
+    if (devnull >= 0) {
+        dup2(devnull, STDOUT_FILENO);
+        close(devnull);
+    }
+
+    Serial.begin(115200);
+    CpuLoad_Begin();
+    Preferences preferences;
+    preferences.begin("wifi-creds", false);
+    preferences.putString("ssid", "native-host");
+    preferences.putString("password", "native-host");
+    preferences.end();
+    WiFi.mode(WIFI_STA);
+    Init_Connection();
+    WebService_SetServerUrl(url);
+    WebService_SetUploadObserver(on_upload);
+
+    Wire.begin(0, 1);
+    SHT20_Begin(SHT20_RES_RH12_T14, SHT20_PHASES_SEQUENTIAL);
+    SensorHub_Start(config->interval_ms, SENSOR_HUB_DEFAULT_PRIORITY);
+
+    // 错开各设备的上报时刻, 避免所有请求同时到达
+    delay(config->interval_ms * device_index / config->devices);
+    uint32_t next_send = millis();
+    while ((uint32_t)((NativeHost_TimeUs() - load_origin_us) / 1000) < duration_ms) {
+        if (!SendSensorDataToServer()) {
+            send_event(LOAD_EVENT_DROPPED, 0, 0);
+        }
+        next_send += config->interval_ms;
+        long wait_ms = (long)(next_send - millis());
+        if (wait_ms > 0) {
+            delay((uint32_t)wait_ms);
+        }
+    }
+    NativeHost_Exit(0);
+}
+
+// --- 统计 (父进程) ---
+
+static void collect_events(int fd, int64_t until_us) {
+    for (;;) {
+        int64_t remaining_us = until_us - NativeHost_TimeUs();
+        if (remaining_us <= 0) {
+            return;
+        }
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, (int)((remaining_us + 999) / 1000)) <= 0) {
+            continue;
+        }
+        load_event_t event;
+        ssize_t n = read(fd, &event, sizeof(event));
+        if (n != (ssize_t)sizeof(event)) {
+            if (n == 0) {
+                NativeHost_SleepUs(remaining_us); // 所有设备都已退出
+            }
+            continue;
+        }
+        if (event_count < LOAD_MAX_EVENTS) {
+            events[event_count++] = event;
+        }
+    }
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static double percentile_ms(const uint32_t *sorted_us, int count, int pct) {
+    if (count == 0) {
+        return 0;
+    }
+    int index = (count * pct + 99) / 100 - 1;
+    return sorted_us[index < 0 ? 0 : index] / 1000.0;
+}
+
+static void count_event(load_counts_t *counts, const load_event_t *event) {
+    counts->attempts++;
+    if (event->http_code >= 200 && event->http_code < 300) {
+        counts->ok++;
+    } else {
+        counts->failed++;
+        if (event->http_code == HTTPC_ERROR_READ_TIMEOUT) {
+            counts->timeouts++;
+        }
+    }
+}
+
+static void print_counts(FILE *out, const char *name, const load_counts_t *counts) {
+    fprintf(out, "\"%s\": {\"attempts\": %lu, \"ok\": %lu, \"failed\": %lu, \"timeouts\": %lu}, ",
+        name, (unsigned long)counts->attempts, (unsigned long)counts->ok,
+        (unsigned long)counts->failed, (unsigned long)counts->timeouts);
+}
+
+static void print_phase(FILE *out, int phase, uint32_t phase_ms, uint32_t server_delay_ms,
+                        uint32_t server_requests, bool last) {
+    uint32_t start_ms = phase * phase_ms;
+    uint32_t end_ms = start_ms + phase_ms;
+    load_counts_t live = {};
+    load_counts_t replay = {};
+    uint32_t dropped = 0;
+    int ok_count = 0;
+
+    for (int i = 0; i < event_count; i++) {
+        const load_event_t *event = &events[i];
+        if (event->t_ms < start_ms || (event->t_ms >= end_ms && phase != LOAD_PHASES - 1)) {
+            continue;
+        }
+        if (event->kind == LOAD_EVENT_DROPPED) {
+            dropped++;
+            continue;
+        }
+        count_event(event->kind == LOAD_EVENT_REPLAY ? &replay : &live, event);
+        if (event->http_code >= 200 && event->http_code < 300) {
+            latencies[ok_count++] = event->latency_us;
+        }
+    }
+    qsort(latencies, ok_count, sizeof(latencies[0]), compare_u32);
+
+    fprintf(out, "    {\"name\": \"%s\", \"server_delay_ms\": %lu, ", PHASE_NAMES[phase],
+        (unsigned long)server_delay_ms);
+    print_counts(out, "live", &live);
+    print_counts(out, "replay", &replay);
+    fprintf(out, "\"dropped_windows\": %lu, \"rps\": %.2f, ", (unsigned long)dropped,
+        ok_count * 1000.0 / phase_ms);
+    fprintf(out, "\"latency_ms\": {\"p50\": %.2f, \"p99\": %.2f, \"max\": %.2f}, ",
+        percentile_ms(latencies, ok_count, 50), percentile_ms(latencies, ok_count, 99),
+        percentile_ms(latencies, ok_count, 100));
+    fprintf(out, "\"server_requests\": %lu}%s\n", (unsigned long)server_requests, last ? "" : ",");
+}
+
+int UploadLoad_Run(const upload_load_config_t *config, FILE *out) {
+    char url[64];
+    bool bundled = config->server_url == NULL;
+    if (bundled) {
+        int port = MockIngest_Listen(0);
+        if (port < 0) {
+            Serial.println("Load: cannot start the ingest server");
+            return -1;
+        }
+        snprintf(url, sizeof(url), "http://127.0.0.1:%d/", port);
+    }
+    const char *server_url = bundled ? url : config->server_url;
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    load_origin_us = NativeHost_TimeUs();
+    uint32_t duration_ms = config->phase_ms * LOAD_PHASES;
+    pid_t children[UPLOAD_LOAD_MAX_DEVICES];
+    int started = 0;
+
+    // fork 时进程里只能有这一个线程: 服务器线程等所有设备进程创建完再启动
+    fflush(stdout);
+    for (int i = 0; i < config->devices; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            event_fd = fds[1];
+            device_index = (uint8_t)i;
+            run_device(config, server_url, duration_ms);
+        }
+        if (pid < 0) {
+            Serial.printf("Load: fork failed after %d devices\n", started);
+            break;
+        }
+        children[started++] = pid;
+    }
+    close(fds[1]);
+    if (bundled) {
+        MockIngest_Serve();
+    }
+    Serial.printf("Load: %d devices uploading to %s every %lums, %lus per phase\n", started, server_url,
+        (unsigned long)config->interval_ms, (unsigned long)(config->phase_ms / 1000));
+
+    uint32_t server_delay[LOAD_PHASES];
+    uint32_t server_requests[LOAD_PHASES];
+    for (int phase = 0; phase < LOAD_PHASES; phase++) {
+        server_delay[phase] = bundled && phase == 1 ? config->slow_ms : 0;
+        MockIngest_SetDelay(server_delay[phase]);
+        uint32_t requests_before = MockIngest_Requests();
+        Serial.printf("Load: phase %s, server delay %lums\n", PHASE_NAMES[phase],
+            (unsigned long)server_delay[phase]);
+        collect_events(fds[0], load_origin_us + (int64_t)(phase + 1) * config->phase_ms * 1000);
+        server_requests[phase] = MockIngest_Requests() - requests_before;
+    }
+    // 最后一个阶段结束时还在进行的请求: 最多等一个读超时
+    collect_events(fds[0], NativeHost_TimeUs() + 3000 * 1000);
+
+    for (int i = 0; i < started; i++) {
+        kill(children[i], SIGKILL);
+        waitpid(children[i], NULL, 0);
+    }
+    close(fds[0]);
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"benchmark\": \"upload_load\",\n");
+    fprintf(out, "  \"server\": \"%s\",\n", server_url);
+    fprintf(out, "  \"devices\": %d,\n", started);
+    fprintf(out, "  \"interval_ms\": %lu,\n", (unsigned long)config->interval_ms);
+    fprintf(out, "  \"phase_ms\": %lu,\n", (unsigned long)config->phase_ms);
+    fprintf(out, "  \"events\": %d,\n", event_count);
+    fprintf(out, "  \"phases\": [\n");
+    for (int phase = 0; phase < LOAD_PHASES; phase++) {
+        print_phase(out, phase, config->phase_ms, server_delay[phase], server_requests[phase],
+            phase == LOAD_PHASES - 1);
+    }
+    fprintf(out, "  ]\n}\n");
+    fflush(out);
+    return 0;
+}
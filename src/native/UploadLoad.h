@@ -0,0 +1,38 @@
+#ifndef UPLOAD_LOAD_H
+#define UPLOAD_LOAD_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief 上报路径的压测: fork 出 devices 个进程, 每个进程是一台模拟设备,
+ * 跑板上同一套 SensorHub + WebService 上报任务 (连接复用, 超时, 离线缓存和重发),
+ * 按 interval_ms 调用 SendSensorDataToServer(). 每次上报的结果经 UploadResult
+ * 观察者通过管道交回父进程统计.
+ *
+ * 分三个阶段, 每个 phase_ms: baseline, degraded (内置服务器每个请求延迟 slow_ms),
+ * recovered. 默认的 slow_ms 超过上报任务的读超时, 降级阶段的请求会超时并写入离线缓存,
+ * 恢复阶段可以看到缓存重发. 请求按结束时间归入阶段. 每个阶段输出成功/失败/超时数,
+ * 被丢弃的上报窗口 (上报队列满), 每秒成功请求数和成功请求的 p50/p99/最大延迟.
+ *
+ * server_url 为 NULL 时使用内置的 MockIngestServer; 否则压指定的服务器, 不注入延迟.
+ * 必须在进程还没有创建任何线程 (包括 init 外设, 启动任务) 之前调用.
+ * @return 成功返回 0, 无法启动服务器或创建进程时返回 -1.
+ */
+typedef struct {
+    int devices;
+    uint32_t phase_ms;
+    uint32_t interval_ms;
+    uint32_t slow_ms;
+    const char *server_url;
+} upload_load_config_t;
+
+int UploadLoad_Run(const upload_load_config_t *config, FILE *out);
+
+#define UPLOAD_LOAD_DEFAULT_DEVICES     8
+#define UPLOAD_LOAD_MAX_DEVICES         64
+#define UPLOAD_LOAD_DEFAULT_PHASE_MS    20000
+#define UPLOAD_LOAD_DEFAULT_INTERVAL_MS 1000
+#define UPLOAD_LOAD_DEFAULT_SLOW_MS     4000  // 大于上报任务的读超时 (3s)
+
+#endif // UPLOAD_LOAD_H
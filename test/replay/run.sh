@@ -0,0 +1,81 @@
+#!/bin/sh
+# 按键回放回归: 用 native 程序的 --replay 逐个运行本目录下的 .trace,
+# 检查点哈希与 trace 中的不符, 或者检查点还没有哈希, 都算失败.
+# new_user_ 开头的 trace 以 --new-user 启动 (新用户引导页面).
+# 每个检查点名在同一个 trace 内必须唯一, 检查点行后面不要写注释.
+#
+# 用法 (在仓库根目录):
+#   test/replay/run.sh             编译 native 并检查, 画面不符或回放出错时退出码为 1,
+#                                  只是有 trace 还没有记录哈希时退出码为 3
+#   test/replay/run.sh --update    把当前画面的哈希写回 trace. 画面有意改动后运行,
+#                                  看过报告里的画面延迟再把 trace 一起提交
+# 报告和日志写到 .pio/replay/ (可用 REPLAY_OUT 覆盖).
+
+set -u
+cd "$(dirname "$0")/../.." || exit 2
+
+update=0
+if [ "${1:-}" = "--update" ]; then
+    update=1
+fi
+
+pio run -s -e native || exit 2
+program=.pio/build/native/program
+out=${REPLAY_OUT:-.pio/replay}
+mkdir -p "$out"
+
+status=0
+unrecorded=0
+for trace in test/replay/*.trace; do
+    name=$(basename "$trace" .trace)
+    report="$out/$name.json"
+    flags=
+    case "$name" in
+        new_user_*) flags=--new-user ;;
+    esac
+
+    rm -f "$report"
+    "$program" $flags --replay "$trace" "$report" >"$out/$name.log" 2>&1
+    code=$?
+    if [ $code -ne 0 ] && [ $code -ne 1 ] || [ ! -s "$report" ]; then
+        echo "FAIL $name: replay exited with $code, see $out/$name.log"
+        status=1
+        continue
+    fi
+
+    if [ $update -eq 1 ]; then
+        # 报告里的检查点行: {"name": "<name>", "t_ms": <ms>, "hash": "<hash>"...
+        awk -F'"' '
+            NR == FNR { if ($2 == "name" && $8 == "hash") hash[$4] = $10; next }
+            {
+                sub(/[ \t\r]+$/, "")
+                line = $0
+                sub(/^[ \t]+/, "", line)
+                n = split(line, f, /[ \t]+/)
+                if (f[2] != "check" || !(f[3] in hash)) { print; next }
+                if (n >= 4) sub(/[ \t]+[^ \t]+[ \t]*$/, "")
+                print $0 " " hash[f[3]]
+                next
+            }
+        ' "$report" "$trace" >"$trace.tmp" && mv "$trace.tmp" "$trace"
+        echo "UPDATED $name"
+        continue
+    fi
+
+    missing=$(awk '$2 == "check" && NF < 4 { printf " %s", $3 }' "$trace")
+    if [ -n "$missing" ]; then
+        echo "FAIL $name: no expected hash for$missing (record with --update)"
+        unrecorded=1
+    elif [ $code -ne 0 ]; then
+        echo "FAIL $name: checkpoint mismatch, see $report"
+        grep '"match": false' "$report"
+        status=1
+    else
+        echo "ok   $name"
+    fi
+done
+if [ $status -eq 0 ] && [ $unrecorded -eq 1 ]; then
+    echo "some traces have no recorded hashes: run test/replay/run.sh --update, check the reports, commit the traces"
+    exit 3
+fi
+exit $status
@@ -0,0 +1,128 @@
+#include <unity.h>
+#include "ButtonInput.h"
+#include "Pages.h"
+#include "NativeHost.h"
+
+/**
+ * 按键事件引擎在虚拟时钟上的事件顺序: 引脚由 NativeHost_SetPin() 驱动,
+ * 每毫秒调用一次 ButtonInput_Process(), 记录回调收到的事件 (不含长按进度).
+ */
+
+#define MAX_EVENTS 32
+
+static button_event_type_t events[MAX_EVENTS];
+static int event_count = 0;
+static bool press_open = false;           // 回调已收到 PRESS, 还没收到 RELEASE
+static bool progress_before_press = false;
+
+static void record_cb(const button_event_t *event) {
+    if (event->type == BUTTON_EVENT_LONG_PRESS_PROGRESS) {
+        progress_before_press |= !press_open; // 进度只能出现在这次按压的 PRESS 之后
+        return;
+    }
+    press_open = event->type == BUTTON_EVENT_PRESS ||
+                 (press_open && event->type != BUTTON_EVENT_RELEASE);
+    if (event_count < MAX_EVENTS) {
+        events[event_count++] = event->type;
+    }
+}
+
+static void run_ms(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        NativeHost_AdvanceUs(1000);
+        ButtonInput_Process();
+    }
+}
+
+static void hold(uint32_t ms) {
+    NativeHost_SetPin(BUTTON_PIN, LOW);
+    ButtonInput_Process();
+    run_ms(ms);
+    NativeHost_SetPin(BUTTON_PIN, HIGH);
+    ButtonInput_Process();
+}
+
+static void check_events(const button_event_type_t *expected, int count) {
+    TEST_ASSERT_EQUAL_INT(count, event_count);
+    for (int i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_INT(expected[i], events[i]);
+    }
+    TEST_ASSERT_FALSE(progress_before_press);
+}
+
+void setUp(void) {
+    run_ms(1000); // 与上一个测试的跳变隔开, 等待中的单击也已超时
+    ButtonInput_SetHandler(record_cb, true);
+    event_count = 0;
+    press_open = false;
+    progress_before_press = false;
+}
+
+void tearDown(void) {}
+
+static void test_single_click_waits_for_gap(void) {
+    hold(80);
+    TEST_ASSERT_EQUAL_INT(2, event_count); // 还在等第二次单击
+    run_ms(BUTTON_DOUBLE_CLICK_GAP_MS + 10);
+    const button_event_type_t expected[] = { BUTTON_EVENT_PRESS, BUTTON_EVENT_RELEASE, BUTTON_EVENT_CLICK };
+    check_events(expected, 3);
+}
+
+static void test_double_click(void) {
+    hold(80);
+    run_ms(100);
+    hold(80);
+    run_ms(BUTTON_DOUBLE_CLICK_GAP_MS + 10);
+    const button_event_type_t expected[] = {
+        BUTTON_EVENT_PRESS, BUTTON_EVENT_RELEASE,
+        BUTTON_EVENT_PRESS, BUTTON_EVENT_RELEASE, BUTTON_EVENT_DOUBLE_CLICK,
+    };
+    check_events(expected, 5);
+}
+
+static void test_click_then_slow_press_keeps_order(void) {
+    hold(80);
+    run_ms(100);
+    hold(BUTTON_CLICK_MAX_MS + 100);
+    run_ms(BUTTON_DOUBLE_CLICK_GAP_MS + 10);
+    const button_event_type_t expected[] = {
+        BUTTON_EVENT_PRESS, BUTTON_EVENT_RELEASE, BUTTON_EVENT_CLICK,
+        BUTTON_EVENT_PRESS, BUTTON_EVENT_RELEASE,
+    };
+    check_events(expected, 5);
+}
+
+static void test_click_then_long_press_keeps_order(void) {
+    hold(80);
+    run_ms(100);
+    hold(BUTTON_LONG_PRESS_MS + 100);
+    const button_event_type_t expected[] = {
+        BUTTON_EVENT_PRESS, BUTTON_EVENT_RELEASE, BUTTON_EVENT_CLICK,
+        BUTTON_EVENT_PRESS, BUTTON_EVENT_LONG_PRESS, BUTTON_EVENT_RELEASE,
+    };
+    check_events(expected, 6);
+}
+
+static void test_click_without_double_click_is_immediate(void) {
+    ButtonInput_SetHandler(record_cb, false);
+    hold(80);
+    const button_event_type_t expected[] = { BUTTON_EVENT_PRESS, BUTTON_EVENT_RELEASE, BUTTON_EVENT_CLICK };
+    check_events(expected, 3);
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    NativeHost_UseVirtualClock(1000000, 1700000000000000LL);
+    pinMode(BUTTON_PIN, INPUT_PULLUP);
+    NativeHost_SetPin(BUTTON_PIN, HIGH);
+    ButtonInput_Begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_single_click_waits_for_gap);
+    RUN_TEST(test_double_click);
+    RUN_TEST(test_click_then_slow_press_keeps_order);
+    RUN_TEST(test_click_then_long_press_keeps_order);
+    RUN_TEST(test_click_without_double_click_is_immediate);
+    return UNITY_END();
+}
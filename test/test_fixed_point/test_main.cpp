@@ -0,0 +1,146 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "SHT20.h"
+#include "SensorHub.h"
+
+/**
+ * 遍历 SHT20 全部原始码, 比较仪表盘的整数显示 (数值文字和弧形百分比) 与:
+ * 1. 换算公式精确值的结果 (文字四舍五入到 0.1, 百分比向下取整), 必须处处相同;
+ * 2. 原先的浮点实现, 只允许在 SensorHub.h 中列出的三个原始码上不同.
+ */
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// 原先的浮点实现
+static float float_temp(uint16_t raw) {
+    return -46.85f + 175.72f * (raw & 0xFFFC) / 65536.0f;
+}
+
+static float float_humi(uint16_t raw) {
+    return -6.0f + 125.0f * (raw & 0xFFFC) / 65536.0f;
+}
+
+// 仪表盘的量程, 与 MainUI.cpp 相同
+#define TEMP_MIN 1500
+#define TEMP_MAX 3500
+#define HUMI_MIN 3000
+#define HUMI_MAX 8000
+
+typedef struct {
+    bool humi;
+    uint16_t raw;
+    const char *text;   // 整数实现的显示
+    int percent;
+} display_case_t;
+
+// 浮点显示与精确值不同的原始码 (浮点舍入误差或 printf 的五成双), 以精确值为准
+static const display_case_t FLOAT_DIFFERS[] = {
+    { false, 0x6738, "24.0°C", 44 }, // 23.999995 °C, 浮点为 24.0, 百分比 45
+    { true,  0x4000, "25.3%",  0 },  // 正好 25.25 %RH, printf 显示 "25.2%"
+    { true,  0x8000, "56.5%",  53 }, // 正好 56.5 %RH, 浮点百分比为 52
+};
+
+static int64_t floor_div(int64_t a, int64_t b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// 精确值 = scaled / (100 * 65536), 单位 °C 或 %RH
+static int64_t exact_scaled(bool humi, uint16_t raw) {
+    int64_t code = raw & 0xFFFC;
+    return humi ? 12500 * code - 600LL * 65536 : 17572 * code - 4685LL * 65536;
+}
+
+static void exact_display(bool humi, uint16_t raw, char *text, size_t size, int *percent) {
+    int64_t scaled = exact_scaled(humi, raw);
+    int64_t tenths = floor_div(scaled + 5LL * 65536, 10LL * 65536);
+    int64_t magnitude = tenths < 0 ? -tenths : tenths;
+    snprintf(text, size, "%s%lld.%lld%s", scaled < 0 ? "-" : "", (long long)(magnitude / 10),
+        (long long)(magnitude % 10), humi ? "%" : "°C");
+
+    int64_t min = humi ? HUMI_MIN : TEMP_MIN;
+    int64_t max = humi ? HUMI_MAX : TEMP_MAX;
+    int64_t p = floor_div((scaled - min * 65536) * 100, (max - min) * 65536);
+    *percent = p < 0 ? 0 : (p > 100 ? 100 : (int)p);
+}
+
+static void float_display(bool humi, uint16_t raw, char *text, size_t size, int *percent) {
+    float value = humi ? float_humi(raw) : float_temp(raw);
+    snprintf(text, size, "%.1f%s", value, humi ? "%" : "°C");
+    int p = humi ? (int)((value - 30.0f) / 50.0f * 100) : (int)((value - 15.0f) / 20.0f * 100);
+    *percent = p < 0 ? 0 : (p > 100 ? 100 : p);
+}
+
+static void fixed_display(bool humi, uint16_t raw, char *text, size_t size, int *percent) {
+    int16_t centi = humi ? SHT20_RawToHumiCenti(raw) : SHT20_RawToTempCenti(raw);
+    SensorHub_FormatCenti(text, size, centi, humi ? "%" : "°C");
+    *percent = humi ? SensorHub_ScalePercent(centi, HUMI_MIN, HUMI_MAX)
+                    : SensorHub_ScalePercent(centi, TEMP_MIN, TEMP_MAX);
+}
+
+static const display_case_t *find_known(bool humi, uint16_t raw) {
+    for (size_t i = 0; i < sizeof(FLOAT_DIFFERS) / sizeof(FLOAT_DIFFERS[0]); i++) {
+        if (FLOAT_DIFFERS[i].humi == humi && FLOAT_DIFFERS[i].raw == raw) {
+            return &FLOAT_DIFFERS[i];
+        }
+    }
+    return NULL;
+}
+
+static void sweep(bool humi) {
+    char fixed_text[16], exact_text[16], float_text[16], message[96];
+    int fixed_percent, exact_percent, float_percent;
+    uint32_t known = 0;
+
+    // SHT20 最低两位是状态位, 只需遍历有效码
+    for (uint32_t raw = 0; raw <= 0xFFFF; raw += 4) {
+        fixed_display(humi, (uint16_t)raw, fixed_text, sizeof(fixed_text), &fixed_percent);
+        exact_display(humi, (uint16_t)raw, exact_text, sizeof(exact_text), &exact_percent);
+        float_display(humi, (uint16_t)raw, float_text, sizeof(float_text), &float_percent);
+
+        snprintf(message, sizeof(message), "raw 0x%04lx fixed \"%s\"/%d", (unsigned long)raw, fixed_text,
+            fixed_percent);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(exact_text, fixed_text, message);
+        TEST_ASSERT_EQUAL_MESSAGE(exact_percent, fixed_percent, message);
+
+        const display_case_t *expected = find_known(humi, (uint16_t)raw);
+        if (expected != NULL) {
+            TEST_ASSERT_EQUAL_STRING_MESSAGE(expected->text, fixed_text, message);
+            TEST_ASSERT_EQUAL_MESSAGE(expected->percent, fixed_percent, message);
+            TEST_ASSERT_TRUE_MESSAGE(strcmp(float_text, fixed_text) != 0 || float_percent != fixed_percent,
+                message); // 浮点实现确实在这里不同, 否则应从列表中删除
+            known++;
+        } else {
+            TEST_ASSERT_EQUAL_STRING_MESSAGE(float_text, fixed_text, message);
+            TEST_ASSERT_EQUAL_MESSAGE(float_percent, fixed_percent, message);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(humi ? 2 : 1, known);
+}
+
+static void test_temperature_display_matches(void) {
+    sweep(false);
+}
+
+static void test_humidity_display_matches(void) {
+    sweep(true);
+}
+
+static void test_scale_percent_clamps(void) {
+    TEST_ASSERT_EQUAL_INT(0, SensorHub_ScalePercent(-4000, TEMP_MIN, TEMP_MAX));
+    TEST_ASSERT_EQUAL_INT(0, SensorHub_ScalePercent(1519, TEMP_MIN, TEMP_MAX));
+    TEST_ASSERT_EQUAL_INT(1, SensorHub_ScalePercent(1520, TEMP_MIN, TEMP_MAX));
+    TEST_ASSERT_EQUAL_INT(99, SensorHub_ScalePercent(3499, TEMP_MIN, TEMP_MAX));
+    TEST_ASSERT_EQUAL_INT(100, SensorHub_ScalePercent(12000, TEMP_MIN, TEMP_MAX));
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_temperature_display_matches);
+    RUN_TEST(test_humidity_display_matches);
+    RUN_TEST(test_scale_percent_clamps);
+    return UNITY_END();
+}
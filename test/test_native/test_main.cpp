@@ -0,0 +1,94 @@
+#include <unity.h>
+#include "SensorHub.h"
+#include "TelemetryPayload.h"
+#include "TelemetrySpool.h"
+#include "SpoolPartition.h"
+
+/**
+ * [env:native] 的冒烟测试: 固件模块在宿主替身上能编译, 链接并给出板上的结果.
+ * 编码器和离线缓存的详细测试见 test_payload 和 test_spool.
+ */
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void check_format(int16_t centi, const char *unit, const char *expected) {
+    char buf[16];
+    int len = SensorHub_FormatCenti(buf, sizeof(buf), centi, unit);
+    TEST_ASSERT_EQUAL_STRING(expected, buf);
+    TEST_ASSERT_EQUAL_INT((int)strlen(expected), len);
+}
+
+static void test_format_centi_rounds_to_tenths(void) {
+    check_format(2344, "°C", "23.4°C");
+    check_format(2345, "°C", "23.5°C");
+    check_format(2399, "°C", "24.0°C");
+    check_format(0, "%", "0.0%");
+    check_format(10000, "%", "100.0%");
+}
+
+static void test_format_centi_negative(void) {
+    check_format(-125, "°C", "-1.2°C"); // 恰好在中点时向 +∞ 方向舍入
+    check_format(-126, "°C", "-1.3°C");
+    check_format(-4, "°C", "-0.0°C");   // 与 printf("%.1f", -0.04) 相同
+    check_format(-4000, "°C", "-40.0°C");
+}
+
+static void test_format_centi_invalid(void) {
+    check_format(SENSOR_CENTI_INVALID, "°C", "--°C");
+}
+
+static void test_encode_single_sample(void) {
+    SensorSnapshot sample = { 1, 2000, 2350, 2344, 5512, -125, 123456, 7, -55 };
+    TelemetryBatch batch = {};
+    batch.samples = &sample;
+    batch.count = 1;
+    batch.boot = 3;
+    batch.uptime_ms = 2100;
+
+    char out[TELEMETRY_PAYLOAD_MAX];
+    size_t len = TelemetryPayload_EncodeBatch(&batch, out, sizeof(out));
+    const char *expected =
+        "{\"boot\":3,\"uptime_ms\":2100,\"replay\":false,\"dropped\":0,\"samples\":["
+        "{\"seq\":1,\"ts\":2000,\"lm75_temp\":23.50,\"sht20_temp\":23.44,\"sht20_humi\":55.12,"
+        "\"esp32_temp\":-1.25,\"ram_free\":123456,\"cpu_usage\":7,\"wifi_rssi\":-55}]}";
+    TEST_ASSERT_EQUAL_STRING(expected, out);
+    TEST_ASSERT_EQUAL_UINT32(strlen(expected), len);
+}
+
+// 替身的 "spool" 分区在内存中, 行为与板上的分区相同 (只能把 1 写成 0, 按扇区擦除)
+static void test_spool_on_partition(void) {
+    spool_flash_t flash;
+    TEST_ASSERT_TRUE(SpoolPartition_Open(&flash));
+    TEST_ASSERT_TRUE(TelemetrySpool_Begin(&flash));
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetrySpool_Pending());
+
+    SensorSnapshot sample = { 0, 0, 2350, 2344, 5512, -125, 123456, 7, -55 };
+    for (uint32_t i = 1; i <= 3; i++) {
+        sample.sequence = i;
+        sample.timestamp_ms = i * 2000;
+        TEST_ASSERT_TRUE(TelemetrySpool_Append(&sample, 5));
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, TelemetrySpool_Pending());
+
+    SensorSnapshot out[4];
+    uint16_t boot = 0;
+    TEST_ASSERT_EQUAL_UINT32(3, TelemetrySpool_Peek(out, 4, &boot));
+    TEST_ASSERT_EQUAL_UINT16(5, boot);
+    TEST_ASSERT_EQUAL_UINT32(3, out[2].sequence);
+    TEST_ASSERT_EQUAL_INT16(-125, out[2].esp32_centi);
+    TelemetrySpool_Commit();
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetrySpool_Pending());
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_format_centi_rounds_to_tenths);
+    RUN_TEST(test_format_centi_negative);
+    RUN_TEST(test_format_centi_invalid);
+    RUN_TEST(test_encode_single_sample);
+    RUN_TEST(test_spool_on_partition);
+    return UNITY_END();
+}
@@ -0,0 +1,162 @@
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "TelemetryPayload.h"
+
+/**
+ * TelemetryPayload_EncodeBatch() 的输出就是服务器收到的字节, 这里按字节比较.
+ */
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static char out[TELEMETRY_PAYLOAD_MAX];
+
+static void check_encoded(const TelemetryBatch *batch, const char *expected) {
+    size_t len = TelemetryPayload_EncodeBatch(batch, out, sizeof(out));
+    TEST_ASSERT_EQUAL_STRING(expected, out);
+    TEST_ASSERT_EQUAL_UINT32(strlen(expected), len);
+}
+
+static TelemetryBatch make_batch(const SensorSnapshot *samples, size_t count) {
+    TelemetryBatch batch = {};
+    batch.samples = samples;
+    batch.count = count;
+    batch.boot = 3;
+    batch.uptime_ms = 6100;
+    return batch;
+}
+
+static void test_two_samples_without_epoch(void) {
+    const SensorSnapshot samples[2] = {
+        { 1, 2000, 2350, 2344, 5512, 3125, 123456, 7, -55 },
+        { 2, 4000, 2362, 2351, 5498, 3150, 123000, 12, -61 },
+    };
+    TelemetryBatch batch = make_batch(samples, 2);
+    check_encoded(&batch,
+        "{\"boot\":3,\"uptime_ms\":6100,\"replay\":false,\"dropped\":0,\"samples\":["
+        "{\"seq\":1,\"ts\":2000,\"lm75_temp\":23.50,\"sht20_temp\":23.44,\"sht20_humi\":55.12,"
+        "\"esp32_temp\":31.25,\"ram_free\":123456,\"cpu_usage\":7,\"wifi_rssi\":-55},"
+        "{\"seq\":2,\"ts\":4000,\"lm75_temp\":23.62,\"sht20_temp\":23.51,\"sht20_humi\":54.98,"
+        "\"esp32_temp\":31.50,\"ram_free\":123000,\"cpu_usage\":12,\"wifi_rssi\":-61}]}");
+}
+
+static void test_invalid_values_are_null(void) {
+    const SensorSnapshot sample = {
+        5, 10000, SENSOR_CENTI_INVALID, SENSOR_CENTI_INVALID, SENSOR_CENTI_INVALID, 3000, 90000, 0, 0
+    };
+    TelemetryBatch batch = make_batch(&sample, 1);
+    check_encoded(&batch,
+        "{\"boot\":3,\"uptime_ms\":6100,\"replay\":false,\"dropped\":0,\"samples\":["
+        "{\"seq\":5,\"ts\":10000,\"lm75_temp\":null,\"sht20_temp\":null,\"sht20_humi\":null,"
+        "\"esp32_temp\":30.00,\"ram_free\":90000,\"cpu_usage\":0,\"wifi_rssi\":0}]}");
+}
+
+// 负值的符号单独输出: -0.05 不能变成 "0.-5" 或 "-0.5"
+static void test_negative_centi(void) {
+    const SensorSnapshot sample = { 6, 12000, -5, -125, 0, -1000, 1, 100, -128 };
+    TelemetryBatch batch = make_batch(&sample, 1);
+    check_encoded(&batch,
+        "{\"boot\":3,\"uptime_ms\":6100,\"replay\":false,\"dropped\":0,\"samples\":["
+        "{\"seq\":6,\"ts\":12000,\"lm75_temp\":-0.05,\"sht20_temp\":-1.25,\"sht20_humi\":0.00,"
+        "\"esp32_temp\":-10.00,\"ram_free\":1,\"cpu_usage\":100,\"wifi_rssi\":-128}]}");
+}
+
+static void test_epoch_and_window_reports(void) {
+    const SensorSnapshot sample = { 7, 6000, 2500, 2500, 5000, 3000, 100000, 5, -40 };
+    CpuLoadReport cpu = {};
+    cpu.window_ms = 10000;
+    cpu.average = 9;
+    cpu.peak = 40;
+    cpu.slot_share[CPU_SLOT_LVGL] = 6;
+    cpu.slot_share[CPU_SLOT_SENSORS] = 1;
+    cpu.slot_share[CPU_SLOT_UPLOAD] = 2;
+    PerfReport perf = {};
+    perf.frames = 20;
+    perf.render_avg_us = 1500;
+    perf.render_max_us = 4200;
+    perf.flush_px_per_s = 1200000;
+    for (int i = 0; i < PERF_FLUSH_HIST_BUCKETS; i++) {
+        perf.flush_hist[i] = i;
+    }
+    perf.loop_max_us = 9000;
+
+    TelemetryBatch batch = make_batch(&sample, 1);
+    batch.epoch_ms = 1735689600000ULL;
+    batch.dropped = 2;
+    batch.cpu_report = &cpu;
+    batch.perf_report = &perf;
+    check_encoded(&batch,
+        "{\"boot\":3,\"uptime_ms\":6100,\"epoch_ms\":1735689600000,\"replay\":false,\"dropped\":2,\"samples\":["
+        "{\"seq\":7,\"ts\":6000,\"lm75_temp\":25.00,\"sht20_temp\":25.00,\"sht20_humi\":50.00,"
+        "\"esp32_temp\":30.00,\"ram_free\":100000,\"cpu_usage\":5,\"wifi_rssi\":-40}],"
+        "\"cpu_usage\":9,\"cpu_peak\":40,\"cpu_lvgl\":6,\"cpu_sensors\":1,\"cpu_upload\":2,"
+        "\"frames\":20,\"render_avg_us\":1500,\"render_max_us\":4200,\"flush_px_per_s\":1200000,"
+        "\"flush_hist\":[0,1,2,3,4,5,6,7],\"loop_max_us\":9000}");
+}
+
+static void test_replay_batch(void) {
+    const SensorSnapshot sample = { 9, 500, 2000, 2000, 4000, 2500, 80000, 3, -70 };
+    TelemetryBatch batch = make_batch(&sample, 1);
+    batch.boot = 2;
+    batch.replay = true;
+    check_encoded(&batch,
+        "{\"boot\":2,\"uptime_ms\":6100,\"replay\":true,\"dropped\":0,\"samples\":["
+        "{\"seq\":9,\"ts\":500,\"lm75_temp\":20.00,\"sht20_temp\":20.00,\"sht20_humi\":40.00,"
+        "\"esp32_temp\":25.00,\"ram_free\":80000,\"cpu_usage\":3,\"wifi_rssi\":-70}]}");
+}
+
+// 每个字段都取最长的写法, 满批次必须放得进 TELEMETRY_PAYLOAD_MAX
+static void test_longest_batch_fits(void) {
+    static SensorSnapshot samples[TELEMETRY_BATCH_MAX_SAMPLES];
+    for (int i = 0; i < TELEMETRY_BATCH_MAX_SAMPLES; i++) {
+        SensorSnapshot &s = samples[i];
+        s.sequence = UINT32_MAX;
+        s.timestamp_ms = UINT32_MAX;
+        s.lm75_centi = -INT16_MAX; // "-327.67", INT16_MIN 是无效值
+        s.sht20_temp_centi = -INT16_MAX;
+        s.sht20_humi_centi = -INT16_MAX;
+        s.esp32_centi = -INT16_MAX;
+        s.ram_free = UINT32_MAX;
+        s.cpu_usage = UINT8_MAX;
+        s.wifi_rssi = INT8_MIN;
+    }
+    CpuLoadReport cpu;
+    memset(&cpu, 0xFF, sizeof(cpu));
+    PerfReport perf;
+    memset(&perf, 0xFF, sizeof(perf));
+
+    TelemetryBatch batch;
+    batch.samples = samples;
+    batch.count = TELEMETRY_BATCH_MAX_SAMPLES;
+    batch.boot = UINT16_MAX;
+    batch.replay = false; // "false" 比 "true" 长
+    batch.dropped = UINT32_MAX;
+    batch.uptime_ms = UINT32_MAX;
+    batch.epoch_ms = UINT64_MAX;
+    batch.cpu_report = &cpu;
+    batch.perf_report = &perf;
+
+    size_t len = TelemetryPayload_EncodeBatch(&batch, out, sizeof(out));
+    TEST_ASSERT_TRUE(len > 0);
+    TEST_ASSERT_TRUE(len < TELEMETRY_PAYLOAD_MAX);
+    TEST_ASSERT_EQUAL_UINT32(len, strlen(out));
+
+    // 缓冲区正好缺一个字节 (结尾 '\0') 时应返回 0 且输出空串
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetryPayload_EncodeBatch(&batch, out, len));
+    TEST_ASSERT_EQUAL_STRING("", out);
+    TEST_ASSERT_EQUAL_UINT32(len, TelemetryPayload_EncodeBatch(&batch, out, len + 1));
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_two_samples_without_epoch);
+    RUN_TEST(test_invalid_values_are_null);
+    RUN_TEST(test_negative_centi);
+    RUN_TEST(test_epoch_and_window_reports);
+    RUN_TEST(test_replay_batch);
+    RUN_TEST(test_longest_batch_fits);
+    return UNITY_END();
+}
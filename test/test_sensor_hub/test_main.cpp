@@ -0,0 +1,93 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <Wire.h>
+#include "SHT20.h"
+#include "SensorHub.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/**
+ * 传感器任务发布采样后用任务通知唤醒 loop() 所在的任务, SensorHub_Process()
+ * 把新快照交给页面回调. 在宿主的实时时钟上用较短的采样周期运行约一秒.
+ */
+
+#define TEST_PERIOD_MS 100
+
+static uint32_t callback_count = 0;
+static uint32_t last_sequence = 0;
+static bool sequence_gap = false;
+
+static void record_cb(const SensorSnapshot *snapshot) {
+    if (last_sequence != 0 && snapshot->sequence != last_sequence + 1) {
+        sequence_gap = true;
+    }
+    last_sequence = snapshot->sequence;
+    callback_count++;
+}
+
+void setUp(void) {
+    callback_count = 0;
+    last_sequence = 0;
+    sequence_gap = false;
+}
+
+void tearDown(void) {
+    SensorHub_SetHandler(NULL);
+    ulTaskNotifyTake(pdTRUE, 0);
+}
+
+static void test_one_wake_and_one_callback_per_sample(void) {
+    SensorHub_SetHandler(record_cb);
+    SensorHub_Process(); // 设置后先交出当前快照
+    callback_count = 0;
+
+    uint32_t wakes = 0;
+    uint32_t start = millis();
+    while (millis() - start < 10 * TEST_PERIOD_MS) {
+        uint32_t notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(5 * TEST_PERIOD_MS));
+        TEST_ASSERT_EQUAL_UINT32(1, notified); // 每次采样正好一次通知, 等待没有超时
+        wakes++;
+        uint32_t before = callback_count;
+        SensorHub_Process();
+        TEST_ASSERT_EQUAL_UINT32(before + 1, callback_count);
+        SensorHub_Process(); // 没有新采样时不再回调
+        TEST_ASSERT_EQUAL_UINT32(before + 1, callback_count);
+    }
+    TEST_ASSERT_TRUE(wakes >= 8);
+    TEST_ASSERT_FALSE(sequence_gap);
+}
+
+static void test_no_handler_no_wake(void) {
+    SensorHub_SetHandler(NULL);
+    ulTaskNotifyTake(pdTRUE, 0);
+    TEST_ASSERT_EQUAL_UINT32(0, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(3 * TEST_PERIOD_MS)));
+    SensorHub_Process();
+    TEST_ASSERT_EQUAL_UINT32(0, callback_count);
+}
+
+static void test_set_handler_delivers_current_snapshot(void) {
+    SensorHub_SetHandler(record_cb);
+    SensorHub_Process();
+    TEST_ASSERT_EQUAL_UINT32(1, callback_count);
+    SensorSnapshot latest;
+    TEST_ASSERT_TRUE(SensorHub_Read(&latest));
+    TEST_ASSERT_TRUE(last_sequence <= latest.sequence);
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    Wire.begin(8, 1);
+    SHT20_Begin(SHT20_RES_RH12_T14, SHT20_PHASES_SEQUENTIAL);
+    SensorHub_Start(TEST_PERIOD_MS, SENSOR_HUB_DEFAULT_PRIORITY);
+    SensorSnapshot first;
+    while (!SensorHub_Read(&first)) {
+        delay(10);
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_one_wake_and_one_callback_per_sample);
+    RUN_TEST(test_no_handler_no_wake);
+    RUN_TEST(test_set_handler_delivers_current_snapshot);
+    return UNITY_END();
+}
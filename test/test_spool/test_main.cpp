@@ -0,0 +1,304 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "TelemetrySpool.h"
+
+/**
+ * 用临时文件模拟 flash 分区驱动 TelemetrySpool: 写入只能把位从 1 变成 0,
+ * 擦除按扇区写回 0xFF. 重新调用 TelemetrySpool_Begin() 即为重启后的挂载,
+ * 所有状态都只能从文件内容恢复.
+ *
+ * 掉电用 tear_budget 模拟: 剩余字节数用完后, 当前写入只落下前面一部分,
+ * 之后的写入和擦除全部失败, 直到测试 "重新上电".
+ */
+
+#define TEST_SECTOR_SIZE  256 // 1 个扇区头 + 7 条记录
+#define TEST_SECTOR_COUNT 4
+#define RECORDS_PER_SECTOR (TEST_SECTOR_SIZE / SPOOL_RECORD_SIZE - 1)
+
+typedef struct {
+    FILE *file;
+    long tear_budget;   // < 0 表示不掉电
+    bool powered;
+} file_flash_t;
+
+static file_flash_t backing;
+static spool_flash_t flash;
+
+static bool file_read(void *ctx, uint32_t offset, void *buf, size_t len) {
+    file_flash_t *f = (file_flash_t *)ctx;
+    return fseek(f->file, offset, SEEK_SET) == 0 && fread(buf, 1, len, f->file) == len;
+}
+
+static bool file_write(void *ctx, uint32_t offset, const void *buf, size_t len) {
+    file_flash_t *f = (file_flash_t *)ctx;
+    if (!f->powered) {
+        return false;
+    }
+    size_t n = len;
+    if (f->tear_budget >= 0 && (size_t)f->tear_budget < len) {
+        n = (size_t)f->tear_budget;
+        f->powered = false;
+    }
+    if (f->tear_budget >= 0) {
+        f->tear_budget -= (long)n;
+    }
+    uint8_t cell[TEST_SECTOR_SIZE];
+    if (n > sizeof(cell) || !file_read(ctx, offset, cell, n)) {
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        cell[i] &= ((const uint8_t *)buf)[i]; // NOR flash 只能把 1 写成 0
+    }
+    if (fseek(f->file, offset, SEEK_SET) != 0 || fwrite(cell, 1, n, f->file) != n) {
+        return false;
+    }
+    fflush(f->file);
+    return f->powered;
+}
+
+static bool file_erase(void *ctx, uint32_t offset, size_t len) {
+    file_flash_t *f = (file_flash_t *)ctx;
+    if (!f->powered || offset % TEST_SECTOR_SIZE != 0 || len % TEST_SECTOR_SIZE != 0) {
+        return false;
+    }
+    uint8_t blank[TEST_SECTOR_SIZE];
+    memset(blank, 0xFF, sizeof(blank));
+    for (size_t done = 0; done < len; done += sizeof(blank)) {
+        if (fseek(f->file, offset + done, SEEK_SET) != 0 || fwrite(blank, 1, sizeof(blank), f->file) != sizeof(blank)) {
+            return false;
+        }
+    }
+    fflush(f->file);
+    return true;
+}
+
+// 上电并挂载, 相当于设备重启
+static bool power_on(void) {
+    backing.tear_budget = -1;
+    backing.powered = true;
+    return TelemetrySpool_Begin(&flash);
+}
+
+static SensorSnapshot make_sample(uint32_t seq) {
+    SensorSnapshot sample = {};
+    sample.sequence = seq;
+    sample.timestamp_ms = seq * 2000;
+    sample.lm75_centi = (int16_t)(2000 + seq);
+    sample.sht20_temp_centi = (int16_t)(1990 + seq);
+    sample.sht20_humi_centi = (int16_t)(5000 - seq);
+    sample.esp32_centi = (int16_t)(-100 - (int32_t)seq);
+    sample.ram_free = 100000 + seq;
+    sample.cpu_usage = (uint8_t)(seq % 100);
+    sample.wifi_rssi = (int8_t)(-40 - (int32_t)(seq % 50));
+    return sample;
+}
+
+static void append_range(uint32_t first, uint32_t last, uint16_t boot) {
+    for (uint32_t seq = first; seq <= last; seq++) {
+        SensorSnapshot sample = make_sample(seq);
+        TEST_ASSERT_TRUE(TelemetrySpool_Append(&sample, boot));
+    }
+}
+
+static void check_sample(uint32_t seq, const SensorSnapshot *got) {
+    SensorSnapshot expected = make_sample(seq);
+    TEST_ASSERT_EQUAL_UINT32(expected.sequence, got->sequence);
+    TEST_ASSERT_EQUAL_UINT32(expected.timestamp_ms, got->timestamp_ms);
+    TEST_ASSERT_EQUAL_INT16(expected.lm75_centi, got->lm75_centi);
+    TEST_ASSERT_EQUAL_INT16(expected.sht20_temp_centi, got->sht20_temp_centi);
+    TEST_ASSERT_EQUAL_INT16(expected.sht20_humi_centi, got->sht20_humi_centi);
+    TEST_ASSERT_EQUAL_INT16(expected.esp32_centi, got->esp32_centi);
+    TEST_ASSERT_EQUAL_UINT32(expected.ram_free, got->ram_free);
+    TEST_ASSERT_EQUAL_UINT8(expected.cpu_usage, got->cpu_usage);
+    TEST_ASSERT_EQUAL_INT8(expected.wifi_rssi, got->wifi_rssi);
+}
+
+// 按批读出并确认所有记录, 检查序号依次为 first..last
+static void drain_expect(uint32_t first, uint32_t last) {
+    SensorSnapshot batch[5];
+    uint32_t next = first;
+    uint16_t boot;
+    size_t count;
+    while ((count = TelemetrySpool_Peek(batch, 5, &boot)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            check_sample(next++, &batch[i]);
+        }
+        TelemetrySpool_Commit();
+    }
+    TEST_ASSERT_EQUAL_UINT32(last + 1, next);
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetrySpool_Pending());
+}
+
+void setUp(void) {
+    backing.file = tmpfile();
+    TEST_ASSERT_NOT_NULL(backing.file);
+    uint8_t blank[TEST_SECTOR_SIZE];
+    memset(blank, 0xFF, sizeof(blank));
+    for (int i = 0; i < TEST_SECTOR_COUNT; i++) {
+        fwrite(blank, 1, sizeof(blank), backing.file);
+    }
+    fflush(backing.file);
+
+    flash.read = file_read;
+    flash.write = file_write;
+    flash.erase = file_erase;
+    flash.ctx = &backing;
+    flash.size = TEST_SECTOR_SIZE * TEST_SECTOR_COUNT;
+    flash.sector_size = TEST_SECTOR_SIZE;
+}
+
+void tearDown(void) {
+    fclose(backing.file);
+}
+
+static void test_mount_empty_partition(void) {
+    TEST_ASSERT_TRUE(power_on());
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetrySpool_Pending());
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetrySpool_Overwritten());
+    SensorSnapshot out[1];
+    uint16_t boot;
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetrySpool_Peek(out, 1, &boot));
+
+    // 第二次挂载只读出扇区头, 仍然是空的
+    TEST_ASSERT_TRUE(power_on());
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetrySpool_Pending());
+}
+
+static void test_rejects_bad_geometry(void) {
+    spool_flash_t bad = flash;
+    bad.sector_size = 100; // 不是记录大小的整数倍
+    TEST_ASSERT_FALSE(TelemetrySpool_Begin(&bad));
+    bad = flash;
+    bad.size = TEST_SECTOR_SIZE; // 至少需要两个扇区
+    TEST_ASSERT_FALSE(TelemetrySpool_Begin(&bad));
+}
+
+static void test_peek_stops_at_boot_change(void) {
+    TEST_ASSERT_TRUE(power_on());
+    append_range(1, 3, 7);
+    append_range(4, 5, 8);
+
+    SensorSnapshot out[8];
+    uint16_t boot = 0;
+    TEST_ASSERT_EQUAL_UINT32(3, TelemetrySpool_Peek(out, 8, &boot));
+    TEST_ASSERT_EQUAL_UINT16(7, boot);
+    TelemetrySpool_Commit();
+    TEST_ASSERT_EQUAL_UINT32(2, TelemetrySpool_Peek(out, 8, &boot));
+    TEST_ASSERT_EQUAL_UINT16(8, boot);
+    check_sample(4, &out[0]);
+    TelemetrySpool_Commit();
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetrySpool_Pending());
+}
+
+// 写满所有扇区后覆盖最旧的扇区, 剩下的记录仍按顺序读出
+static void test_wrap_overwrites_oldest_sector(void) {
+    TEST_ASSERT_TRUE(power_on());
+    uint32_t total = RECORDS_PER_SECTOR * TEST_SECTOR_COUNT;
+    append_range(1, total, 1);
+    TEST_ASSERT_EQUAL_UINT32(RECORDS_PER_SECTOR, TelemetrySpool_Overwritten());
+    TEST_ASSERT_EQUAL_UINT32(total - RECORDS_PER_SECTOR, TelemetrySpool_Pending());
+
+    // 再绕一圈多
+    append_range(total + 1, total + 10, 1);
+    TEST_ASSERT_EQUAL_UINT32(2 * RECORDS_PER_SECTOR, TelemetrySpool_Overwritten());
+    drain_expect(2 * RECORDS_PER_SECTOR + 1, total + 10);
+}
+
+// 已确认的记录重启后不会再读出
+static void test_drain_survives_remount(void) {
+    TEST_ASSERT_TRUE(power_on());
+    append_range(1, 10, 1);
+
+    SensorSnapshot out[4];
+    uint16_t boot;
+    TEST_ASSERT_EQUAL_UINT32(4, TelemetrySpool_Peek(out, 4, &boot));
+    TelemetrySpool_Commit();
+    // 读出但未确认 (上报失败) 的记录重启后仍在
+    TEST_ASSERT_EQUAL_UINT32(4, TelemetrySpool_Peek(out, 4, &boot));
+
+    TEST_ASSERT_TRUE(power_on());
+    TEST_ASSERT_EQUAL_UINT32(6, TelemetrySpool_Pending());
+    drain_expect(5, 10);
+
+    TEST_ASSERT_TRUE(power_on());
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetrySpool_Pending());
+    append_range(11, 12, 2);
+    drain_expect(11, 12);
+}
+
+// 追加记录时掉电: 半条记录被跳过, 重启后的新记录不能写在它上面
+static void test_torn_append_is_skipped(void) {
+    TEST_ASSERT_TRUE(power_on());
+    append_range(1, 3, 1);
+
+    backing.tear_budget = 12; // 只落下记录的前 12 字节, 状态字节还没写
+    SensorSnapshot sample = make_sample(4);
+    TEST_ASSERT_FALSE(TelemetrySpool_Append(&sample, 1));
+
+    TEST_ASSERT_TRUE(power_on());
+    append_range(5, 6, 2);
+
+    SensorSnapshot out[8];
+    uint16_t boot;
+    TEST_ASSERT_EQUAL_UINT32(3, TelemetrySpool_Peek(out, 8, &boot));
+    check_sample(1, &out[0]);
+    check_sample(3, &out[2]);
+    TelemetrySpool_Commit();
+    TEST_ASSERT_EQUAL_UINT32(2, TelemetrySpool_Peek(out, 8, &boot));
+    TEST_ASSERT_EQUAL_UINT16(2, boot);
+    check_sample(5, &out[0]);
+    check_sample(6, &out[1]);
+    TelemetrySpool_Commit();
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetrySpool_Pending());
+}
+
+// 内容写完, 状态字节没写上: 同样跳过
+static void test_lost_state_byte_is_skipped(void) {
+    TEST_ASSERT_TRUE(power_on());
+    append_range(1, 2, 1);
+
+    backing.tear_budget = SPOOL_RECORD_SIZE;
+    SensorSnapshot sample = make_sample(3);
+    TEST_ASSERT_FALSE(TelemetrySpool_Append(&sample, 1));
+
+    TEST_ASSERT_TRUE(power_on());
+    append_range(4, 4, 1);
+    SensorSnapshot out[8];
+    uint16_t boot;
+    TEST_ASSERT_EQUAL_UINT32(3, TelemetrySpool_Peek(out, 8, &boot));
+    check_sample(1, &out[0]);
+    check_sample(2, &out[1]);
+    check_sample(4, &out[2]);
+}
+
+// 扇区写满后, 启用下一个扇区 (擦除 + 写扇区头) 之前掉电
+static void test_power_loss_before_next_sector(void) {
+    TEST_ASSERT_TRUE(power_on());
+    append_range(1, RECORDS_PER_SECTOR - 1, 1);
+
+    // 最后一条记录写完 (32 + 1 字节), 扇区头只写了 4 字节
+    backing.tear_budget = SPOOL_RECORD_SIZE + 1 + 4;
+    SensorSnapshot sample = make_sample(RECORDS_PER_SECTOR);
+    TEST_ASSERT_FALSE(TelemetrySpool_Append(&sample, 1));
+
+    TEST_ASSERT_TRUE(power_on());
+    TEST_ASSERT_EQUAL_UINT32(RECORDS_PER_SECTOR, TelemetrySpool_Pending());
+    append_range(RECORDS_PER_SECTOR + 1, RECORDS_PER_SECTOR + 3, 1);
+    drain_expect(1, RECORDS_PER_SECTOR + 3);
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_mount_empty_partition);
+    RUN_TEST(test_rejects_bad_geometry);
+    RUN_TEST(test_peek_stops_at_boot_change);
+    RUN_TEST(test_wrap_overwrites_oldest_sector);
+    RUN_TEST(test_drain_survives_remount);
+    RUN_TEST(test_torn_append_is_skipped);
+    RUN_TEST(test_lost_state_byte_is_skipped);
+    RUN_TEST(test_power_loss_before_next_sector);
+    return UNITY_END();
+}